@@ -0,0 +1,253 @@
+/************************************************************
+ *     Asynchronous sink vs std::ofstream redirection       *
+ ************************************************************/
+
+/*!
+ * @brief cout_redirect{ "file" } (see redirect-or-ignore-cout.cpp) makes
+ *        std::cout write into a std::ofstream : the calling thread does the
+ *        I/O, and several threads need a lock around each line. We log
+ *        LINES lines per thread through std::cout redirected to :
+ *          - a std::ofstream (with a std::mutex around each line when
+ *            several threads are logging)
+ *          - an async_log::async_streambuf : a lock-free ring drained by
+ *            a background thread (see inc/async-streambuf.hpp)
+ *          - the same, each thread writing to an async_log::async_ostream
+ *            of its own instead of std::cout (no forwarding per write)
+ *
+ *        We measure the lines/s seen by the callers, the total time (until
+ *        every byte is in the file) and the latency of one line. Then we
+ *        check that long lines written in pieces are not interleaved, that
+ *        a failing write() sets the badbit, and that a ring size which is
+ *        not a power of 2 is rejected.
+ *
+ * Usage : async-benchmark [lines per thread] [threads]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <time-measure.hpp>
+#include <cout-redirect.hpp>
+#include <async-streambuf.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define LINES   1000000 // Default number of lines per thread
+#define THREADS 4       // Default number of threads for the concurrent case
+#define SAMPLE  16      // One line in SAMPLE is timed
+
+#define OFSTREAM_FILE "ofstream.log"
+#define ASYNC_FILE    "async.log"
+
+using namespace std::chrono;
+
+struct result {
+    double                             caller_ms;   // Until the callers are done
+    double                             total_ms;    // Until the file is complete
+    std::vector<steady_clock::duration> latencies;
+};
+
+/*!
+ * @brief p_threads threads write p_lines lines each to std::cout, with p_lock
+ *        around each line if not null, or to an async_ostream of their own
+ *        on p_log if not null. std::cout is flushed at the end.
+ */
+result logLines( std::size_t p_lines, unsigned p_threads, std::mutex* p_lock,
+                 async_log::async_streambuf* p_log = nullptr )
+{
+    std::vector<std::vector<steady_clock::duration>> l_latencies( p_threads );
+    std::vector<std::thread>                         l_threads;
+
+    const auto l_start = steady_clock::now();
+    for ( unsigned t = 0; t < p_threads; ++t ) {
+        l_threads.emplace_back( [&, t] {
+            auto& l_lat = l_latencies[t];
+            l_lat.reserve( p_lines / SAMPLE + 1 );
+
+            std::optional<async_log::async_ostream> l_own;
+            if ( p_log ) { l_own.emplace( *p_log ); }
+            std::ostream& l_out = l_own ? *l_own : std::cout;
+
+            for ( std::size_t i = 0; i < p_lines; ++i ) {
+                const auto l_begin = i % SAMPLE == 0 ? steady_clock::now() : steady_clock::time_point{};
+                if ( p_lock ) {
+                    std::lock_guard<std::mutex> l_guard( *p_lock );
+                    std::cout << "thread " << t << " line " << i << " value " << i * 0.25 << '\n';
+                } else {
+                    l_out << "thread " << t << " line " << i << " value " << i * 0.25 << '\n';
+                }
+                if ( i % SAMPLE == 0 ) { l_lat.push_back( steady_clock::now() - l_begin ); }
+            }
+        });
+    }
+    for ( auto& l_thread : l_threads ) { l_thread.join(); }
+    const auto l_callers = steady_clock::now();
+    std::cout << std::flush;
+    const auto l_end = steady_clock::now();
+
+    result l_res;
+    l_res.caller_ms = duration<double, std::milli>( l_callers - l_start ).count();
+    l_res.total_ms  = duration<double, std::milli>( l_end - l_start ).count();
+    for ( auto& l_lat : l_latencies ) { l_res.latencies.insert( std::end(l_res.latencies), std::begin(l_lat), std::end(l_lat) ); }
+    std::sort( std::begin(l_res.latencies), std::end(l_res.latencies) );
+    return l_res;
+}
+
+/*!
+ * @brief Number of complete lines of p_fileName written by logLines.
+ */
+std::size_t countLines( const std::string& p_fileName )
+{
+    std::ifstream l_file( p_fileName );
+    std::size_t   l_count = 0;
+    for ( std::string l_line; std::getline( l_file, l_line ); ) {
+        l_count += l_line.rfind( "thread ", 0 ) == 0 && l_line.find( " value " ) != std::string::npos;
+    }
+    return l_count;
+}
+
+/*!
+ * @brief p_threads threads write lines of 3 pieces longer than the thread_local
+ *        buffers, the end of a line and the beginning of the next one in the
+ *        same write : every line of the file must be complete, from one thread.
+ */
+bool checkLongLines( unsigned p_threads )
+{
+    constexpr std::size_t PIECE = 2 * async_log::detail::STAGING_SIZE;
+    constexpr std::size_t NB    = 100;  // Lines per thread
+    {
+        async_log::async_streambuf myLog( ASYNC_FILE );
+        cout_redirect _{ myLog };
+        std::vector<std::thread> l_threads;
+        for ( unsigned t = 0; t < p_threads; ++t ) {
+            l_threads.emplace_back( [t] {
+                const std::string l_piece( PIECE, static_cast<char>( 'a' + t % 26 ) );
+                const std::string l_next = l_piece + "!\n" + l_piece;
+                std::cout << l_piece;
+                for ( std::size_t i = 1; i < NB; ++i ) { std::cout << l_piece << l_next; }
+                std::cout << l_piece << l_piece << "!\n";
+            });
+        }
+        for ( auto& l_thread : l_threads ) { l_thread.join(); }
+        std::cout << std::flush;
+    }
+
+    std::ifstream l_file( ASYNC_FILE );
+    std::size_t   l_count = 0;
+    for ( std::string l_line; std::getline( l_file, l_line ); ++l_count ) {
+        if ( l_line.size() != 3 * PIECE + 1 || l_line.find_first_not_of( l_line[0] ) != 3 * PIECE ) return false;
+    }
+    return l_count == p_threads * NB;
+}
+
+/*!
+ * @brief A failing write() (/dev/full) must set the badbit of std::cout.
+ */
+bool checkWriteFailure()
+{
+    async_log::async_streambuf myLog( "/dev/full" );
+    if ( !myLog.is_open() ) return true; // Not available here
+    cout_redirect _{ myLog };
+    std::cout << "lost line\n" << std::flush;
+    const bool l_bad = std::cout.bad();
+    std::cout.clear();
+    return l_bad;
+}
+
+/*!
+ * @brief A number of slots which is not a power of 2 must be rejected.
+ */
+bool checkRingSize()
+{
+    try {
+        async_log::async_streambuf myLog( ASYNC_FILE, 1000 );
+    } catch ( const std::invalid_argument& ) {
+        return true;
+    }
+    return false;
+}
+
+void print( const char* p_name, std::size_t p_lines, const result& p_res )
+{
+    auto percentile = [&]( double p ) {
+        const auto l_index = static_cast<std::size_t>( p * ( p_res.latencies.size() - 1 ) );
+        return duration_cast<nanoseconds>( p_res.latencies[l_index] ).count();
+    };
+    std::cout << std::setw(22) << p_name
+              << std::setw(12) << static_cast<std::size_t>( p_lines / p_res.caller_ms * 1e3 )
+              << std::setw(11) << static_cast<std::size_t>( p_res.caller_ms )
+              << std::setw(11) << static_cast<std::size_t>( p_res.total_ms )
+              << std::setw(10) << percentile( 0.5 )
+              << std::setw(10) << percentile( 0.99 )
+              << std::setw(12) << percentile( 1.0 ) << "\n";
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_lines   = argc > 1 ? std::stoul( argv[1] ) : LINES;
+    const unsigned    l_threads = argc > 2 ? static_cast<unsigned>( std::stoul( argv[2] ) ) : THREADS;
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nLines   - " << l_lines << " per thread"
+              << "\nThreads - 1 and " << l_threads;
+    std::cout << "\n--------------------------------------------------\n";
+
+    std::cout << "\n" << std::setw(22) << "sink" << std::setw(12) << "lines/s" << std::setw(11) << "callers"
+              << std::setw(11) << "total" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(12) << "max\n"
+              << std::setw(22) << "" << std::setw(12) << "" << std::setw(11) << "(ms)" << std::setw(11) << "(ms)"
+              << std::setw(10) << "(ns)" << std::setw(10) << "(ns)" << std::setw(12) << "(ns)\n";
+
+    for ( const unsigned l_nb : { 1u, l_threads } ) {
+        const std::size_t l_total = l_lines * l_nb;
+        std::cout << "\n" << l_nb << " thread(s)\n";
+
+        std::mutex myLock;
+        result     myOfsRes, myAsyncRes;
+        {
+            cout_redirect _{ OFSTREAM_FILE };
+            myOfsRes = logLines( l_lines, l_nb, l_nb > 1 ? &myLock : nullptr );
+        }
+        print( l_nb > 1 ? "std::ofstream + mutex" : "std::ofstream", l_total, myOfsRes );
+
+        std::size_t myWrites = 0;
+        {
+            async_log::async_streambuf myLog( ASYNC_FILE );
+            cout_redirect _{ myLog };
+            myAsyncRes = logLines( l_lines, l_nb, nullptr );
+            myWrites   = myLog.writes();
+        }
+        print( "async_streambuf", l_total, myAsyncRes );
+        std::cout << std::setw(22) << "" << "  " << myWrites << " write() calls\n";
+        const std::size_t myAsyncLines = countLines( ASYNC_FILE );
+
+        {
+            async_log::async_streambuf myLog( ASYNC_FILE );
+            cout_redirect _{ myLog };
+            myAsyncRes = logLines( l_lines, l_nb, nullptr, &myLog );
+            myWrites   = myLog.writes();
+        }
+        print( "async_ostream", l_total, myAsyncRes );
+        std::cout << std::setw(22) << "" << "  " << myWrites << " write() calls\n";
+
+        if ( countLines( OFSTREAM_FILE ) != l_total || myAsyncLines != l_total || countLines( ASYNC_FILE ) != l_total ) {
+            std::cout << "SOMETHING WENT WRONG!\n";
+        }
+    }
+
+    if ( !checkLongLines( l_threads ) || !checkWriteFailure() || !checkRingSize() ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+
+    std::remove( OFSTREAM_FILE );
+    std::remove( ASYNC_FILE );
+
+    return EXIT_SUCCESS;
+}
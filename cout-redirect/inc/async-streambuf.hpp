@@ -0,0 +1,574 @@
+#ifndef ASYNC_STREAMBUF_HPP
+#define ASYNC_STREAMBUF_HPP
+
+/*!
+ * @brief async_log::async_streambuf
+ *        With cout_redirect{ "file" }, the calling thread formats AND
+ *        writes : the std::filebuf calls write() every few KB, and
+ *        std::cout can not be shared by several threads without a lock.
+ *
+ *        Here the calling thread only formats :
+ *          - the bytes are gathered in a line buffer of the thread : the
+ *            put area of a std::streambuf of its own
+ *          - whole lines are copied into a lock-free multi-producer ring of
+ *            fixed size slots (reserved with one CAS, published with the
+ *            sequence number of each slot)
+ *          - a background thread drains the ring into a big batch and
+ *            writes it with a single write() call
+ *
+ *        std::cout is shared by the threads : the async_streambuf can not
+ *        have a put area, it forwards each write to the line buffer of the
+ *        calling thread, sent at the end of each line. An async_ostream per
+ *        thread writes inline into its line buffer instead, sent when it is
+ *        full, at each flush and at the destruction of the stream.
+ *
+ *        Only whole lines are sent : the lines of several threads do not
+ *        interleave (unless a line is longer than half the ring, then it
+ *        is sent in parts). When the ring is full, the callers wait for the
+ *        writer. std::flush (and std::endl) send the current unfinished
+ *        line too, and wait until the bytes are in the file.
+ *        If write() fails, the bytes are dropped and the stream gets its
+ *        badbit (at the next write or flush).
+ *
+ *            async_log::async_streambuf myLog( "log.txt" );
+ *            cout_redirect _{ myLog };
+ *            ...
+ *            async_log::async_ostream myOut( myLog );  // In a hot thread
+ *
+ * More infos here :
+ *   - https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace async_log {
+
+inline constexpr std::size_t DEFAULT_SLOTS = 1 << 14;  /*!< 2 MB of 128 bytes slots  */
+inline constexpr std::size_t DEFAULT_BATCH = 1 << 20;  /*!< Bytes per write() at most */
+
+namespace detail {
+
+    inline constexpr std::size_t SLOT_SIZE    = 128;
+    inline constexpr std::size_t STAGING_SIZE = 4096;  /*!< Initial capacity of a line buffer */
+
+    struct alignas(SLOT_SIZE) slot {
+        std::atomic<std::uint64_t> seq;   /*!< pos : free for pos, pos + 1 : holds pos */
+        std::uint32_t              size;
+        char                       data[SLOT_SIZE - 16];
+    };
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    /*!
+     * @brief Bounded multi-producer / single-consumer queue of bytes.
+     *        A record takes consecutive slots, reserved all at once : the
+     *        records of a producer are consumed in order, and never mixed
+     *        with the ones of another producer.
+     */
+    class ring
+    {
+    public:
+        static constexpr std::size_t SLOT_DATA = sizeof( slot::data );
+
+        /*!
+         * @throw std::invalid_argument if p_slots is not a power of 2 (at least 2) :
+         *        the positions are masked.
+         */
+        explicit ring( std::size_t p_slots ) :
+            m_mask( checked( p_slots ) - 1 ),
+            m_slots( std::make_unique<slot[]>( p_slots ) )
+        {
+            for ( std::size_t i = 0; i < p_slots; ++i ) { m_slots[i].seq.store( i, std::memory_order_relaxed ); }
+        }
+
+        /*!
+         * @brief Biggest record (half of the ring, so that it is never full forever).
+         */
+        std::size_t max_record() const { return ( m_mask + 1 ) / 2 * SLOT_DATA; }
+
+        /*!
+         * @brief Pushes p_size ( <= max_record() ) bytes, false if the ring is full.
+         */
+        bool try_push( const char* p_data, std::size_t p_size )
+        {
+            const std::uint64_t l_count = std::max<std::size_t>( 1, ( p_size + SLOT_DATA - 1 ) / SLOT_DATA );
+
+            // The slots are freed in order : if the last one is free, they all are
+            std::uint64_t l_pos = m_enqueue.load( std::memory_order_relaxed );
+            for (;;) {
+                const std::uint64_t l_last = l_pos + l_count - 1;
+                const auto l_diff = static_cast<std::int64_t>( m_slots[l_last & m_mask].seq.load( std::memory_order_acquire ) - l_last );
+                if ( l_diff == 0 ) {
+                    if ( m_enqueue.compare_exchange_weak( l_pos, l_pos + l_count, std::memory_order_relaxed ) ) break;
+                } else if ( l_diff < 0 ) {
+                    return false;
+                } else {
+                    l_pos = m_enqueue.load( std::memory_order_relaxed );
+                }
+            }
+
+            for ( std::uint64_t i = 0; i < l_count; ++i ) {
+                slot&             l_slot = m_slots[( l_pos + i ) & m_mask];
+                const std::size_t l_size = std::min( p_size, SLOT_DATA );
+                std::memcpy( l_slot.data, p_data, l_size );
+                l_slot.size = static_cast<std::uint32_t>( l_size );
+                l_slot.seq.store( l_pos + i + 1, std::memory_order_release );
+                p_data += l_size;
+                p_size -= l_size;
+            }
+            return true;
+        }
+
+        /*!
+         * @brief Calls p_func( data, size ) for the published slots, in order,
+         *        and frees them. Returns the number of slots consumed.
+         * @note  Only one thread may consume.
+         */
+        template <typename Func>
+        std::size_t pop( Func&& p_func )
+        {
+            std::size_t l_count = 0;
+            for (;;) {
+                slot& l_slot = m_slots[m_dequeue & m_mask];
+                if ( l_slot.seq.load( std::memory_order_acquire ) != m_dequeue + 1 ) break;
+
+                p_func( l_slot.data, l_slot.size );
+                l_slot.seq.store( m_dequeue + m_mask + 1, std::memory_order_release );
+                ++m_dequeue;
+                ++l_count;
+            }
+            return l_count;
+        }
+
+        std::uint64_t capacity() const { return m_mask + 1; }
+
+        bool readable() const {
+            return m_slots[m_dequeue & m_mask].seq.load( std::memory_order_acquire ) == m_dequeue + 1;
+        }
+
+        std::uint64_t enqueued() const { return m_enqueue.load( std::memory_order_acquire ); }
+        std::uint64_t dequeued() const { return m_dequeue; }
+
+    private:
+        static std::size_t checked( std::size_t p_slots )
+        {
+            if ( p_slots < 2 || ( p_slots & ( p_slots - 1 ) ) != 0 ) {
+                throw std::invalid_argument( "async_log::ring : the number of slots must be a power of 2 (at least 2)" );
+            }
+            return p_slots;
+        }
+
+        const std::uint64_t        m_mask;
+        std::unique_ptr<slot[]>    m_slots;
+        alignas(64) std::atomic<std::uint64_t> m_enqueue { 0 };
+        alignas(64) std::uint64_t              m_dequeue { 0 };  /*!< Consumer only */
+    };
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief std::streambuf appending to a file from a background thread.
+ *        Like a std::ofstream which can not be opened, it fails every
+ *        write (the stream gets its badbit) if p_fileName can not be created.
+ *
+ * @param p_slots Number of slots of the ring (power of 2, at least 2,
+ *                std::invalid_argument is thrown otherwise).
+ * @param p_batch Size of the buffer of the writer thread.
+ */
+class async_streambuf : public std::streambuf
+{
+public:
+    explicit async_streambuf( const std::string& p_fileName,
+                              std::size_t        p_slots = DEFAULT_SLOTS,
+                              std::size_t        p_batch = DEFAULT_BATCH ) :
+        m_ring( p_slots ),  // Checked before the file is created
+        m_fd( ::open( p_fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 ) ),
+        m_batch_size( std::max( p_batch, detail::ring::SLOT_DATA ) )
+    {
+        if ( m_fd < 0 ) return;
+
+        {
+            std::lock_guard<std::mutex> l_lock( registry_mutex() );
+            registry().push_back( this );
+        }
+        m_writer = std::thread( [this] { writer_loop(); } );
+    }
+
+    ~async_streambuf() override
+    {
+        if ( m_fd < 0 ) return;
+
+        // The lines left unfinished by other threads are dropped
+        {
+            std::lock_guard<std::mutex> l_lock( registry_mutex() );
+            auto& l_registry = registry();
+            l_registry.erase( std::find( std::begin(l_registry), std::end(l_registry), this ) );
+        }
+        line_buffer& l_staging = local_staging();
+        if ( l_staging.m_id == m_id ) { publish( l_staging, l_staging.pending() ); }
+
+        {
+            std::lock_guard<std::mutex> l_lock( m_sleep_mutex );
+            m_stop = true;
+        }
+        m_sleep_cv.notify_one();
+        m_writer.join();
+        ::close( m_fd );
+    }
+
+    async_streambuf( const async_streambuf& )            = delete;
+    async_streambuf& operator=( const async_streambuf& ) = delete;
+
+    bool is_open() const { return m_fd >= 0; }
+
+    /*!
+     * @brief Number of write() calls done so far.
+     */
+    std::size_t writes() const { return m_writes.load( std::memory_order_relaxed ); }
+
+protected:
+    std::streamsize xsputn( const char* p_data, std::streamsize p_size ) override
+    {
+        if ( failed() ) return 0;
+
+        const std::size_t l_size    = static_cast<std::size_t>( p_size );
+        line_buffer&      l_staging = owned_staging();
+
+        l_staging.append( p_data, l_size );
+        if ( std::memchr( p_data, '\n', l_size ) ) { publish_lines( l_staging ); }
+        return p_size;
+    }
+
+    int_type overflow( int_type p_char ) override
+    {
+        if ( failed() ) return traits_type::eof();
+        if ( traits_type::eq_int_type( p_char, traits_type::eof() ) ) return traits_type::not_eof( p_char );
+
+        const char   l_char    = traits_type::to_char_type( p_char );
+        line_buffer& l_staging = owned_staging();
+        if ( traits_type::eq_int_type( l_staging.sputc( l_char ), traits_type::eof() ) ) return traits_type::eof();
+        if ( l_char == '\n' ) { publish( l_staging, l_staging.pending() ); }
+        return p_char;
+    }
+
+    /*!
+     * @brief Waits until every byte written so far by this thread is in the
+     *        file. Fails (-1) if a write() has failed.
+     */
+    int sync() override
+    {
+        if ( m_fd < 0 ) return -1;
+        return sync_buffer( owned_staging() );
+    }
+
+private:
+    friend class async_ostream;
+
+    /*!
+     * @brief The bytes of a producer not sent yet, in the put area of a
+     *        std::streambuf of its own : sputc and sputn write inline, only
+     *        overflow() (full buffer) and sync() go to the owner.
+     */
+    class line_buffer : public std::streambuf
+    {
+    public:
+        line_buffer() : m_data( detail::STAGING_SIZE ) { reset( 0 ); }
+
+        std::size_t pending() const { return static_cast<std::size_t>( pptr() - pbase() ); }
+        const char* data   () const { return pbase(); }
+
+        // sputn without the virtual call when it fits
+        void append( const char* p_data, std::size_t p_size )
+        {
+            if ( p_size <= static_cast<std::size_t>( epptr() - pptr() ) ) {
+                std::memcpy( pptr(), p_data, p_size );
+                pbump( static_cast<int>( p_size ) );
+            } else {
+                sputn( p_data, static_cast<std::streamsize>( p_size ) );
+            }
+        }
+
+        // Drops the first p_size pending bytes
+        void consume( std::size_t p_size )
+        {
+            const std::size_t l_rest = pending() - p_size;
+            std::memmove( m_data.data(), m_data.data() + p_size, l_rest );
+            reset( l_rest );
+        }
+
+        void grow()
+        {
+            const std::size_t l_pending = pending();
+            m_data.resize( 2 * m_data.size() );
+            reset( l_pending );
+        }
+
+        std::uint64_t    m_id    { 0 };        /*!< Owner (0 for none) */
+        async_streambuf* m_owner { nullptr };
+
+    protected:
+        int_type overflow( int_type p_char ) override
+        {
+            if ( !m_owner || !m_owner->make_room( *this ) ) return traits_type::eof();
+            if ( traits_type::eq_int_type( p_char, traits_type::eof() ) ) return traits_type::not_eof( p_char );
+            *pptr() = traits_type::to_char_type( p_char );
+            pbump( 1 );
+            return p_char;
+        }
+
+        int sync() override { return m_owner ? m_owner->sync_buffer( *this ) : -1; }
+
+    private:
+        void reset( std::size_t p_pending )
+        {
+            setp( m_data.data(), m_data.data() + m_data.size() );
+            pbump( static_cast<int>( p_pending ) );
+        }
+
+        std::vector<char> m_data;
+    };
+
+    /*!
+     * @brief The line buffer of a thread writing through std::cout. Its
+     *        line is sent at its end, or when the thread writes to another
+     *        async_streambuf, or when the thread exits (if its owner still exists).
+     */
+    struct thread_line_buffer : line_buffer {
+        ~thread_line_buffer() { hand_over( *this ); }
+    };
+
+    static std::mutex& registry_mutex() { static std::mutex s_mutex; return s_mutex; }
+    static std::vector<async_streambuf*>& registry() { static std::vector<async_streambuf*> s_registry; return s_registry; }
+
+    static line_buffer& local_staging() { static thread_local thread_line_buffer s_staging; return s_staging; }
+
+    /*!
+     * @brief Sends the pending bytes of p_staging to their owner, if it still exists.
+     */
+    static void hand_over( line_buffer& p_staging )
+    {
+        if ( p_staging.pending() ) {
+            std::lock_guard<std::mutex> l_lock( registry_mutex() );
+            for ( async_streambuf* l_buf : registry() ) {
+                if ( l_buf == p_staging.m_owner && l_buf->m_id == p_staging.m_id ) { l_buf->publish( p_staging, p_staging.pending() ); }
+            }
+        }
+        p_staging.consume( p_staging.pending() );
+        p_staging.m_id    = 0;
+        p_staging.m_owner = nullptr;
+    }
+
+    line_buffer& owned_staging()
+    {
+        line_buffer& l_staging = local_staging();
+        if ( l_staging.m_id != m_id ) {
+            hand_over( l_staging );
+            l_staging.m_id    = m_id;
+            l_staging.m_owner = this;
+        }
+        return l_staging;
+    }
+
+    // One past the last '\n' of [p_data, p_data + p_size), nullptr if there is none
+    static const char* last_line_end( const char* p_data, std::size_t p_size )
+    {
+        for ( const char* l_it = p_data + p_size; l_it != p_data; --l_it ) {
+            if ( l_it[-1] == '\n' ) return l_it;
+        }
+        return nullptr;
+    }
+
+    /*!
+     * @brief Sends the first p_size bytes of p_buffer, keeps the rest (the
+     *        beginning of the next line). They are cut into records of whole
+     *        lines, unless a line is longer than a record.
+     */
+    void publish( line_buffer& p_buffer, std::size_t p_size )
+    {
+        const char* l_data = p_buffer.data();
+        for ( std::size_t l_left = p_size; l_left; ) {
+            std::size_t l_record = std::min( l_left, m_ring.max_record() );
+            if ( l_record < l_left ) {
+                if ( const char* l_end = last_line_end( l_data, l_record ) ) { l_record = static_cast<std::size_t>( l_end - l_data ); }
+            }
+            push( l_data, l_record );
+            l_data += l_record;
+            l_left -= l_record;
+        }
+        p_buffer.consume( p_size );
+    }
+
+    void publish_lines( line_buffer& p_buffer )
+    {
+        if ( const char* l_end = last_line_end( p_buffer.data(), p_buffer.pending() ) ) {
+            publish( p_buffer, static_cast<std::size_t>( l_end - p_buffer.data() ) );
+        }
+    }
+
+    /*!
+     * @brief overflow() of a full line buffer : sends its complete lines, or
+     *        grows it, or sends a part of a line too long for one record.
+     */
+    bool make_room( line_buffer& p_buffer )
+    {
+        if ( failed() ) return false;
+
+        const std::size_t l_size = p_buffer.pending();
+        if ( last_line_end( p_buffer.data(), l_size ) ) publish_lines( p_buffer );
+        else if ( l_size < m_ring.max_record() )       p_buffer.grow();
+        else                                           publish( p_buffer, m_ring.max_record() );
+        return true;
+    }
+
+    int sync_buffer( line_buffer& p_buffer )
+    {
+        if ( m_fd < 0 ) return -1;
+
+        publish( p_buffer, p_buffer.pending() );
+        const std::uint64_t l_target = m_ring.enqueued();
+        while ( m_written.load( std::memory_order_acquire ) < l_target ) {
+            wake_writer();
+            std::this_thread::yield();
+        }
+        return failed() ? -1 : 0;
+    }
+
+    bool failed() const { return m_fd < 0 || m_failed.load( std::memory_order_relaxed ); }
+
+    // p_size <= m_ring.max_record()
+    void push( const char* p_data, std::size_t p_size )
+    {
+        while ( !m_ring.try_push( p_data, p_size ) ) {
+            wake_writer();
+            std::this_thread::yield();
+        }
+        // The writer wakes up every millisecond by itself : let the lines
+        // pile up for a big write(), unless the ring is filling up.
+        if ( m_sleeping.load( std::memory_order_relaxed ) &&
+             m_ring.enqueued() - m_written.load( std::memory_order_relaxed ) > m_ring.capacity() / 4 ) {
+            wake_writer();
+        }
+    }
+
+    void wake_writer()
+    {
+        std::lock_guard<std::mutex> l_lock( m_sleep_mutex );
+        m_sleep_cv.notify_one();
+    }
+
+    void write_all( const char* p_data, std::size_t p_size )
+    {
+        while ( p_size ) {
+            const ssize_t l_done = ::write( m_fd, p_data, p_size );
+            if ( l_done < 0 ) {
+                if ( errno == EINTR ) continue;
+                m_failed.store( true, std::memory_order_relaxed );  // The bytes are dropped
+                return;
+            }
+            p_data += l_done;
+            p_size -= static_cast<std::size_t>( l_done );
+        }
+        m_writes.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    void writer_loop()
+    {
+        std::vector<char> l_batch;
+        l_batch.reserve( m_batch_size );
+
+        for (;;) {
+            const std::size_t l_count = m_ring.pop( [&]( const char* p_data, std::size_t p_size ) {
+                if ( l_batch.size() + p_size > m_batch_size ) {
+                    write_all( l_batch.data(), l_batch.size() );
+                    l_batch.clear();
+                }
+                l_batch.insert( std::end(l_batch), p_data, p_data + p_size );
+            });
+            if ( !l_batch.empty() ) {
+                write_all( l_batch.data(), l_batch.size() );
+                l_batch.clear();
+            }
+            m_written.store( m_ring.dequeued(), std::memory_order_release );
+            if ( l_count ) continue;
+
+            // Idle : sleep for a millisecond, or until the ring fills up
+            // (or the destructor is called)
+            std::unique_lock<std::mutex> l_lock( m_sleep_mutex );
+            if ( m_stop && !m_ring.readable() && m_ring.enqueued() == m_ring.dequeued() ) break;
+            m_sleeping.store( true, std::memory_order_relaxed );
+            m_sleep_cv.wait_for( l_lock, std::chrono::milliseconds(1), [this] { return m_stop; } );
+            m_sleeping.store( false, std::memory_order_relaxed );
+        }
+    }
+
+    static std::uint64_t next_id() { static std::atomic<std::uint64_t> s_id{0}; return ++s_id; }
+
+    const std::uint64_t        m_id { next_id() };
+    detail::ring               m_ring;
+    const int                  m_fd;
+    const std::size_t          m_batch_size;
+    std::atomic<std::uint64_t> m_written { 0 };  /*!< Slots written to the file */
+    std::atomic<std::size_t>   m_writes  { 0 };
+    std::atomic<bool>          m_failed  { false };  /*!< A write() has failed */
+
+    std::thread                m_writer;
+    std::mutex                 m_sleep_mutex;
+    std::condition_variable    m_sleep_cv;
+    std::atomic<bool>          m_sleeping { false };
+    bool                       m_stop     { false };
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief std::ostream of one thread into an async_streambuf.
+ *        Through std::cout, each write is forwarded to the line buffer of
+ *        the calling thread (a virtual call and a thread_local lookup). An
+ *        async_ostream owns its line buffer : the writes go inline into
+ *        its put area, and its lines are sent when it is full (whole lines),
+ *        at each flush and at its destruction.
+ *        p_log must outlive it, and it must not be shared between threads.
+ *
+ *            // In each thread
+ *            async_log::async_ostream myOut( myLog );
+ *            myOut << "thread " << id << " line " << i << '\n';
+ */
+class async_ostream : public std::ostream
+{
+public:
+    explicit async_ostream( async_streambuf& p_log ) : std::ostream( nullptr )
+    {
+        m_buffer.m_owner = &p_log;
+        rdbuf( &m_buffer );
+        if ( !p_log.is_open() ) { setstate( std::ios::badbit ); }
+    }
+
+    ~async_ostream() override
+    {
+        if ( m_buffer.m_owner->is_open() ) { m_buffer.m_owner->publish( m_buffer, m_buffer.pending() ); }
+    }
+
+private:
+    async_streambuf::line_buffer m_buffer;
+};
+
+} // namespace async_log
+
+#endif // ASYNC_STREAMBUF_HPP
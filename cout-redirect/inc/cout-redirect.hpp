@@ -0,0 +1,64 @@
+#ifndef COUT_REDIRECT_HPP
+#define COUT_REDIRECT_HPP
+
+/*!
+ * @brief cout_redirect
+ *        The RAII redirection of redirect-or-ignore-cout.cpp (which includes
+ *        this header) : std::cout writes into a file (or nowhere, with an
+ *        empty file name) until the end of the scope.
+ *
+ *        It can also redirect std::cout to any std::streambuf (which must
+ *        outlive it), e.g. the sinks of this directory :
+ *
+ *            async_log::async_streambuf myLog( "log.txt" );
+ *            cout_redirect _{ myLog };
+ *
+ *        Or discard the output of std::cout, without formatting it : its
+ *        buffer is removed, so each operator<< stops at the (bad) state
+ *        check. The state is restored at the end of the scope, as well as
+ *        the exceptions mask, emptied meanwhile (badbit must not throw).
+ *
+ *            cout_redirect _{ cout_redirect::discard };
+ */
+
+#include <fstream>
+#include <ios>
+#include <iostream>
+#include <string>
+
+class cout_redirect {
+    public:
+        struct discard_t {};
+        static constexpr discard_t discard {};
+
+        explicit cout_redirect( const std::string& p_fileName = "" ):
+            m_ofs{p_fileName},
+            m_backup{ std::cout.rdbuf( m_ofs.rdbuf() ) }
+        {}
+
+        explicit cout_redirect( std::streambuf& p_buf ):
+            m_backup{ std::cout.rdbuf( &p_buf ) }
+        {}
+
+        explicit cout_redirect( discard_t )
+        {
+            std::cout.exceptions( std::ios::goodbit );
+            m_backup = std::cout.rdbuf( nullptr );
+        }
+
+        ~cout_redirect()
+        {
+            std::cout.rdbuf( m_backup );
+            std::cout.exceptions( m_exceptions );
+        }
+
+        cout_redirect( const cout_redirect& )            = delete;
+        cout_redirect& operator=( const cout_redirect& ) = delete;
+
+    private:
+        std::ofstream     m_ofs;
+        std::streambuf*   m_backup     { nullptr };
+        std::ios::iostate m_exceptions { std::cout.exceptions() };
+};
+
+#endif // COUT_REDIRECT_HPP
@@ -0,0 +1,42 @@
+#ifndef NULL_SINK_HPP
+#define NULL_SINK_HPP
+
+/*!
+ * @brief Ignoring the output of std::cout, from the most to the least work :
+ *          - cout_redirect{ myNull } with a null_streambuf : every write
+ *            succeeds, so every value is formatted, then dropped (the stream
+ *            stays good, for code checking it).
+ *          - cout_redirect{} : std::cout writes into a std::ofstream which
+ *            could not be opened. The first write fails and sets the badbit
+ *            (throwing if std::cout.exceptions() has it), the next ones
+ *            only check the state.
+ *          - cout_redirect{ cout_redirect::discard } : std::cout has no
+ *            buffer, each operator<< only checks the state of the stream.
+ *          - LAZY_COUT : the arguments themselves are not evaluated.
+ *
+ *            cout_redirect _{ cout_redirect::discard };
+ *            LAZY_COUT << "x = " << expensive() << "\n";   // expensive() is not called
+ */
+
+#include <iostream>
+#include <streambuf>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief std::streambuf accepting and dropping everything (like /dev/null).
+ */
+class null_streambuf : public std::streambuf
+{
+protected:
+    std::streamsize xsputn( const char*, std::streamsize p_size ) override { return p_size; }
+    int_type        overflow( int_type p_char ) override { return traits_type::not_eof( p_char ); }
+};
+
+/*!
+ * @brief std::cout, unless it can not be written (e.g. discarded) : then the
+ *        whole statement is skipped. The if/else keeps a following else
+ *        attached to the right if.
+ */
+#define LAZY_COUT if ( !std::cout.good() ) {} else std::cout
+
+#endif // NULL_SINK_HPP
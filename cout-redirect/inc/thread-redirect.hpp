@@ -0,0 +1,135 @@
+#ifndef THREAD_REDIRECT_HPP
+#define THREAD_REDIRECT_HPP
+
+/*!
+ * @brief thread_cout_redirect
+ *        cout_redirect changes the buffer of std::cout for the whole process :
+ *        the output of every thread goes to the file, and a thread leaving
+ *        its scope restores the buffer under the feet of the others.
+ *
+ *        Here std::cout is redirected once to a demux_streambuf, which
+ *        forwards every write to the buffer of the calling thread (a
+ *        thread_local pointer). A thread_cout_redirect sets it for the
+ *        current thread only, e.g. to a file of its own, written without
+ *        any lock :
+ *
+ *            demux_streambuf myDemux;
+ *            cout_redirect   _{ myDemux };
+ *            ...
+ *            // In each worker
+ *            thread_cout_redirect _{ "worker-" + std::to_string( id ) + ".log" };
+ *            std::cout << "Into the file of this worker\n";
+ *
+ *        The threads without a thread_cout_redirect write to the buffer
+ *        std::cout had when the demux_streambuf was created.
+ *
+ * @note The formatting flags of std::cout (precision, width...) are still
+ *       shared : set them before starting the threads.
+ */
+
+#include <fstream>
+#include <ios>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <utility>
+
+#include <null-sink.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief std::streambuf forwarding each write to the buffer of the calling thread.
+ */
+class demux_streambuf : public std::streambuf
+{
+public:
+    /*!
+     * @param p_default Buffer of the threads without a thread_cout_redirect.
+     */
+    explicit demux_streambuf( std::streambuf* p_default = std::cout.rdbuf() ) :
+        m_default( p_default )
+    {}
+
+    /*!
+     * @brief Buffer of the calling thread (nullptr for the default one).
+     */
+    static std::streambuf*& thread_target()
+    {
+        static thread_local std::streambuf* s_target = nullptr;
+        return s_target;
+    }
+
+protected:
+    std::streamsize xsputn( const char* p_data, std::streamsize p_size ) override
+    {
+        std::streambuf* l_target = target();
+        return l_target ? l_target->sputn( p_data, p_size ) : 0;
+    }
+
+    int_type overflow( int_type p_char ) override
+    {
+        std::streambuf* l_target = target();
+        if ( !l_target ) return traits_type::eof();
+        if ( traits_type::eq_int_type( p_char, traits_type::eof() ) ) return traits_type::not_eof( p_char );
+        return l_target->sputc( traits_type::to_char_type( p_char ) );
+    }
+
+    int sync() override
+    {
+        std::streambuf* l_target = target();
+        return l_target ? l_target->pubsync() : -1;
+    }
+
+private:
+    std::streambuf* target() const
+    {
+        std::streambuf* l_target = thread_target();
+        return l_target ? l_target : m_default;
+    }
+
+    std::streambuf* m_default;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief RAII redirection of std::cout for the current thread only, when
+ *        std::cout writes to a demux_streambuf. Can be stacked, like cout_redirect.
+ */
+class thread_cout_redirect {
+    public:
+        static constexpr std::size_t BUFFER_SIZE = 1 << 16;  /*!< Bytes buffered per file */
+
+        /*!
+         * @brief Into a file of this thread. With an empty file name, the
+         *        output is dropped : the writes must not fail, the state
+         *        of std::cout being shared by every thread.
+         */
+        explicit thread_cout_redirect( const std::string& p_fileName = "" ):
+            m_buffer{ std::make_unique<char[]>( BUFFER_SIZE ) }
+        {
+            m_file.pubsetbuf( m_buffer.get(), BUFFER_SIZE );
+            if ( m_file.open( p_fileName, std::ios::out | std::ios::trunc ) ) {
+                m_backup = std::exchange( demux_streambuf::thread_target(), &m_file );
+            } else {
+                m_backup = std::exchange( demux_streambuf::thread_target(), &m_null );
+            }
+        }
+
+        explicit thread_cout_redirect( std::streambuf& p_buf ):
+            m_backup{ std::exchange( demux_streambuf::thread_target(), &p_buf ) }
+        {}
+
+        ~thread_cout_redirect() { demux_streambuf::thread_target() = m_backup; }
+
+        thread_cout_redirect( const thread_cout_redirect& )            = delete;
+        thread_cout_redirect& operator=( const thread_cout_redirect& ) = delete;
+
+    private:
+        std::unique_ptr<char[]> m_buffer;
+        std::filebuf            m_file;
+        null_streambuf          m_null;
+        std::streambuf*         m_backup { nullptr };
+};
+
+#endif // THREAD_REDIRECT_HPP
@@ -0,0 +1,103 @@
+/************************************************************
+ *        The cost of ignored output                        *
+ ************************************************************/
+
+/*!
+ * @brief cout_redirect{} (see redirect-or-ignore-cout.cpp) ignores the
+ *        output of std::cout, but the values written are still computed,
+ *        and maybe formatted. We log LINES lines of numbers (precision 17)
+ *        computed for the log, while ignoring them with (see inc/null-sink.hpp) :
+ *          - cout_redirect{}                          (std::ofstream not opened)
+ *          - cout_redirect{ null_streambuf }          (formatted, then dropped)
+ *          - cout_redirect{ cout_redirect::discard }  (state check only)
+ *          - LAZY_COUT with cout_redirect::discard    (nothing evaluated)
+ *
+ *        std::cout must be usable again after each of them.
+ *
+ * Usage : null-sink-benchmark [lines]
+ */
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <time-measure.hpp>
+#include <cout-redirect.hpp>
+#include <null-sink.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define LINES 2000000 // Default number of lines
+
+/*!
+ * @brief A value only computed to be logged.
+ */
+double logValue( std::size_t p_step )
+{
+    double l_res = 0;
+    for ( int i = 1; i <= 8; ++i ) { l_res += std::sin( static_cast<double>( p_step ) / i ); }
+    return l_res;
+}
+
+void logLines( std::size_t p_lines )
+{
+    for ( std::size_t i = 0; i < p_lines; ++i ) {
+        std::cout << "step " << i << " x " << std::sqrt( static_cast<double>( i ) ) << " y " << logValue(i)
+                  << " z " << i * 1e-3 << '\n';
+    }
+}
+
+void lazyLogLines( std::size_t p_lines )
+{
+    for ( std::size_t i = 0; i < p_lines; ++i ) {
+        LAZY_COUT << "step " << i << " x " << std::sqrt( static_cast<double>( i ) ) << " y " << logValue(i)
+                  << " z " << i * 1e-3 << '\n';
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_lines = argc > 1 ? std::stoul( argv[1] ) : LINES;
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nLines - " << l_lines;
+    std::cout << "\n--------------------------------------------------\n\n";
+
+    std::cout << std::setprecision( 17 );
+    bool myStateOk = true;
+
+    auto bench = [&]( const char* p_name, auto&& p_log ) {
+        const auto l_time = measure<std::chrono::milliseconds>( p_log );
+        myStateOk = myStateOk && std::cout.good();
+        std::cout << std::setw(40) << p_name << std::setw(8) << l_time << " ms\n";
+    };
+
+    bench( "cout_redirect{}", [&] {
+        cout_redirect _{};
+        logLines( l_lines );
+    });
+
+    null_streambuf myNull;
+    bench( "cout_redirect{ null_streambuf }", [&] {
+        cout_redirect _{ myNull };
+        logLines( l_lines );
+    });
+
+    bench( "cout_redirect{ discard }", [&] {
+        cout_redirect _{ cout_redirect::discard };
+        logLines( l_lines );
+    });
+
+    // Even if std::cout throws on errors
+    std::cout.exceptions( std::ios::badbit );
+    bench( "cout_redirect{ discard } + LAZY_COUT", [&] {
+        cout_redirect _{ cout_redirect::discard };
+        lazyLogLines( l_lines );
+    });
+    std::cout.exceptions( std::ios::goodbit );
+
+    if ( !myStateOk ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+/************************************************************
+ *     Per-thread redirection vs a shared std::cout         *
+ ************************************************************/
+
+/*!
+ * @brief cout_redirect (see redirect-or-ignore-cout.cpp) is process-wide :
+ *        threads logging through std::cout share its buffer. N threads
+ *        write LINES lines each, simultaneously, through std::cout with :
+ *          - cout_redirect{ "file" } and a std::mutex around each line
+ *          - an async_log::async_streambuf : one file, lock-free ring
+ *            (see inc/async-streambuf.hpp)
+ *          - a demux_streambuf and a thread_cout_redirect per thread :
+ *            one buffered file per thread, no lock (see inc/thread-redirect.hpp)
+ *
+ *        Every line must be found, complete, in the files.
+ *
+ * Usage : thread-redirect-benchmark [lines per thread] [max threads]
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <time-measure.hpp>
+#include <cout-redirect.hpp>
+#include <async-streambuf.hpp>
+#include <thread-redirect.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define LINES   500000 // Default number of lines per thread
+#define THREADS 8      // Default maximum number of threads
+
+#define SHARED_FILE "shared.log"
+
+std::string workerFile( unsigned p_worker ) { return "worker-" + std::to_string( p_worker ) + ".log"; }
+
+/*!
+ * @brief Runs p_func( worker ) on p_threads threads, returns the time in ms.
+ */
+template <typename Func>
+long long runWorkers( unsigned p_threads, Func&& p_func )
+{
+    return measure<std::chrono::milliseconds>( [&] {
+        std::vector<std::thread> l_threads;
+        for ( unsigned t = 0; t < p_threads; ++t ) { l_threads.emplace_back( p_func, t ); }
+        for ( auto& l_thread : l_threads ) { l_thread.join(); }
+        std::cout << std::flush;
+    });
+}
+
+void logLines( unsigned p_worker, std::size_t p_lines )
+{
+    for ( std::size_t i = 0; i < p_lines; ++i ) {
+        std::cout << "worker " << p_worker << " line " << i << " value " << i * 0.25 << '\n';
+    }
+}
+
+/*!
+ * @brief Number of complete lines of p_fileName written by logLines.
+ */
+std::size_t countLines( const std::string& p_fileName )
+{
+    std::ifstream l_file( p_fileName );
+    std::size_t   l_count = 0;
+    for ( std::string l_line; std::getline( l_file, l_line ); ) {
+        l_count += l_line.rfind( "worker ", 0 ) == 0 && l_line.find( " value " ) != std::string::npos;
+    }
+    return l_count;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_lines   = argc > 1 ? std::stoul( argv[1] ) : LINES;
+    const unsigned    l_threads = argc > 2 ? static_cast<unsigned>( std::stoul( argv[2] ) ) : THREADS;
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nLines       - " << l_lines << " per thread"
+              << "\nMax threads - " << l_threads;
+    std::cout << "\n--------------------------------------------------\n";
+
+    std::cout << "\n" << std::setw(8) << "threads" << std::setw(18) << "ofstream + mutex"
+              << std::setw(18) << "async_streambuf" << std::setw(18) << "per-thread files" << "   (ms)\n";
+
+    bool myOk = true;
+    for ( unsigned l_nb = 1; l_nb <= l_threads; l_nb *= 2 ) {
+        std::mutex myLock;
+        long long  myOfsTime, myAsyncTime, myThreadTime;
+        {
+            cout_redirect _{ SHARED_FILE };
+            myOfsTime = runWorkers( l_nb, [&]( unsigned p_worker ) {
+                for ( std::size_t i = 0; i < l_lines; ++i ) {
+                    std::lock_guard<std::mutex> l_guard( myLock );
+                    std::cout << "worker " << p_worker << " line " << i << " value " << i * 0.25 << '\n';
+                }
+            });
+        }
+        myOk = myOk && countLines( SHARED_FILE ) == l_nb * l_lines;
+        {
+            async_log::async_streambuf myLog( SHARED_FILE );
+            cout_redirect _{ myLog };
+            myAsyncTime = runWorkers( l_nb, [&]( unsigned p_worker ) { logLines( p_worker, l_lines ); } );
+        }
+        myOk = myOk && countLines( SHARED_FILE ) == l_nb * l_lines;
+        {
+            demux_streambuf myDemux;
+            cout_redirect   _{ myDemux };
+            myThreadTime = runWorkers( l_nb, [&]( unsigned p_worker ) {
+                thread_cout_redirect _{ workerFile( p_worker ) };
+                logLines( p_worker, l_lines );
+            });
+        }
+        for ( unsigned t = 0; t < l_nb; ++t ) { myOk = myOk && countLines( workerFile( t ) ) == l_lines; }
+
+        std::cout << std::setw(8) << l_nb << std::setw(18) << myOfsTime << std::setw(18) << myAsyncTime
+                  << std::setw(18) << myThreadTime << "\n";
+    }
+
+    std::remove( SHARED_FILE );
+    for ( unsigned t = 0; t < l_threads; ++t ) { std::remove( workerFile( t ).c_str() ); }
+
+    if ( !myOk ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+
+    return EXIT_SUCCESS;
+}
@@ -18,6 +18,11 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <string>
 
 //  A version using the index of the element to remove
 template< typename T>
@@ -41,6 +46,198 @@ void fast_remove( std::vector<T>& p_vec, typename std::vector<T>::iterator p_it
     }
 }
 
+/*!
+ * Removing many elements with a loop of fast_remove() calls works, as long
+ * as the indices are processed in decreasing order (otherwise a removal
+ * may move an element that is still to be removed, and its index is lost).
+ * But every call moves an element from the back into a random hole,
+ * which scatters memory accesses over the whole vector.
+ *
+ * The batch versions below compact the vector in a single pass, either
+ * preserving the order of the remaining elements or not.
+ */
+enum class removal_order {
+    preserve,  /*!< Remaining elements keep their relative order (O(N)) */
+    unordered  /*!< Holes are filled with elements from the back         */
+};
+
+namespace detail {
+
+    /*!
+     * @brief Removes every element p_vec[i] for which p_removed( i ) is true,
+     *        in a single pass over the vector.
+     */
+    template< typename T, typename IsRemoved >
+    void compact( std::vector<T>& p_vec, IsRemoved p_removed, removal_order p_order )
+    {
+        std::size_t l_first = 0;
+        std::size_t l_last  = p_vec.size();
+
+        if ( p_order == removal_order::preserve )
+        {
+            // Shift the kept elements down, starting at the first hole
+            while ( l_first < l_last && !p_removed( l_first ) ) { ++l_first; }
+            for ( std::size_t l_src = l_first; l_src < l_last; ++l_src )
+            {
+                if ( !p_removed( l_src ) ) { p_vec[l_first++] = std::move( p_vec[l_src] ); }
+            }
+        }
+        else
+        {
+            // Walk from both ends : move a kept element from the back
+            // into each removed element from the front.
+            while ( true )
+            {
+                while ( l_first < l_last && !p_removed( l_first ) ) { ++l_first; }
+                if ( l_first == l_last ) break;
+                do { --l_last; } while ( l_last > l_first && p_removed( l_last ) );
+                if ( l_last == l_first ) break;
+                p_vec[l_first++] = std::move( p_vec[l_last] );
+            }
+        }
+
+        p_vec.erase( std::begin(p_vec) + l_first, std::end(p_vec) );
+    }
+
+} // namespace detail
+
+//  A version removing every element whose index is in p_indices
+//  (in any order, duplicates and out of range indices are ignored)
+template< typename T>
+void fast_remove( std::vector<T>&                 p_vec,
+                  const std::vector<std::size_t>& p_indices,
+                  removal_order                   p_order = removal_order::unordered )
+{
+    // One bit per element : no need to sort the indices
+    std::vector<bool> l_removed( p_vec.size(), false );
+    for ( auto i : p_indices ) { if ( i < p_vec.size() ) l_removed[i] = true; }
+
+    detail::compact( p_vec, [&l_removed]( std::size_t i ) { return l_removed[i]; }, p_order );
+}
+
+//  A version removing every element satisfying p_pred
+template< typename T, typename Pred >
+void fast_remove_if( std::vector<T>& p_vec,
+                     Pred            p_pred,
+                     removal_order   p_order = removal_order::unordered )
+{
+    detail::compact( p_vec, [&p_vec, &p_pred]( std::size_t i ) { return p_pred( p_vec[i] ); }, p_order );
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*
+ * @brief A stopwatch class to perform measures
+ */
+template < typename Clock = std::chrono::high_resolution_clock >
+class stopwatch
+{
+private:
+    const std::string                m_title;
+    const typename Clock::time_point m_start;
+
+public:
+    stopwatch(const std::string& p_title = "") : m_title(p_title), m_start( Clock::now() ) {}
+    ~stopwatch() {
+        std::cout << "\tComputation using " << m_title << " performed in "
+                  << elapsed_time<unsigned int, std::chrono::milliseconds>() << " ms\n";
+    }
+
+    template < typename Rep   = typename Clock::duration::rep,
+               typename Units = typename Clock::duration >
+    Rep elapsed_time(void) const
+    {
+        std::atomic_thread_fence(std::memory_order_relaxed);
+        auto l_time = std::chrono::duration_cast<Units>(Clock::now() - m_start).count();
+        std::atomic_thread_fence(std::memory_order_relaxed);
+
+        return static_cast<Rep>(l_time);
+    }
+};
+
+#define ELEMENTS 10000000 // Size of the vector for the batch removal benchmark
+
+/*!
+ * @brief Removes p_percent % of ELEMENTS elements with every method.
+ *        The elements are their initial index, so that the results
+ *        can be checked.
+ */
+void benchBatchRemoval( int p_percent )
+{
+    std::cout << "Removing " << p_percent << "% of " << ELEMENTS << " elements\n";
+
+    std::vector<int> myRef( ELEMENTS );
+    std::iota( std::begin(myRef), std::end(myRef), 0 );
+
+    std::vector<std::size_t> l_indices( ELEMENTS );
+    std::iota   ( std::begin(l_indices), std::end(l_indices), 0 );
+    std::shuffle( std::begin(l_indices), std::end(l_indices), std::default_random_engine{} );
+    l_indices.resize( static_cast<std::size_t>( ELEMENTS ) * p_percent / 100 );
+
+    std::vector<bool> l_removed( ELEMENTS, false );
+    for ( auto i : l_indices ) { l_removed[i] = true; }
+    auto l_pred = [&l_removed]( int v ) { return l_removed[v]; };
+
+    std::vector<int> myExpected;
+    for ( int v : myRef ) { if ( !l_removed[v] ) myExpected.push_back( v ); }
+
+    auto check = [&]( std::vector<int>& p_res, bool p_ordered ) {
+        if ( !p_ordered ) { std::sort( std::begin(p_res), std::end(p_res) ); }
+        if ( p_res != myExpected ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    };
+
+    {
+        auto myVec  = myRef;
+        auto l_desc = l_indices;
+        {
+            // The indices have to be removed in decreasing order
+            stopwatch myWatch("repeated fast_remove");
+            std::sort( std::begin(l_desc), std::end(l_desc), std::greater<>{} );
+            for ( auto i : l_desc ) { fast_remove( myVec, i ); }
+        }
+        check( myVec, false );
+    }
+    {
+        auto myVec = myRef;
+        {
+            stopwatch myWatch("erase-remove_if");
+            myVec.erase( std::remove_if( std::begin(myVec), std::end(myVec), l_pred ), std::end(myVec) );
+        }
+        check( myVec, true );
+    }
+    {
+        auto myVec = myRef;
+        {
+            stopwatch myWatch("batch fast_remove (unordered)");
+            fast_remove( myVec, l_indices, removal_order::unordered );
+        }
+        check( myVec, false );
+    }
+    {
+        auto myVec = myRef;
+        {
+            stopwatch myWatch("batch fast_remove (preserve)");
+            fast_remove( myVec, l_indices, removal_order::preserve );
+        }
+        check( myVec, true );
+    }
+    {
+        auto myVec = myRef;
+        {
+            stopwatch myWatch("fast_remove_if (unordered)");
+            fast_remove_if( myVec, l_pred, removal_order::unordered );
+        }
+        check( myVec, false );
+    }
+    {
+        auto myVec = myRef;
+        {
+            stopwatch myWatch("fast_remove_if (preserve)");
+            fast_remove_if( myVec, l_pred, removal_order::preserve );
+        }
+        check( myVec, true );
+    }
+}
+
 int main()
 {
     std::vector<int> myVec = { 5, 172, -3, 17, 11, 3985, -112, 6 };
@@ -63,5 +260,15 @@ int main()
     for (auto &&elm : myVec) { std::cout << elm << " "; }
     std::cout << std::endl;
 
+    fast_remove( myVec, { 0, 2, 4 } );
+
+    std::cout << "After removing the elements 0, 2 and 4 at once :";
+    for (auto &&elm : myVec) { std::cout << elm << " "; }
+    std::cout << std::endl;
+
+    // Batch removal benchmark
+    std::cout << "\n";
+    for ( int l_percent : { 1, 10, 50, 90 } ) { benchBatchRemoval( l_percent ); }
+
     return 0;
 }
\ No newline at end of file
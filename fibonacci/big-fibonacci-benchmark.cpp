@@ -0,0 +1,119 @@
+/************************************************************
+ *        Arbitrary precision Fibonacci numbers             *
+ ************************************************************/
+
+/*!
+ * @brief fibonacci_IT (std-compliant-fibonacci.cpp) wraps around after
+ *        F(93). With big_uint (see inc/big-uint.hpp and inc/fibonacci-big.hpp),
+ *        we compute F(n) for n from 1e3 to 1e6 with :
+ *          - additions, allocating a new value at every step
+ *          - fibonacci_big_range : in place additions, no allocation
+ *          - fast doubling with schoolbook multiplications
+ *          - fast doubling with Karatsuba multiplications
+ *
+ * Usage : big-fibonacci-benchmark [max n]
+ */
+
+#include <algorithm>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include <time-measure.hpp>
+#include <fibonacci-table.hpp>
+#include <fibonacci-big.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define MIN_N        1e3 // The smallest computed F(n)
+#define MAX_N        1e6 // The default biggest computed F(n)
+#define MAX_ITERATED 1e5 // The additions (O(n^2)) are not run past that
+
+/*!
+ * @brief F(p_n) with p_n additions, each one creating a new big_uint.
+ */
+big_uint fibonacci_naive( size_t p_n )
+{
+    big_uint l_prev{0}, l_cur{1};
+    for ( size_t i = 1; i < p_n; ++i ) {
+        big_uint l_next = l_prev + l_cur;
+        l_prev = std::move( l_cur );
+        l_cur  = std::move( l_next );
+    }
+    return p_n ? l_cur : l_prev;
+}
+
+/*!
+ * @brief F(p_n) from fibonacci_big_range. Counts in p_reallocs the
+ *        buffers seen, besides the two allocated by begin().
+ */
+big_uint fibonacci_iterated( size_t p_n, size_t& p_reallocs )
+{
+    const fibonacci_big_range            l_range( p_n );
+    auto                                 l_it = std::begin(l_range);
+    std::vector<const big_uint::limb_t*> l_buffers;
+
+    for ( size_t i = 1; i < p_n; ++i ) {
+        ++l_it;
+        const auto* l_data = ( *l_it ).data().data();
+        if ( std::find( std::begin(l_buffers), std::end(l_buffers), l_data ) == std::end(l_buffers) ) {
+            l_buffers.push_back( l_data );
+        }
+    }
+    p_reallocs = l_buffers.size() > 2 ? l_buffers.size() - 2 : 0;
+    return *l_it;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const size_t l_max = argc > 1 ? static_cast<size_t>( std::stod( argv[1] ) )
+                                  : static_cast<size_t>( MAX_N );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nn - " << static_cast<size_t>( MIN_N ) << " to " << l_max;
+    std::cout << "\n--------------------------------------------------\n";
+
+    // Sanity checks against known values
+    if ( fibonacci_big( 93 ) != big_uint( FIBONACCI_TABLE[93] )
+         || fibonacci_big( 100 ).to_string() != "354224848179261915075" ) {
+        std::cout << "SOMETHING WENT WRONG!\n";
+    }
+    std::cout << "\nF(100) = " << fibonacci_big( 100 ).to_string() << "\n";
+
+    std::cout << "\nF(n) (time in us)\n";
+    std::cout << std::setw(10) << "n"
+              << std::setw(10) << "bits"
+              << std::setw(12) << "naive add"
+              << std::setw(12) << "range add"
+              << std::setw(10) << "reallocs"
+              << std::setw(12) << "schoolbook"
+              << std::setw(12) << "karatsuba" << "\n";
+
+    for ( size_t n = MIN_N; n <= l_max; n *= 10 )
+    {
+        big_uint l_ref, l_res;
+
+        const auto l_karatsuba  = measure( [&] { l_ref = fibonacci_big( n ); } );
+        const auto l_schoolbook = measure( [&] {
+            l_res = fibonacci_big( n, big_uint::mul_algo::schoolbook );
+        });
+        if ( l_res != l_ref ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+
+        std::cout << std::setw(10) << n << std::setw(10) << l_ref.bits();
+        if ( n <= MAX_ITERATED ) {
+            size_t l_reallocs{0};
+            std::cout << std::setw(12) << measure( [&] { l_res = fibonacci_naive( n ); } );
+            if ( l_res != l_ref ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+            std::cout << std::setw(12) << measure( [&] { l_res = fibonacci_iterated( n, l_reallocs ); } );
+            if ( l_res != l_ref ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+            std::cout << std::setw(10) << l_reallocs;
+        }
+        else {
+            std::cout << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(10) << "-";
+        }
+        std::cout << std::setw(12) << l_schoolbook << std::setw(12) << l_karatsuba << "\n";
+    }
+
+    return EXIT_SUCCESS;
+}
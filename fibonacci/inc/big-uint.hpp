@@ -0,0 +1,257 @@
+#ifndef BIG_UINT_HPP
+#define BIG_UINT_HPP
+
+/*!
+ * @brief big_uint
+ *        Arbitrary precision unsigned integer : an array of 64 bits limbs,
+ *        least significant first, without leading zero limbs.
+ *
+ *        Only what the Fibonacci numbers need : addition, subtraction (of
+ *        a smaller value), multiplication and decimal conversion.
+ *        The multiplication is either the schoolbook one, O(n^2), or
+ *        Karatsuba's, O(n^1.585) : splitting a and b in two halves,
+ *
+ *            a * b = z2 * B^2m + z1 * B^m + z0,   with z0 = a0 * b0
+ *                                                      z2 = a1 * b1
+ *            z1 = (a0 + a1) * (b0 + b1) - z0 - z2  (3 products instead of 4)
+ *
+ *        The temporary values live in a caller provided scratch buffer :
+ *        repeated multiplications (e.g. the fast doubling steps) do not
+ *        allocate once the buffers have grown.
+ *
+ * More infos here :
+ *   - "The Art of Computer Programming, Vol. 2", D. Knuth, section 4.3.3
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace detail {
+
+    using limb_t = std::uint64_t;
+    using wide_t = unsigned __int128;
+
+    // Below that many limbs, the schoolbook multiplication is faster
+    constexpr std::size_t KARATSUBA_THRESHOLD { 32 };
+
+    /*!
+     * @brief dst[0..p_dn) += src[0..p_sn), with p_sn <= p_dn. Returns the carry out.
+     */
+    inline limb_t add_to( limb_t* p_dst, std::size_t p_dn, const limb_t* p_src, std::size_t p_sn )
+    {
+        limb_t      l_carry = 0;
+        std::size_t i       = 0;
+        for ( ; i < p_sn; ++i ) {
+            const wide_t l_sum = static_cast<wide_t>( p_dst[i] ) + p_src[i] + l_carry;
+            p_dst[i] = static_cast<limb_t>( l_sum );
+            l_carry  = static_cast<limb_t>( l_sum >> 64 );
+        }
+        for ( ; l_carry && i < p_dn; ++i ) { l_carry = ( ++p_dst[i] == 0 ); }
+        return l_carry;
+    }
+
+    /*!
+     * @brief dst[0..p_dn) -= src[0..p_sn), with p_sn <= p_dn. Returns the borrow out.
+     */
+    inline limb_t sub_from( limb_t* p_dst, std::size_t p_dn, const limb_t* p_src, std::size_t p_sn )
+    {
+        limb_t      l_borrow = 0;
+        std::size_t i        = 0;
+        for ( ; i < p_sn; ++i ) {
+            const limb_t l_sub = p_src[i] + l_borrow;
+            const limb_t l_new = p_dst[i] - l_sub;
+            l_borrow = ( l_sub < l_borrow ) | ( l_new > p_dst[i] );
+            p_dst[i] = l_new;
+        }
+        for ( ; l_borrow && i < p_dn; ++i ) { l_borrow = ( p_dst[i]-- == 0 ); }
+        return l_borrow;
+    }
+
+    /*!
+     * @brief out[0..p_an + p_bn) = a * b
+     */
+    inline void schoolbook_mul( const limb_t* p_a, std::size_t p_an,
+                                const limb_t* p_b, std::size_t p_bn,
+                                limb_t*       p_out )
+    {
+        std::fill( p_out, p_out + p_an + p_bn, 0 );
+        for ( std::size_t i = 0; i < p_an; ++i ) {
+            limb_t l_carry = 0;
+            for ( std::size_t j = 0; j < p_bn; ++j ) {
+                const wide_t l_prod = static_cast<wide_t>( p_a[i] ) * p_b[j] + p_out[i + j] + l_carry;
+                p_out[i + j] = static_cast<limb_t>( l_prod );
+                l_carry      = static_cast<limb_t>( l_prod >> 64 );
+            }
+            p_out[i + p_bn] = l_carry;
+        }
+    }
+
+    // Scratch limbs needed by karatsuba_mul for two numbers of p_n limbs
+    constexpr std::size_t karatsuba_scratch( std::size_t p_n ) {
+        return p_n < KARATSUBA_THRESHOLD ? 0 : 4 * ( p_n - p_n / 2 + 1 ) + karatsuba_scratch( p_n - p_n / 2 + 1 );
+    }
+
+    /*!
+     * @brief out[0..2n) = a * b, both of p_n limbs.
+     *        p_scratch holds at least karatsuba_scratch( p_n ) limbs.
+     */
+    inline void karatsuba_mul( const limb_t* p_a, const limb_t* p_b, std::size_t p_n,
+                               limb_t* p_out, limb_t* p_scratch )
+    {
+        if ( p_n < KARATSUBA_THRESHOLD ) { schoolbook_mul( p_a, p_n, p_b, p_n, p_out ); return; }
+
+        const std::size_t l_m = p_n / 2;   // Size of the low halves
+        const std::size_t l_h = p_n - l_m; // Size of the high halves (>= l_m)
+
+        // z0 and z2 go straight to their place in the output
+        karatsuba_mul( p_a,       p_b,       l_m, p_out,           p_scratch );
+        karatsuba_mul( p_a + l_m, p_b + l_m, l_h, p_out + 2 * l_m, p_scratch );
+
+        // z1 = (a0 + a1) * (b0 + b1) - z0 - z2, on l_h + 1 limbs each side
+        limb_t* l_sa   = p_scratch;
+        limb_t* l_sb   = l_sa + ( l_h + 1 );
+        limb_t* l_z1   = l_sb + ( l_h + 1 );
+        limb_t* l_rest = l_z1 + 2 * ( l_h + 1 );
+
+        std::copy( p_a + l_m, p_a + p_n, l_sa ); l_sa[l_h] = 0;
+        std::copy( p_b + l_m, p_b + p_n, l_sb ); l_sb[l_h] = 0;
+        add_to( l_sa, l_h + 1, p_a, l_m );
+        add_to( l_sb, l_h + 1, p_b, l_m );
+
+        karatsuba_mul( l_sa, l_sb, l_h + 1, l_z1, l_rest );
+        sub_from( l_z1, 2 * ( l_h + 1 ), p_out,           2 * l_m );
+        sub_from( l_z1, 2 * ( l_h + 1 ), p_out + 2 * l_m, 2 * l_h );
+
+        // z1 = a0 * b1 + a1 * b0 holds on p_n + 1 limbs : its top limbs are 0
+        std::size_t l_z1n = 2 * ( l_h + 1 );
+        while ( l_z1n && l_z1[l_z1n - 1] == 0 ) { --l_z1n; }
+        add_to( p_out + l_m, 2 * p_n - l_m, l_z1, l_z1n );
+    }
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+class big_uint
+{
+public:
+    using limb_t = detail::limb_t;
+
+    enum class mul_algo { schoolbook, karatsuba };
+
+    big_uint( limb_t p_value = 0 ) { if ( p_value ) { m_limbs.push_back( p_value ); } }
+
+    std::size_t                limbs    () const { return m_limbs.size();  }
+    std::size_t                capacity () const { return m_limbs.capacity(); }
+    void                       reserve  ( std::size_t p_limbs ) { m_limbs.reserve( p_limbs ); }
+    bool                       is_zero  () const { return m_limbs.empty(); }
+    const std::vector<limb_t>& data     () const { return m_limbs; }
+
+    std::size_t bits() const {
+        return m_limbs.empty() ? 0 : 64 * m_limbs.size() - __builtin_clzll( m_limbs.back() );
+    }
+
+    bool operator==( const big_uint& p_other ) const { return m_limbs == p_other.m_limbs; }
+    bool operator!=( const big_uint& p_other ) const { return m_limbs != p_other.m_limbs; }
+
+    /*!
+     * @brief In place addition : only reallocates when the capacity is exceeded.
+     */
+    big_uint& operator+=( const big_uint& p_other )
+    {
+        if ( m_limbs.size() < p_other.m_limbs.size() ) { m_limbs.resize( p_other.m_limbs.size(), 0 ); }
+        if ( detail::add_to( m_limbs.data(), m_limbs.size(), p_other.m_limbs.data(), p_other.m_limbs.size() ) ) {
+            m_limbs.push_back( 1 );
+        }
+        return *this;
+    }
+
+    /*!
+     * @brief In place subtraction : p_other must not be greater than *this.
+     */
+    big_uint& operator-=( const big_uint& p_other )
+    {
+        detail::sub_from( m_limbs.data(), m_limbs.size(), p_other.m_limbs.data(), p_other.m_limbs.size() );
+        trim();
+        return *this;
+    }
+
+    friend big_uint operator+( big_uint p_a, const big_uint& p_b ) { return p_a += p_b; }
+
+    /*!
+     * @brief p_out = p_a * p_b. p_out must not be p_a nor p_b.
+     *        p_scratch is grown if needed and can be reused between calls.
+     */
+    static void multiply( const big_uint& p_a, const big_uint& p_b, big_uint& p_out,
+                          std::vector<limb_t>& p_scratch, mul_algo p_algo = mul_algo::karatsuba )
+    {
+        const std::size_t l_an = p_a.limbs(), l_bn = p_b.limbs();
+        if ( !l_an || !l_bn ) { p_out.m_limbs.clear(); return; }
+
+        const std::size_t l_n = std::max( l_an, l_bn );
+        if ( p_algo == mul_algo::schoolbook || std::min( l_an, l_bn ) < detail::KARATSUBA_THRESHOLD ) {
+            p_out.m_limbs.resize( l_an + l_bn );
+            detail::schoolbook_mul( p_a.m_limbs.data(), l_an, p_b.m_limbs.data(), l_bn, p_out.m_limbs.data() );
+        }
+        else {
+            // Both operands padded to l_n limbs, then the Karatsuba scratch
+            const std::size_t l_needed = 2 * l_n + detail::karatsuba_scratch( l_n );
+            if ( p_scratch.size() < l_needed ) { p_scratch.resize( l_needed ); }
+
+            limb_t* l_a = p_scratch.data();
+            limb_t* l_b = l_a + l_n;
+            std::fill( std::copy( std::begin(p_a.m_limbs), std::end(p_a.m_limbs), l_a ), l_a + l_n, 0 );
+            std::fill( std::copy( std::begin(p_b.m_limbs), std::end(p_b.m_limbs), l_b ), l_b + l_n, 0 );
+
+            p_out.m_limbs.resize( 2 * l_n );
+            detail::karatsuba_mul( l_a, l_b, l_n, p_out.m_limbs.data(), l_b + l_n );
+        }
+        p_out.trim();
+    }
+
+    friend big_uint operator*( const big_uint& p_a, const big_uint& p_b )
+    {
+        big_uint            l_res;
+        std::vector<limb_t> l_scratch;
+        multiply( p_a, p_b, l_res, l_scratch );
+        return l_res;
+    }
+
+    /*!
+     * @brief Decimal representation (O(n^2) : 19 digits per division pass).
+     */
+    std::string to_string() const
+    {
+        if ( m_limbs.empty() ) return "0";
+
+        constexpr limb_t    BASE { 10000000000000000000ull }; // 10^19
+        std::vector<limb_t> l_num( m_limbs );
+        std::vector<limb_t> l_chunks;
+        while ( !l_num.empty() ) {
+            detail::wide_t l_rem = 0;
+            for ( std::size_t i = l_num.size(); i-- > 0; ) {
+                const detail::wide_t l_cur = ( l_rem << 64 ) | l_num[i];
+                l_num[i] = static_cast<limb_t>( l_cur / BASE );
+                l_rem    = l_cur % BASE;
+            }
+            l_chunks.push_back( static_cast<limb_t>( l_rem ) );
+            while ( !l_num.empty() && l_num.back() == 0 ) { l_num.pop_back(); }
+        }
+
+        std::string l_res = std::to_string( l_chunks.back() );
+        for ( std::size_t i = l_chunks.size() - 1; i-- > 0; ) {
+            const std::string l_digits = std::to_string( l_chunks[i] );
+            l_res.append( 19 - l_digits.size(), '0' ).append( l_digits );
+        }
+        return l_res;
+    }
+
+private:
+    void trim() { while ( !m_limbs.empty() && m_limbs.back() == 0 ) { m_limbs.pop_back(); } }
+
+    std::vector<limb_t> m_limbs;
+};
+
+#endif // BIG_UINT_HPP
@@ -0,0 +1,132 @@
+#ifndef FIBONACCI_BIG_HPP
+#define FIBONACCI_BIG_HPP
+
+/*!
+ * @brief Fibonacci numbers past F(93), as big_uint (see big-uint.hpp) :
+ *
+ *        - fibonacci_big( n ) : fast doubling (see fibonacci-random-access.hpp),
+ *          O(log n) steps of 3 multiplications. The numbers have O(n) bits :
+ *          the last multiplications dominate, hence Karatsuba.
+ *
+ *        - fibonacci_big_range : forward iterator over F(1)... F(n), one
+ *          in place addition per step. Its two values swap their buffers at
+ *          every step and are reserved for the biggest value of the range
+ *          up front : iterating does not allocate.
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <big-uint.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Number of limbs needed by F(p_n) : F(n) ~ phi^n / sqrt(5),
+ *        log2(phi) < 0.6943.
+ */
+inline std::size_t fibonacci_big_limbs( std::size_t p_n ) { return static_cast<std::size_t>( p_n * 0.6943 / 64 ) + 2; }
+
+/*!
+ * @brief Returns F(p_n) with the fast doubling formulas. The temporary
+ *        values and the multiplication scratch are reused at every step.
+ */
+inline big_uint fibonacci_big( std::size_t p_n, big_uint::mul_algo p_algo = big_uint::mul_algo::karatsuba )
+{
+    big_uint l_a{0}, l_b{1}; // F(k), F(k+1)
+    big_uint l_c, l_d, l_t;
+    std::vector<big_uint::limb_t> l_scratch;
+
+    std::size_t l_bit = 1;
+    while ( l_bit <= p_n / 2 ) { l_bit <<= 1; }
+
+    for ( ; p_n && l_bit; l_bit >>= 1 ) {
+        l_t = l_b; l_t += l_b; l_t -= l_a;                        // 2 * F(k+1) - F(k)
+        big_uint::multiply( l_a, l_t, l_c, l_scratch, p_algo );   // F(2k)
+        big_uint::multiply( l_a, l_a, l_d, l_scratch, p_algo );
+        big_uint::multiply( l_b, l_b, l_t, l_scratch, p_algo );
+        l_d += l_t;                                               // F(2k+1)
+
+        if ( p_n & l_bit ) { std::swap( l_a, l_d ); std::swap( l_b, l_c ); l_b += l_a; } // k -> 2k+1
+        else               { std::swap( l_a, l_c ); std::swap( l_b, l_d );             } // k -> 2k
+    }
+    return l_a;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief fibonacci_big_IT
+ *        Iterator class that should only
+ *        be used by fibonacci_big_range.
+ *        As fibonacci_IT, the element of index i is F(i+1).
+ */
+class fibonacci_big_IT {
+    public:
+        fibonacci_big_IT()          = default;
+        virtual ~fibonacci_big_IT() = default;
+
+    public:
+        const big_uint& operator*() const { return m_cur; }
+        fibonacci_big_IT& operator++() {
+            std::swap( m_prev, m_cur ); // Swaps the buffers, not the limbs
+            m_cur += m_prev;
+            m_idx++;
+
+            return *this;
+        }
+        bool operator!=(const fibonacci_big_IT& o) const { return m_idx != o.m_idx;     }
+        bool operator==(const fibonacci_big_IT& o) const { return !this->operator!=(o); }
+
+    private:
+        explicit fibonacci_big_IT( size_t p_idx ) : m_idx(p_idx) {}
+
+        void reserve( size_t p_limbs ) {
+            m_prev = big_uint{0};
+            m_cur  = big_uint{1};
+            m_prev.reserve( p_limbs );
+            m_cur .reserve( p_limbs );
+        }
+
+    private:
+        size_t   m_idx {0}; /*!< Index of the current element  */
+        big_uint m_prev{0}; /*!< Previous value ( F(m_idx)   ) */
+        big_uint m_cur {1}; /*!< Current value  ( F(m_idx+1) ) */
+
+    friend class fibonacci_big_range;
+};
+
+namespace std {
+    template<>
+    struct iterator_traits<fibonacci_big_IT> {
+        using iterator_category = forward_iterator_tag;
+        using value_type        = big_uint;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const big_uint*;
+        using reference         = const big_uint&;
+    };
+}
+
+/*!
+ * @brief fibonacci_big_range
+ *        Declares a range in the range [0..p_end]
+ *        and allows to iterate over it.
+ */
+class fibonacci_big_range {
+    public:
+        fibonacci_big_range() = delete;
+        fibonacci_big_range( const size_t& p_end ) : m_end(p_end) {}
+
+        // The iterator gets the capacity of the last value of the range
+        fibonacci_big_IT begin() const {
+            fibonacci_big_IT l_begin{};
+            l_begin.reserve( fibonacci_big_limbs( m_end.m_idx + 1 ) );
+            return l_begin;
+        }
+        fibonacci_big_IT end() const { return m_end; }
+
+    private:
+        fibonacci_big_IT m_end;
+};
+
+#endif // FIBONACCI_BIG_HPP
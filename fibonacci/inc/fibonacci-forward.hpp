@@ -0,0 +1,84 @@
+#ifndef FIBONACCI_FORWARD_HPP
+#define FIBONACCI_FORWARD_HPP
+
+/*!
+ * @brief fibonacci_IT and fibonacci_range of std-compliant-fibonacci.cpp,
+ *        the reference the benchmarks compare the other iterators with.
+ *
+ *        Unlike in std-compliant-fibonacci.cpp, iterator_traits declares
+ *        every member type : the parallel algorithms (std::reduce par) and
+ *        std::distance need difference_type and reference.
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief fibonacci_IT
+ *        Forward iterator class that should only
+ *        be used by fibonacci_range.
+ */
+class fibonacci_IT {
+    public:
+        fibonacci_IT()          = default;
+        virtual ~fibonacci_IT() = default;
+
+    public:
+        size_t operator*() const { return m_cur; }
+        fibonacci_IT& operator++() {
+            std::swap( m_prev, m_cur );
+            m_cur += m_prev;
+            m_idx++;
+
+            return *this;
+        }
+        bool operator!=(const fibonacci_IT& o) const { return m_idx != o.m_idx;     }
+        bool operator==(const fibonacci_IT& o) const { return !this->operator!=(o); }
+
+    private:
+        explicit fibonacci_IT( size_t p_idx ) : m_idx(p_idx) {}
+
+    private:
+        size_t m_idx {0}; /*!< Index of the current element  */
+        size_t m_prev{0}; /*!< Previous value ( F(m_idx-1) ) */
+        size_t m_cur {1}; /*!< Current value  ( F(m_idx)   ) */
+
+    friend class fibonacci_range;
+};
+
+/*!
+ * @brief Enables compliance with std
+ *        algorithms.
+ */
+namespace std {
+    template<>
+    struct iterator_traits<fibonacci_IT> {
+        using iterator_category = forward_iterator_tag;
+        using value_type        = size_t;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const size_t*;
+        using reference         = size_t;
+    };
+}
+
+/*!
+ * @brief fibonacci_range
+ *        Declares a range in the range [0..p_end]
+ *        and allows to iterate over it.
+ */
+class fibonacci_range {
+    public:
+        fibonacci_range() = delete;
+        fibonacci_range( const size_t& p_end ) : m_end(p_end) {}
+
+        fibonacci_IT begin() const { return m_begin; }
+        fibonacci_IT end  () const { return m_end;   }
+
+    private:
+        const fibonacci_IT m_begin{};
+        fibonacci_IT       m_end;
+};
+
+#endif // FIBONACCI_FORWARD_HPP
@@ -0,0 +1,166 @@
+#ifndef FIBONACCI_RANDOM_ACCESS_HPP
+#define FIBONACCI_RANDOM_ACCESS_HPP
+
+/*!
+ * @brief fibonacci_IT of std-compliant-fibonacci.cpp is a forward iterator :
+ *        jumping k elements ahead (std::next, std::distance, the chunks of
+ *        a parallel algorithm...) costs k additions.
+ *
+ *        fibonacci_RA_IT is a random access iterator over the same sequence.
+ *        Jumping k elements costs O(log k) : F(k) is computed with the
+ *        "fast doubling" formulas, then combined with the current values :
+ *
+ *            F(2k)     = F(k) * ( 2 * F(k+1) - F(k) )
+ *            F(2k + 1) = F(k)^2 + F(k+1)^2
+ *
+ *        Values are size_t and wrap around modulo 2^64 past F(93), exactly
+ *        like the additions of fibonacci_IT.
+ *
+ * More infos here :
+ *   - https://www.nayuki.io/page/fast-fibonacci-algorithms
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Returns ( F(n), F(n+1) ) in O(log n) operations.
+ */
+constexpr std::pair<size_t, size_t> fibonacci_pair( size_t p_n )
+{
+    size_t l_a = 0; // F(k)
+    size_t l_b = 1; // F(k+1)
+
+    // Walk the bits of p_n from the most significant one : k -> 2k or 2k+1
+    size_t l_bit = 1;
+    while ( l_bit <= p_n / 2 ) { l_bit <<= 1; }
+
+    for ( ; p_n && l_bit; l_bit >>= 1 ) {
+        const size_t l_even = l_a * ( 2 * l_b - l_a ); // F(2k)
+        const size_t l_odd  = l_a * l_a + l_b * l_b;   // F(2k+1)
+        if ( p_n & l_bit ) { l_a = l_odd;  l_b = l_even + l_odd; }
+        else               { l_a = l_even; l_b = l_odd;          }
+    }
+    return { l_a, l_b };
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief fibonacci_RA_IT
+ *        Random access iterator class that should only
+ *        be used by fibonacci_RA_range.
+ *        As fibonacci_IT, the element of index i is F(i+1).
+ */
+class fibonacci_RA_IT {
+    public:
+        fibonacci_RA_IT()          = default;
+        virtual ~fibonacci_RA_IT() = default;
+
+    public:
+        size_t operator* () const { return m_cur; }
+        size_t operator[]( std::ptrdiff_t p_off ) const { return *( *this + p_off ); }
+
+        // Sequential moves stay O(1)
+        fibonacci_RA_IT& operator++() {
+            std::swap( m_prev, m_cur );
+            m_cur += m_prev;
+            m_idx++;
+
+            return *this;
+        }
+        fibonacci_RA_IT& operator--() {
+            if ( !m_idx ) return *this;
+            const size_t tmp_val { m_prev };
+            m_prev = m_cur - m_prev;
+            m_cur  = tmp_val;
+            m_idx--;
+
+            return *this;
+        }
+        fibonacci_RA_IT operator++(int) { fibonacci_RA_IT tmp{*this}; ++(*this); return tmp; }
+        fibonacci_RA_IT operator--(int) { fibonacci_RA_IT tmp{*this}; --(*this); return tmp; }
+
+        // Jumps are O(log |p_off|). Forward, with the addition formulas :
+        //   F(m+n)   = F(m) * F(n+1) + F(m-1) * F(n)
+        //   F(m+n+1) = F(m+1) * F(n+1) + F(m) * F(n)
+        fibonacci_RA_IT& operator+=( std::ptrdiff_t p_off ) {
+            m_idx += p_off;
+            if ( p_off >= 0 ) {
+                const auto [l_fn, l_fn1] = fibonacci_pair( static_cast<size_t>( p_off ) );
+                const size_t l_prev = m_prev * l_fn1 + ( m_cur - m_prev ) * l_fn;
+                m_cur  = m_cur * l_fn1 + m_prev * l_fn;
+                m_prev = l_prev;
+            }
+            else { std::tie( m_prev, m_cur ) = fibonacci_pair( m_idx ); }
+            return *this;
+        }
+        fibonacci_RA_IT& operator-=( std::ptrdiff_t p_off ) { return *this += -p_off; }
+
+        fibonacci_RA_IT operator+( std::ptrdiff_t p_off ) const { fibonacci_RA_IT tmp{*this}; return tmp += p_off; }
+        fibonacci_RA_IT operator-( std::ptrdiff_t p_off ) const { fibonacci_RA_IT tmp{*this}; return tmp -= p_off; }
+        friend fibonacci_RA_IT operator+( std::ptrdiff_t p_off, const fibonacci_RA_IT& p_it ) { return p_it + p_off; }
+
+        std::ptrdiff_t operator-( const fibonacci_RA_IT& o ) const {
+            return static_cast<std::ptrdiff_t>( m_idx ) - static_cast<std::ptrdiff_t>( o.m_idx );
+        }
+
+        bool operator!=(const fibonacci_RA_IT& o) const { return m_idx != o.m_idx;     }
+        bool operator< (const fibonacci_RA_IT& o) const { return m_idx <  o.m_idx;     }
+        bool operator<=(const fibonacci_RA_IT& o) const { return m_idx <= o.m_idx;     }
+        bool operator==(const fibonacci_RA_IT& o) const { return !this->operator!=(o); }
+        bool operator> (const fibonacci_RA_IT& o) const { return !this->operator<=(o); }
+        bool operator>=(const fibonacci_RA_IT& o) const { return !this->operator< (o); }
+
+    private:
+        explicit fibonacci_RA_IT( size_t p_idx ) : m_idx(p_idx) {
+            std::tie( m_prev, m_cur ) = fibonacci_pair( m_idx );
+        }
+
+    private:
+        size_t m_idx {0}; /*!< Index of the current element  */
+        size_t m_prev{0}; /*!< Previous value ( F(m_idx)   ) */
+        size_t m_cur {1}; /*!< Current value  ( F(m_idx+1) ) */
+
+    friend class fibonacci_RA_range;
+};
+
+/*!
+ * @brief Enables compliance with std
+ *        algorithms.
+ */
+namespace std {
+    template<>
+    struct iterator_traits<fibonacci_RA_IT> {
+        using iterator_category = random_access_iterator_tag;
+        using value_type        = size_t;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const size_t*;
+        using reference         = size_t;
+    };
+}
+
+/*!
+ * @brief fibonacci_RA_range
+ *        Declares a range in the range [0..p_end]
+ *        and allows to iterate over it.
+ */
+class fibonacci_RA_range {
+    public:
+        fibonacci_RA_range() = delete;
+        fibonacci_RA_range( const size_t& p_end ) : m_end(p_end) {}
+
+        fibonacci_RA_IT        begin () const { return m_begin; }
+        fibonacci_RA_IT        end   () const { return m_end;   }
+        const fibonacci_RA_IT& cbegin() const { return m_begin; }
+        const fibonacci_RA_IT& cend  () const { return m_end;   }
+        size_t                 size  () const { return m_end - m_begin; }
+
+    private:
+        const fibonacci_RA_IT m_begin{};
+        fibonacci_RA_IT       m_end;
+};
+
+#endif // FIBONACCI_RANDOM_ACCESS_HPP
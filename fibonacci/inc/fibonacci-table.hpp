@@ -0,0 +1,180 @@
+#ifndef FIBONACCI_TABLE_HPP
+#define FIBONACCI_TABLE_HPP
+
+/*!
+ * @brief Only F(0) to F(93) fit in a size_t (64 bits) : past that,
+ *        fibonacci_IT silently wraps around.
+ *
+ *        FIBONACCI_TABLE holds every representable value, computed at
+ *        compile time : its size is found by stopping at the first
+ *        addition that overflows. fibonacci_table_range then iterates
+ *        over the table instead of recomputing the values, and refuses
+ *        indices that are not representable :
+ *          - fibonacci_table_range( p_end ) and at() throw std::out_of_range.
+ *          - in a constant expression, an out of range index is a
+ *            compilation error.
+ *          - dereferencing fibonacci_table_IT out of the table (e.g. end())
+ *            is asserted, and a compilation error in a constant expression.
+ */
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace detail {
+
+    // Number of Fibonacci numbers F(0), F(1)... representable as a size_t
+    constexpr size_t fibonacci_count()
+    {
+        size_t l_prev = 0, l_cur = 1, l_count = 2;
+        while ( l_cur <= std::numeric_limits<size_t>::max() - l_prev ) {
+            const size_t l_next = l_prev + l_cur;
+            l_prev = l_cur;
+            l_cur  = l_next;
+            ++l_count;
+        }
+        return l_count;
+    }
+
+    template <size_t N>
+    constexpr std::array<size_t, N> make_fibonacci_table()
+    {
+        std::array<size_t, N> l_table{};
+        l_table[1] = 1;
+        for ( size_t i = 2; i < N; ++i ) { l_table[i] = l_table[i - 1] + l_table[i - 2]; }
+        return l_table;
+    }
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief FIBONACCI_TABLE[n] is F(n), for every F(n) that fits in a size_t.
+ */
+inline constexpr auto FIBONACCI_TABLE = detail::make_fibonacci_table<detail::fibonacci_count()>();
+
+static_assert( FIBONACCI_TABLE.size() == 94, "F(93) is the last Fibonacci number of 64 bits" );
+
+/*!
+ * @brief Returns F(p_n), throws std::out_of_range if it does not fit in a size_t.
+ */
+constexpr size_t fibonacci_at( size_t p_n )
+{
+    if ( p_n >= FIBONACCI_TABLE.size() ) {
+        throw std::out_of_range( "F(" + std::to_string( p_n ) + ") does not fit in a size_t" );
+    }
+    return FIBONACCI_TABLE[p_n];
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief fibonacci_table_IT
+ *        Random access iterator class that should only
+ *        be used by fibonacci_table_range.
+ *        As fibonacci_IT, the element of index i is F(i+1).
+ */
+class fibonacci_table_IT {
+    public:
+        constexpr fibonacci_table_IT() = default;
+
+    public:
+        constexpr size_t operator* () const { return value( 0 ); }
+        constexpr size_t operator[]( std::ptrdiff_t p_off ) const { return value( p_off ); }
+
+        constexpr fibonacci_table_IT& operator++() { m_idx++; return *this; }
+        constexpr fibonacci_table_IT& operator--() { m_idx--; return *this; }
+        constexpr fibonacci_table_IT  operator++(int) { fibonacci_table_IT tmp{*this}; ++m_idx; return tmp; }
+        constexpr fibonacci_table_IT  operator--(int) { fibonacci_table_IT tmp{*this}; --m_idx; return tmp; }
+
+        constexpr fibonacci_table_IT& operator+=( std::ptrdiff_t p_off ) { m_idx += p_off; return *this; }
+        constexpr fibonacci_table_IT& operator-=( std::ptrdiff_t p_off ) { m_idx -= p_off; return *this; }
+
+        constexpr fibonacci_table_IT operator+( std::ptrdiff_t p_off ) const { fibonacci_table_IT tmp{*this}; return tmp += p_off; }
+        constexpr fibonacci_table_IT operator-( std::ptrdiff_t p_off ) const { fibonacci_table_IT tmp{*this}; return tmp -= p_off; }
+        friend constexpr fibonacci_table_IT operator+( std::ptrdiff_t p_off, const fibonacci_table_IT& p_it ) { return p_it + p_off; }
+
+        constexpr std::ptrdiff_t operator-( const fibonacci_table_IT& o ) const {
+            return static_cast<std::ptrdiff_t>( m_idx ) - static_cast<std::ptrdiff_t>( o.m_idx );
+        }
+
+        constexpr bool operator!=(const fibonacci_table_IT& o) const { return m_idx != o.m_idx;     }
+        constexpr bool operator< (const fibonacci_table_IT& o) const { return m_idx <  o.m_idx;     }
+        constexpr bool operator<=(const fibonacci_table_IT& o) const { return m_idx <= o.m_idx;     }
+        constexpr bool operator==(const fibonacci_table_IT& o) const { return !this->operator!=(o); }
+        constexpr bool operator> (const fibonacci_table_IT& o) const { return !this->operator<=(o); }
+        constexpr bool operator>=(const fibonacci_table_IT& o) const { return !this->operator< (o); }
+
+    private:
+        constexpr explicit fibonacci_table_IT( size_t p_idx ) : m_idx(p_idx) {}
+
+        // Past the table (e.g. *end()) : the assert fails, which is not a constant expression
+        constexpr size_t value( std::ptrdiff_t p_off ) const {
+            assert( m_idx + p_off + 1 < FIBONACCI_TABLE.size() && "fibonacci_table_IT : out of the table" );
+            return FIBONACCI_TABLE[m_idx + p_off + 1];
+        }
+
+    private:
+        size_t m_idx {0}; /*!< Index of the current element */
+
+    friend class fibonacci_table_range;
+};
+
+/*!
+ * @brief Enables compliance with std
+ *        algorithms.
+ */
+namespace std {
+    template<>
+    struct iterator_traits<fibonacci_table_IT> {
+        using iterator_category = random_access_iterator_tag;
+        using value_type        = size_t;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const size_t*;
+        using reference         = size_t;
+    };
+}
+
+/*!
+ * @brief fibonacci_table_range
+ *        Declares a range in the range [0..p_end]
+ *        and allows to iterate over it.
+ *        p_end cannot be greater than max_size() : F(p_end) would overflow.
+ */
+class fibonacci_table_range {
+    public:
+        fibonacci_table_range() = delete;
+        constexpr fibonacci_table_range( const size_t& p_end ) : m_end( checked( p_end ) ) {}
+
+        constexpr fibonacci_table_IT        begin () const { return m_begin; }
+        constexpr fibonacci_table_IT        end   () const { return m_end;   }
+        constexpr const fibonacci_table_IT& cbegin() const { return m_begin; }
+        constexpr const fibonacci_table_IT& cend  () const { return m_end;   }
+        constexpr size_t                    size  () const { return m_end - m_begin; }
+
+        constexpr size_t operator[]( size_t p_idx ) const { return m_begin[p_idx]; }
+        constexpr size_t at( size_t p_idx ) const {
+            if ( p_idx >= size() ) { throw std::out_of_range( "fibonacci_table_range::at" ); }
+            return m_begin[p_idx];
+        }
+
+        static constexpr size_t max_size() { return FIBONACCI_TABLE.size() - 1; }
+
+    private:
+        static constexpr size_t checked( size_t p_end ) {
+            if ( p_end > max_size() ) {
+                throw std::out_of_range( "fibonacci_table_range : F(" + std::to_string( p_end ) +
+                                         ") does not fit in a size_t" );
+            }
+            return p_end;
+        }
+
+    private:
+        const fibonacci_table_IT m_begin{};
+        fibonacci_table_IT       m_end;
+};
+
+#endif // FIBONACCI_TABLE_HPP
@@ -0,0 +1,154 @@
+/************************************************************
+ *    Forward vs random access Fibonacci iterators          *
+ ************************************************************/
+
+/*!
+ * @brief fibonacci_IT (std-compliant-fibonacci.cpp, see inc/fibonacci-forward.hpp)
+ *        is a forward iterator : std::next( begin, k ) does k steps, and
+ *        the parallel algorithms cannot split the range cheaply.
+ *        fibonacci_RA_IT (see inc/fibonacci-random-access.hpp) jumps in O(log k).
+ *
+ *        We compare both for :
+ *          - computing F(k) for scattered k (std::next / begin + k)
+ *          - std::distance over the whole range
+ *          - summing the range (modulo 2^64) with std::reduce seq / par,
+ *            and pstl_lite::parallel_reduce
+ *
+ * Usage : random-access-benchmark [elements] [threads]
+ *
+ * NB : on random access iterators, libstdc++'s std::reduce is unrolled with
+ *      first[1], first[2]... : each of them is a (short) jump, slower than
+ *      the single addition of operator++.
+ */
+
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <vector>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <time-measure.hpp>
+#include <work-stealing-pool.hpp>
+#include <parallel-algorithms.hpp>
+#include <fibonacci-forward.hpp>
+#include <fibonacci-random-access.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define ELEMENTS 1e8 // The default size of the Fibonacci ranges
+#define QUERIES  1e2 // Number of scattered F(k) computed...
+#define MAX_K    1e7 // ... for k in [0, MAX_K[
+
+static volatile std::ptrdiff_t g_sink{0}; // Prevents the compiler from dropping the computations
+
+//////////////////////////////////////////////////////////////////////////////////////////
+void benchQueries( size_t p_elements, size_t p_queries )
+{
+    std::cout << "\nF(k) for " << p_queries << " random k in [0, " << p_elements << "[\n";
+
+    std::default_random_engine            random_engine;
+    std::uniform_int_distribution<size_t> distrib( 0, p_elements - 1 );
+    std::vector<size_t>                   myIndices( p_queries );
+    for ( auto& k : myIndices ) { k = distrib(random_engine); }
+
+    const fibonacci_range    myRange  ( p_elements );
+    const fibonacci_RA_range myRARange( p_elements );
+    std::vector<size_t>      myRef( p_queries ), myRes( p_queries );
+    {
+        stopwatch myWatch("\tfibonacci_IT    : std::next( begin, k )");
+        for ( size_t q = 0; q < p_queries; ++q ) {
+            myRef[q] = *std::next( std::begin(myRange), myIndices[q] );
+        }
+    }
+    {
+        stopwatch myWatch("\tfibonacci_RA_IT : begin + k");
+        for ( size_t q = 0; q < p_queries; ++q ) {
+            myRes[q] = *( std::begin(myRARange) + myIndices[q] );
+        }
+    }
+    if ( myRes != myRef ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+}
+
+void benchRange( size_t p_elements, work_stealing_pool& p_pool )
+{
+    const fibonacci_range    myRange  ( p_elements );
+    const fibonacci_RA_range myRARange( p_elements );
+
+    // The results go through g_sink : the two distances are equal, the
+    // compiler would otherwise drop both of them with the check. Even then,
+    // the values computed by fibonacci_IT::operator++ are unused here : the
+    // optimizer reduces its loop of increments to end - begin.
+    std::cout << "\nstd::distance over " << p_elements << " elements (fibonacci_IT : reduced to end - begin by the optimizer)\n";
+    {
+        stopwatch myWatch("\tfibonacci_IT");
+        g_sink = std::distance( std::begin(myRange), std::end(myRange) );
+    }
+    const std::ptrdiff_t l_dist = g_sink;
+    {
+        stopwatch myWatch("\tfibonacci_RA_IT");
+        g_sink = std::distance( std::begin(myRARange), std::end(myRARange) );
+    }
+    if ( g_sink != l_dist ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+
+    std::cout << "\nSum (modulo 2^64) of " << p_elements << " elements\n";
+    size_t l_ref{0};
+    {
+        stopwatch myWatch("\tfibonacci_IT    std::reduce seq");
+        l_ref = std::reduce( std::execution::seq, std::begin(myRange), std::end(myRange), size_t{0} );
+    }
+    auto check = [l_ref]( size_t p_res ) { if ( p_res != l_ref ) { std::cout << "SOMETHING WENT WRONG!\n"; } };
+    {
+        size_t l_res{0};
+        {
+            stopwatch myWatch("\tfibonacci_IT    std::reduce par");
+            l_res = std::reduce( std::execution::par, std::begin(myRange), std::end(myRange), size_t{0} );
+        }
+        check( l_res );
+    }
+    {
+        size_t l_res{0};
+        {
+            stopwatch myWatch("\tfibonacci_RA_IT std::reduce seq");
+            l_res = std::reduce( std::execution::seq, std::begin(myRARange), std::end(myRARange), size_t{0} );
+        }
+        check( l_res );
+    }
+    {
+        size_t l_res{0};
+        {
+            stopwatch myWatch("\tfibonacci_RA_IT std::reduce par");
+            l_res = std::reduce( std::execution::par, std::begin(myRARange), std::end(myRARange), size_t{0} );
+        }
+        check( l_res );
+    }
+    {
+        size_t l_res{0};
+        {
+            stopwatch myWatch("\tfibonacci_RA_IT pstl_lite::parallel_reduce");
+            l_res = pstl_lite::parallel_reduce( p_pool, std::begin(myRARange), std::end(myRARange), size_t{0} );
+        }
+        check( l_res );
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const size_t   l_elements = argc > 1 ? static_cast<size_t>( std::stod( argv[1] ) )
+                                         : static_cast<size_t>( ELEMENTS );
+    const unsigned l_threads  = argc > 2 ? std::stoul( argv[2] )
+                                         : std::thread::hardware_concurrency();
+
+    work_stealing_pool l_pool( l_threads );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nElements - " << l_elements
+              << "\nPool threads - "           << l_pool.size();
+    std::cout << "\n--------------------------------------------------\n";
+
+    benchQueries( std::min( l_elements, static_cast<size_t>( MAX_K ) ), static_cast<size_t>( QUERIES ) );
+    benchRange  ( l_elements, l_pool );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/************************************************************
+ *   Compile-time Fibonacci table vs iterative iterators    *
+ ************************************************************/
+
+/*!
+ * @brief Every fibonacci_range iteration (see inc/fibonacci-forward.hpp)
+ *        recomputes the values, and silently overflows after F(93).
+ *        fibonacci_table_range (see inc/fibonacci-table.hpp) indexes
+ *        a table of every representable value built at compile time.
+ *
+ *        For random index queries, we compare :
+ *          - fibonacci_IT       : std::next( begin, k ), k additions
+ *          - fibonacci_RA_IT    : begin + k, fast doubling
+ *          - fibonacci_table_IT : a table lookup
+ *        and show the overflow detection.
+ *
+ * Usage : table-benchmark [queries]
+ */
+
+#include <algorithm>
+#include <vector>
+#include <iostream>
+#include <random>
+#include <numeric>
+#include <string>
+#include <stdexcept>
+
+#include <time-measure.hpp>
+#include <fibonacci-forward.hpp>
+#include <fibonacci-random-access.hpp>
+#include <fibonacci-table.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define QUERIES 1e7 // The default number of random index queries
+
+// The whole table is usable in constant expressions
+static_assert( fibonacci_table_range( 20 )[19] == 6765 );
+static_assert( fibonacci_at( 93 ) == 12200160415121876738ull );
+
+/*!
+ * @brief Sums the values at every index of p_indices with p_get( index ).
+ */
+template <typename Get>
+size_t benchQueries( const std::string& p_title, const std::vector<size_t>& p_indices, Get&& p_get )
+{
+    size_t l_sum{0};
+    stopwatch myWatch( "\t" + p_title );
+    for ( size_t k : p_indices ) { l_sum += p_get( k ); }
+    return l_sum;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const size_t l_queries = argc > 1 ? static_cast<size_t>( std::stod( argv[1] ) )
+                                      : static_cast<size_t>( QUERIES );
+    const size_t l_max     = fibonacci_table_range::max_size();
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nQueries - " << l_queries
+              << "\nIndices - 0 to "            << l_max - 1
+              << " (F(1) to F(" << l_max << "))";
+    std::cout << "\n--------------------------------------------------\n";
+
+    std::default_random_engine            random_engine;
+    std::uniform_int_distribution<size_t> distrib( 0, l_max - 1 );
+    std::vector<size_t>                   myIndices( l_queries );
+    for ( auto& k : myIndices ) { k = distrib(random_engine); }
+
+    const fibonacci_range       myRange     ( l_max );
+    const fibonacci_RA_range    myRARange   ( l_max );
+    const fibonacci_table_range myTableRange( l_max );
+
+    std::cout << "\nRANDOM INDEX QUERIES\n";
+    const size_t l_ref = benchQueries( "fibonacci_IT       : std::next( begin, k )", myIndices, [&]( size_t k ) {
+        return *std::next( std::begin(myRange), k );
+    });
+    const size_t l_ra = benchQueries( "fibonacci_RA_IT    : begin + k", myIndices, [&]( size_t k ) {
+        return *( std::begin(myRARange) + k );
+    });
+    const size_t l_table = benchQueries( "fibonacci_table_IT : range[k]", myIndices, [&]( size_t k ) {
+        return myTableRange[k];
+    });
+    if ( l_ra != l_ref || l_table != l_ref ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+
+    std::cout << "\nOVERFLOW DETECTION\n";
+    std::cout << "\tfibonacci_range( 100 ) - last value : "
+              << *std::next( std::begin(myRange), l_max - 1 ) << " then "
+              << *std::next( std::begin(fibonacci_range( 100 )), 99 ) << " (wrapped around)\n";
+    try {
+        fibonacci_table_range myTooBig( 100 );
+    }
+    catch ( const std::out_of_range& e ) {
+        std::cout << "\tfibonacci_table_range( 100 ) - " << e.what() << "\n";
+    }
+    try {
+        std::cout << myTableRange.at( l_max );
+    }
+    catch ( const std::out_of_range& e ) {
+        std::cout << "\tat( " << l_max << " ) - " << e.what() << "\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,224 @@
+#ifndef HANDLE_POOL_HPP
+#define HANDLE_POOL_HPP
+
+/*!
+ * @brief handle_pool
+ *        make_unique_APIClass (memory_handle_legacy_api.cpp) gives the
+ *        deleter of the legacy API to the smart pointer : every handle is
+ *        created, and destroyed, for a single use. When the creation is
+ *        expensive (connection, context, big allocation...), the handles
+ *        can be reused : the deleter of the pool gives them back instead.
+ *
+ *            handle_pool<APIClass> myPool( []{ return APIClass::createAPIClass("POOLED"); },
+ *                                          APIClass::deleteAPIClass );
+ *            {
+ *                auto myClass = myPool.acquire();   // Created, or reused
+ *                myClass->doJob();
+ *            }                                      // Back into the pool
+ *
+ *        The pool is thread-safe (one std::mutex, never held while creating
+ *        or destroying a handle) and bounded :
+ *          - at most max_total handles exist, acquire() waits beyond
+ *          - at most max_idle handles are kept, the others are destroyed
+ *          - the handles unused for idle_timeout are destroyed (checked at
+ *            each acquire/release, or by evict_idle())
+ *
+ * @note The pool must outlive its handles. The most recently released
+ *       handle is reused first (its memory is the most likely to be cached),
+ *       the oldest ones are evicted first.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+template <typename T>
+class handle_pool
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /*!
+     * @brief Deleter giving the handle back to its pool.
+     */
+    struct returner {
+        handle_pool* m_pool { nullptr };
+        void operator()( T* p_handle ) const { m_pool->release( p_handle ); }
+    };
+
+    using handle = std::unique_ptr<T, returner>;
+
+    struct limits {
+        std::size_t               max_total    = 64;    /*!< Handles created and not destroyed */
+        std::size_t               max_idle     = 16;    /*!< Handles kept for reuse            */
+        std::chrono::milliseconds idle_timeout { 1000 };
+    };
+
+    struct stats {
+        std::size_t created;
+        std::size_t destroyed;
+        std::size_t reused;
+        std::size_t idle;
+    };
+
+    handle_pool( std::function<T*()> p_create, std::function<void(T*)> p_destroy, limits p_limits = {} ) :
+        m_create( std::move( p_create ) ),
+        m_destroy( std::move( p_destroy ) ),
+        m_limits( p_limits )
+    {
+        m_limits.max_total = std::max<std::size_t>( 1, m_limits.max_total );
+    }
+
+    ~handle_pool()
+    {
+        for ( const auto& l_idle : m_idle ) { m_destroy( l_idle.m_handle ); }
+    }
+
+    handle_pool( const handle_pool& )            = delete;
+    handle_pool& operator=( const handle_pool& ) = delete;
+
+    /*!
+     * @brief An idle handle, or a new one. Waits if max_total handles are in use.
+     */
+    handle acquire()
+    {
+        T* l_handle = nullptr;
+        for (;;) {
+            // The expired handles still count in m_total : they are destroyed
+            // before waiting, since nobody else would release their room.
+            std::vector<T*> l_expired;
+            {
+                std::unique_lock<std::mutex> l_lock( m_mutex );
+                collect_expired( clock::now(), l_expired );
+                if ( l_expired.empty() ) {
+                    m_released.wait( l_lock, [this] { return !m_idle.empty() || m_total < m_limits.max_total; } );
+
+                    if ( !m_idle.empty() ) {
+                        l_handle = m_idle.back().m_handle;
+                        m_idle.pop_back();
+                        ++m_reused;
+                    } else {
+                        ++m_total;  // Reserved : created out of the lock
+                    }
+                    break;
+                }
+            }
+            destroy( l_expired );
+        }
+        if ( l_handle ) return handle( l_handle, returner{ this } );
+
+        try {
+            l_handle = m_create();
+        } catch ( ... ) {
+            unreserve();
+            throw;
+        }
+        if ( !l_handle ) { unreserve(); return handle( nullptr, returner{ this } ); }
+
+        {
+            std::lock_guard<std::mutex> l_lock( m_mutex );
+            ++m_created;
+        }
+        return handle( l_handle, returner{ this } );
+    }
+
+    /*!
+     * @brief Same as acquire(), for shared ownership.
+     */
+    std::shared_ptr<T> acquire_shared() { return acquire(); }
+
+    /*!
+     * @brief Destroys the handles unused for more than idle_timeout.
+     */
+    void evict_idle()
+    {
+        std::vector<T*> l_expired;
+        {
+            std::lock_guard<std::mutex> l_lock( m_mutex );
+            collect_expired( clock::now(), l_expired );
+        }
+        destroy( l_expired );
+    }
+
+    stats get_stats() const
+    {
+        std::lock_guard<std::mutex> l_lock( m_mutex );
+        return { m_created, m_destroyed, m_reused, m_idle.size() };
+    }
+
+private:
+    struct idle_handle {
+        T*                m_handle;
+        clock::time_point m_since;
+    };
+
+    void release( T* p_handle )
+    {
+        const auto      l_now = clock::now();
+        std::vector<T*> l_expired;
+        {
+            std::lock_guard<std::mutex> l_lock( m_mutex );
+            collect_expired( l_now, l_expired );
+            if ( m_idle.size() < m_limits.max_idle ) {
+                m_idle.push_back( { p_handle, l_now } );
+            } else {
+                l_expired.push_back( p_handle );
+            }
+        }
+        m_released.notify_one();
+        destroy( l_expired );
+    }
+
+    /*!
+     * @brief Moves the expired idle handles to p_expired (m_mutex held),
+     *        to be destroyed out of the lock.
+     */
+    void collect_expired( clock::time_point p_now, std::vector<T*>& p_expired )
+    {
+        while ( !m_idle.empty() && p_now - m_idle.front().m_since > m_limits.idle_timeout ) {
+            p_expired.push_back( m_idle.front().m_handle );
+            m_idle.pop_front();
+        }
+    }
+
+    void destroy( const std::vector<T*>& p_handles )
+    {
+        if ( p_handles.empty() ) return;
+        for ( T* l_handle : p_handles ) { m_destroy( l_handle ); }
+        {
+            std::lock_guard<std::mutex> l_lock( m_mutex );
+            m_total     -= p_handles.size();
+            m_destroyed += p_handles.size();
+        }
+        m_released.notify_all();
+    }
+
+    void unreserve()
+    {
+        {
+            std::lock_guard<std::mutex> l_lock( m_mutex );
+            --m_total;
+        }
+        m_released.notify_one();
+    }
+
+    std::function<T*()>      m_create;
+    std::function<void(T*)>  m_destroy;
+    limits                   m_limits;
+
+    mutable std::mutex       m_mutex;
+    std::condition_variable  m_released;
+    std::deque<idle_handle>  m_idle;            /*!< Oldest first */
+    std::size_t              m_total     { 0 }; /*!< Idle, in use or being created */
+    std::size_t              m_created   { 0 };
+    std::size_t              m_destroyed { 0 };
+    std::size_t              m_reused    { 0 };
+};
+
+#endif // HANDLE_POOL_HPP
@@ -0,0 +1,176 @@
+/************************************************************
+ *     Pooled legacy handles vs create/delete per use       *
+ ************************************************************/
+
+/*!
+ * @brief make_unique_APIClass (see memory_handle_legacy_api.cpp) creates and
+ *        deletes a legacy object at each use. Here createAPIClass is
+ *        expensive (CREATE_COST us of work), and N threads use a handle
+ *        USES times each, with (see inc/handle-pool.hpp) :
+ *          - make_unique_APIClass : create + delete per use
+ *          - handle_pool::acquire()        : std::unique_ptr given back to the pool
+ *          - handle_pool::acquire_shared() : same, with a std::shared_ptr
+ *
+ *        The pool allows at most one handle per thread. Its idle handles
+ *        are then evicted after IDLE_TIMEOUT ms. Last, a pool of a single
+ *        handle must create a new one when the idle one has expired.
+ *
+ * Usage : pool-benchmark [uses per thread] [max threads]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <time-measure.hpp>
+#include <handle-pool.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define USES         20000 // Default number of uses per thread
+#define THREADS      8     // Default maximum number of threads
+#define CREATE_COST  20    // Cost of createAPIClass (us)
+#define IDLE_TIMEOUT 50    // Idle handles are evicted after (ms)
+
+/*!
+ * @brief Spins for p_us microseconds (the work of the legacy library).
+ */
+void spin( int p_us )
+{
+    const auto l_end = std::chrono::steady_clock::now() + std::chrono::microseconds( p_us );
+    while ( std::chrono::steady_clock::now() < l_end ) {}
+}
+
+/*!
+ * @brief LegacyAPI of memory_handle_legacy_api.cpp, with an expensive creation.
+ */
+namespace LegacyAPI {
+
+    class APIClass {
+        public:
+            static APIClass* createAPIClass( const std::string& p_name ) {
+                s_created.fetch_add( 1, std::memory_order_relaxed );
+                return new APIClass(p_name);
+            }
+            static void deleteAPIClass( APIClass* p_inst ) { delete p_inst; }
+
+            void doJob(void) { ++m_jobs; }
+
+            static std::atomic<std::size_t> s_created;
+
+        private:
+            APIClass(const std::string &p_name) : m_name(p_name) { spin( CREATE_COST ); }
+            ~APIClass() = default;
+
+            std::string m_name;
+            std::size_t m_jobs { 0 };
+    };
+
+    std::atomic<std::size_t> APIClass::s_created { 0 };
+
+}
+
+using namespace LegacyAPI;
+
+static std::unique_ptr< APIClass, void (*)(APIClass*) >
+make_unique_APIClass( const std::string& p_name ) {
+    return { APIClass::createAPIClass(p_name), APIClass::deleteAPIClass };
+}
+
+/*!
+ * @brief p_threads threads call p_use() p_uses times each, returns the time in us.
+ */
+template <typename Func>
+long long runThreads( unsigned p_threads, std::size_t p_uses, Func&& p_use )
+{
+    return measure<std::chrono::microseconds>( [&] {
+        std::vector<std::thread> l_threads;
+        for ( unsigned t = 0; t < p_threads; ++t ) {
+            l_threads.emplace_back( [&] {
+                for ( std::size_t i = 0; i < p_uses; ++i ) { p_use(); }
+            });
+        }
+        for ( auto& l_thread : l_threads ) { l_thread.join(); }
+    });
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_uses    = argc > 1 ? std::stoul( argv[1] ) : USES;
+    const unsigned    l_threads = argc > 2 ? static_cast<unsigned>( std::stoul( argv[2] ) ) : THREADS;
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nUses        - " << l_uses << " per thread"
+              << "\nMax threads - " << l_threads << "\nCreate cost - " << CREATE_COST << " us";
+    std::cout << "\n--------------------------------------------------\n";
+
+    std::cout << "\n" << std::setw(8) << "threads" << std::setw(22) << "make_unique_APIClass"
+              << std::setw(18) << "acquire()" << std::setw(18) << "acquire_shared()" << std::setw(10) << "created"
+              << "   (uses/s)\n";
+
+    bool myOk = true;
+    for ( unsigned l_nb = 1; l_nb <= l_threads; l_nb *= 2 ) {
+        const double l_total = static_cast<double>( l_nb * l_uses );
+
+        const long long myUniqueTime = runThreads( l_nb, l_uses, [] {
+            auto myClass = make_unique_APIClass("UNIQUE POINTER");
+            myClass->doJob();
+        });
+
+        handle_pool<APIClass>::limits myLimits;
+        myLimits.max_total    = l_nb;
+        myLimits.max_idle     = l_nb;
+        myLimits.idle_timeout = std::chrono::milliseconds( IDLE_TIMEOUT );
+        handle_pool<APIClass> myPool( []{ return APIClass::createAPIClass("POOLED"); }, APIClass::deleteAPIClass, myLimits );
+
+        const std::size_t l_created    = APIClass::s_created;
+        const long long   myPoolTime   = runThreads( l_nb, l_uses, [&] {
+            auto myClass = myPool.acquire();
+            myClass->doJob();
+        });
+        const long long   mySharedTime = runThreads( l_nb, l_uses, [&] {
+            std::shared_ptr<APIClass> myClass = myPool.acquire_shared();
+            myClass->doJob();
+        });
+        const std::size_t l_pooled = APIClass::s_created - l_created;
+
+        auto perSecond = [&]( long long p_us ) { return static_cast<std::size_t>( l_total / std::max( 1LL, p_us ) * 1e6 ); };
+        std::cout << std::setw(8) << l_nb << std::setw(22) << perSecond( myUniqueTime ) << std::setw(18) << perSecond( myPoolTime )
+                  << std::setw(18) << perSecond( mySharedTime ) << std::setw(10) << l_pooled << "\n";
+
+        // Idle eviction
+        std::this_thread::sleep_for( std::chrono::milliseconds( 2 * IDLE_TIMEOUT ) );
+        myPool.evict_idle();
+        const auto l_stats = myPool.get_stats();
+
+        myOk = myOk && l_pooled <= l_nb && l_stats.idle == 0 && l_stats.destroyed == l_stats.created
+                    && l_stats.reused + l_stats.created == 2 * l_nb * l_uses;
+    }
+
+    // A single handle, expired when it is acquired again
+    {
+        handle_pool<APIClass>::limits myLimits;
+        myLimits.max_total    = 1;
+        myLimits.idle_timeout = std::chrono::milliseconds( IDLE_TIMEOUT / 5 );
+        handle_pool<APIClass> myPool( []{ return APIClass::createAPIClass("EXPIRED"); }, APIClass::deleteAPIClass, myLimits );
+
+        myPool.acquire()->doJob();
+        std::this_thread::sleep_for( std::chrono::milliseconds( IDLE_TIMEOUT ) );
+        myPool.acquire()->doJob();
+
+        const auto l_stats = myPool.get_stats();
+        std::cout << "\nAcquire after the idle timeout : " << l_stats.created << " created, "
+                  << l_stats.destroyed << " destroyed\n";
+        myOk = myOk && l_stats.created == 2 && l_stats.destroyed == 1 && l_stats.reused == 0;
+    }
+
+    if ( !myOk ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+
+    return EXIT_SUCCESS;
+}
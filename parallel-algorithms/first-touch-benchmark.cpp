@@ -0,0 +1,172 @@
+/************************************************************
+ *      Memory placement (NUMA first touch) and parallel    *
+ *                         sorting                          *
+ ************************************************************/
+
+/*!
+ * @brief The parallel sorts of stl-algorithms-policies.cpp run on a vector
+ *        filled by the main thread. With the Linux first-touch policy, all
+ *        of its pages then live on the NUMA node of the main thread and the
+ *        workers running on the other nodes fight over remote memory.
+ *
+ *        Here, the same data is sorted twice :
+ *          - "serial init" : the vector is filled by the main thread.
+ *          - "first touch" : the vector is filled in parallel by pinned
+ *            workers, each one touching the block it owns
+ *            (see inc/first-touch.hpp).
+ *        The gap between the two shows how much of the parallel speedup
+ *        is lost to memory placement on this machine (none on a single
+ *        node machine). A per-thread breakdown of the pool sorts shows
+ *        how the work got balanced.
+ *
+ * Usage : first-touch-benchmark [elements] [threads]
+ */
+
+#include <algorithm>
+#include <execution>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdint>
+
+#include <time-measure.hpp>
+#include <work-stealing-pool.hpp>
+#include <parallel-algorithms.hpp>
+#include <radix-sort.hpp>
+#include <first-touch.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define ELEMENTS 1e8 // The default number of elements in the vector
+
+/*!
+ * @brief Value of the p_idx-th element, in [0, 100[.
+ *        A counter-based generator (splitmix64) : any thread can
+ *        produce any element, the data is the same whoever fills it.
+ */
+double generate( std::size_t p_idx )
+{
+    std::uint64_t z = ( p_idx + 1 ) * 0x9E3779B97F4A7C15ull;
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+    z =   z ^ ( z >> 31 );
+
+    return 100.0 * static_cast<double>( z >> 11 ) / static_cast<double>( 1ull << 53 );
+}
+
+/*!
+ * @brief Time (in ms) of each sort for one placement of the data.
+ */
+struct results {
+    std::string                                   name;
+    double                                        seq, par, pool_sort, pool_radix;
+    std::vector<work_stealing_pool::thread_stats> sort_stats, radix_stats;
+};
+
+template <typename Fill>
+results benchPlacement( const std::string& p_name, std::size_t p_size,
+                        work_stealing_pool& p_pool, Fill&& p_fill )
+{
+    using ms = std::chrono::milliseconds;
+
+    // The pages are placed here, by the first fill, and stay where
+    // they are for every following run.
+    pstl_lite::first_touch_vector<double> myVec( p_size );
+    p_fill( myVec );
+
+    results l_res;
+    l_res.name = p_name;
+
+    l_res.seq = measure<ms>( [&] { std::sort( std::execution::seq, std::begin(myVec), std::end(myVec) ); } );
+
+    p_fill( myVec );
+    l_res.par = measure<ms>( [&] { std::sort( std::execution::par, std::begin(myVec), std::end(myVec) ); } );
+
+    p_fill( myVec );
+    p_pool.reset_stats();
+    l_res.pool_sort = measure<ms>( [&] { pstl_lite::parallel_sort( p_pool, std::begin(myVec), std::end(myVec) ); } );
+    l_res.sort_stats = p_pool.stats();
+
+    p_fill( myVec );
+    p_pool.reset_stats();
+    l_res.pool_radix = measure<ms>( [&] { pstl_lite::radix_sort( p_pool, std::begin(myVec), std::end(myVec) ); } );
+    l_res.radix_stats = p_pool.stats();
+
+    if ( !std::is_sorted( std::begin(myVec), std::end(myVec) ) ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+
+    return l_res;
+}
+
+void printBreakdown( const std::string& p_title, const std::vector<work_stealing_pool::thread_stats>& p_stats )
+{
+    std::cout << "\n" << p_title << "\n";
+    std::cout << std::setw(12) << "thread"
+              << std::setw(10) << "tasks"
+              << std::setw(10) << "steals"
+              << std::setw(12) << "busy (ms)" << "\n";
+    for ( std::size_t t = 0; t < p_stats.size(); ++t ) {
+        std::cout << std::setw(12) << ( t + 1 < p_stats.size() ? std::to_string(t) : std::string("external") )
+                  << std::setw(10) << p_stats[t].tasks
+                  << std::setw(10) << p_stats[t].steals
+                  << std::setw(12) << std::chrono::duration_cast<std::chrono::milliseconds>( p_stats[t].busy ).count()
+                  << "\n";
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_elements = argc > 1 ? static_cast<std::size_t>( std::stod( argv[1] ) )
+                                            : static_cast<std::size_t>( ELEMENTS );
+    const unsigned    l_threads  = argc > 2 ? std::stoul( argv[2] )
+                                            : std::thread::hardware_concurrency();
+
+    // The main thread also executes tasks while waiting : pin it as well
+    const bool         l_pinned = pin_current_thread( 0 );
+    work_stealing_pool l_pool( l_threads, true );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nElements - " << l_elements
+              << "\nPool threads - "           << l_pool.size()
+              << "\nThread pinning - "         << ( l_pinned ? "yes" : "not supported" );
+    std::cout << "\n--------------------------------------------------\n";
+
+    const results l_serial = benchPlacement( "serial init", l_elements, l_pool, []( auto& v ) {
+        for ( std::size_t i = 0; i < v.size(); ++i ) { v[i] = generate( i ); }
+    });
+    const results l_touch  = benchPlacement( "first touch", l_elements, l_pool, [&]( auto& v ) {
+        pstl_lite::first_touch_fill( l_pool, v, generate );
+    });
+
+    std::cout << "\nSort time (ms)\n";
+    std::cout << std::setw(14) << "placement"
+              << std::setw(12) << "seq"
+              << std::setw(12) << "par"
+              << std::setw(12) << "pool sort"
+              << std::setw(12) << "pool radix" << "\n";
+    for ( const auto& r : { l_serial, l_touch } ) {
+        std::cout << std::setw(14) << r.name << std::fixed << std::setprecision(0)
+                  << std::setw(12) << r.seq
+                  << std::setw(12) << r.par
+                  << std::setw(12) << r.pool_sort
+                  << std::setw(12) << r.pool_radix << "\n";
+    }
+
+    // Speedups are computed against the sequential sort of the same placement
+    std::cout << "\nSpeedup over seq (serial init -> first touch)\n" << std::setprecision(2);
+    auto l_speedups = [&]( const std::string& p_name, double results::* p_field ) {
+        std::cout << std::setw(14) << p_name << " : "
+                  << l_serial.seq / l_serial.*p_field << "x -> "
+                  << l_touch .seq / l_touch .*p_field << "x\n";
+    };
+    l_speedups( "par",        &results::par        );
+    l_speedups( "pool sort",  &results::pool_sort  );
+    l_speedups( "pool radix", &results::pool_radix );
+
+    printBreakdown( "pool sort - serial init",  l_serial.sort_stats  );
+    printBreakdown( "pool sort - first touch",  l_touch .sort_stats  );
+    printBreakdown( "pool radix - serial init", l_serial.radix_stats );
+    printBreakdown( "pool radix - first touch", l_touch .radix_stats );
+
+    return EXIT_SUCCESS;
+}
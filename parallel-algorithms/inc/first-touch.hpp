@@ -0,0 +1,81 @@
+#ifndef FIRST_TOUCH_HPP
+#define FIRST_TOUCH_HPP
+
+/*!
+ * @brief On NUMA machines, the OS (first-touch policy) places a memory page
+ *        on the node of the thread that writes it first, not of the thread
+ *        that allocated it. A std::vector<double>(n) value-initializes its
+ *        elements on the calling thread : every page lands on one node and
+ *        all the other workers then read remote memory.
+ *
+ *        default_init_allocator skips that initialization, so that the
+ *        pages are only touched when the vector is filled, which can then
+ *        be done in parallel by the (pinned) workers that will use them.
+ *
+ * More infos here :
+ *   - https://www.kernel.org/doc/html/latest/admin-guide/mm/numa_memory_policy.html
+ */
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <work-stealing-pool.hpp>
+#include <parallel-algorithms.hpp>
+
+namespace pstl_lite {
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief default_init_allocator
+ *        Allocator turning value-initialization ( T() ) into
+ *        default-initialization ( T ), i.e. a no-op for trivial types.
+ */
+template <typename T, typename Alloc = std::allocator<T>>
+class default_init_allocator : public Alloc
+{
+    using traits = std::allocator_traits<Alloc>;
+
+public:
+    template <typename U>
+    struct rebind {
+        using other = default_init_allocator<U, typename traits::template rebind_alloc<U>>;
+    };
+
+    using Alloc::Alloc;
+
+    template <typename U>
+    void construct( U* p_ptr ) noexcept( std::is_nothrow_default_constructible_v<U> ) {
+        ::new ( static_cast<void*>( p_ptr ) ) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct( U* p_ptr, Args&&... p_args ) {
+        traits::construct( static_cast<Alloc&>( *this ), p_ptr, std::forward<Args>( p_args )... );
+    }
+};
+
+/*!
+ * @brief A vector whose elements are left untouched by its constructor.
+ */
+template <typename T>
+using first_touch_vector = std::vector<T, default_init_allocator<T>>;
+
+/*!
+ * @brief Writes p_gen( i ) into every p_vec[i] : the w-th contiguous block
+ *        is written, hence first-touched, by the w-th worker (see static_for),
+ *        the same blocks as the chunks of the parallel radix_sort.
+ */
+template <typename T, typename Alloc, typename Gen>
+void first_touch_fill( work_stealing_pool& p_pool, std::vector<T, Alloc>& p_vec, Gen&& p_gen )
+{
+    static_for( p_pool, std::size_t{0}, p_vec.size(), [&]( std::size_t p_begin, std::size_t p_end ) {
+        for ( std::size_t i = p_begin; i < p_end; ++i ) { p_vec[i] = p_gen( i ); }
+    });
+}
+
+} // namespace pstl_lite
+
+#endif // FIRST_TOUCH_HPP
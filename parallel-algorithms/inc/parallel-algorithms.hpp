@@ -0,0 +1,217 @@
+#ifndef PARALLEL_ALGORITHMS_HPP
+#define PARALLEL_ALGORITHMS_HPP
+
+/*!
+ * @brief Parallel algorithms built on top of work_stealing_pool.
+ *
+ *        They do not depend on any std::execution backend (with
+ *        libstdc++, std::execution::par needs Intel TBB and silently
+ *        runs sequentially without it).
+ */
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include <work-stealing-pool.hpp>
+
+namespace pstl_lite {
+
+/*!
+ * @brief Default grain size : enough chunks per worker for
+ *        the stealing to balance the load, but not too many
+ *        to keep the scheduling overhead low.
+ */
+template <typename Size>
+Size default_grain( const work_stealing_pool& p_pool, Size p_count )
+{
+    const Size l_chunks = static_cast<Size>( 8 * p_pool.size() );
+    return std::max<Size>( 1, p_count / l_chunks );
+}
+
+namespace detail {
+
+    template <typename Index, typename Func>
+    void parallel_for_split( task_group& p_group,
+                             Index       p_first,
+                             Index       p_last,
+                             Index       p_grain,
+                             Func&       p_func )
+    {
+        // Keep the first half for us and give the second one away,
+        // recursively : the biggest chunks are the first to be stolen.
+        while ( p_last - p_first > p_grain ) {
+            const Index l_mid = p_first + ( p_last - p_first ) / 2;
+            p_group.run( [&p_group, l_mid, p_last, p_grain, &p_func] {
+                parallel_for_split( p_group, l_mid, p_last, p_grain, p_func );
+            });
+            p_last = l_mid;
+        }
+        p_func( p_first, p_last );
+    }
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Calls p_func( begin, end ) over sub-ranges covering [p_first, p_last[.
+ *        p_grain is the maximum size of a sub-range (0 for automatic).
+ */
+template <typename Index, typename Func>
+void parallel_for( work_stealing_pool& p_pool,
+                   Index               p_first,
+                   Index               p_last,
+                   Func&&              p_func,
+                   Index               p_grain = 0 )
+{
+    if ( p_last <= p_first ) return;
+    if ( p_grain <= 0 ) { p_grain = default_grain( p_pool, p_last - p_first ); }
+
+    task_group l_group( p_pool );
+    detail::parallel_for_split( l_group, p_first, p_last, p_grain, p_func );
+    l_group.wait();
+}
+
+/*!
+ * @brief Calls p_func( begin, end ) over one contiguous block of [p_first, p_last[
+ *        per worker : the w-th block is executed by the w-th worker, whatever
+ *        the load (no stealing). Block w is [p_first + w * n, p_first + (w+1) * n[
+ *        with n = ceil( count / workers ).
+ */
+template <typename Index, typename Func>
+void static_for( work_stealing_pool& p_pool,
+                 Index               p_first,
+                 Index               p_last,
+                 Func&&              p_func )
+{
+    if ( p_last <= p_first ) return;
+    const Index l_block = ( p_last - p_first + p_pool.size() - 1 ) / p_pool.size();
+
+    task_group l_group( p_pool );
+    for ( unsigned w = 0; w < p_pool.size(); ++w ) {
+        const Index l_begin = p_first + std::min<Index>( p_last - p_first, w * l_block );
+        const Index l_end   = p_first + std::min<Index>( p_last - p_first, ( w + 1 ) * l_block );
+        if ( l_begin < l_end ) {
+            l_group.run_on( w, [&p_func, l_begin, l_end] { p_func( l_begin, l_end ); } );
+        }
+    }
+    l_group.wait();
+}
+
+/*!
+ * @brief Reduces [p_first, p_last[ with p_op, starting from p_init.
+ *
+ * @note The range is split into fixed chunks whose partial results are
+ *       combined in order, so the result does not depend on the scheduling
+ *       (important for floating point values).
+ */
+template <typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+T parallel_reduce( work_stealing_pool& p_pool,
+                   RandomIt            p_first,
+                   RandomIt            p_last,
+                   T                   p_init,
+                   BinaryOp            p_op = {} )
+{
+    using diff_t = typename std::iterator_traits<RandomIt>::difference_type;
+
+    const diff_t l_count = std::distance( p_first, p_last );
+    if ( l_count <= 0 ) return p_init;
+
+    const diff_t l_grain  = default_grain( p_pool, l_count );
+    const diff_t l_chunks = ( l_count + l_grain - 1 ) / l_grain;
+
+    std::vector<std::optional<T>> l_partials( l_chunks );
+    parallel_for( p_pool, diff_t{0}, l_chunks, [&]( diff_t p_begin, diff_t p_end ) {
+        for ( diff_t c = p_begin; c < p_end; ++c ) {
+            RandomIt l_first = p_first + c * l_grain;
+            RandomIt l_last  = p_first + std::min( l_count, ( c + 1 ) * l_grain );
+            T        l_acc   = *l_first;
+            for ( ++l_first; l_first != l_last; ++l_first ) { l_acc = p_op( l_acc, *l_first ); }
+            l_partials[c] = std::move( l_acc );
+        }
+    }, diff_t{1} );
+
+    for ( auto& l_part : l_partials ) { p_init = p_op( p_init, std::move( *l_part ) ); }
+    return p_init;
+}
+
+namespace detail {
+
+    template <typename RandomIt, typename Compare>
+    void parallel_sort_rec( task_group& p_group,
+                            RandomIt    p_first,
+                            RandomIt    p_last,
+                            Compare&    p_comp,
+                            std::ptrdiff_t p_cutoff,
+                            int         p_depth )
+    {
+        while ( p_last - p_first > p_cutoff ) {
+            if ( p_depth-- == 0 ) break; // Bad pivots : let std::sort (introsort) finish
+
+            // Median of three pivot
+            RandomIt l_mid = p_first + ( p_last - p_first ) / 2;
+            auto     l_a   = *p_first, l_b = *l_mid, l_c = *std::prev( p_last );
+            if ( p_comp( l_b, l_a ) ) std::swap( l_a, l_b );
+            if ( p_comp( l_c, l_b ) ) std::swap( l_b, l_c );
+            if ( p_comp( l_b, l_a ) ) std::swap( l_a, l_b );
+            const auto l_pivot = l_b;
+
+            // Three-way partition : [ < pivot | == pivot | > pivot ]
+            RandomIt l_lt = std::partition( p_first, p_last,
+                                            [&]( const auto& v ) { return p_comp( v, l_pivot ); } );
+            RandomIt l_gt = std::partition( l_lt, p_last,
+                                            [&]( const auto& v ) { return !p_comp( l_pivot, v ); } );
+
+            // Give the smaller part away, keep looping on the bigger one
+            if ( l_lt - p_first < p_last - l_gt ) {
+                p_group.run( [&p_group, p_first, l_lt, &p_comp, p_cutoff, p_depth] {
+                    parallel_sort_rec( p_group, p_first, l_lt, p_comp, p_cutoff, p_depth );
+                });
+                p_first = l_gt;
+            }
+            else {
+                p_group.run( [&p_group, l_gt, p_last, &p_comp, p_cutoff, p_depth] {
+                    parallel_sort_rec( p_group, l_gt, p_last, p_comp, p_cutoff, p_depth );
+                });
+                p_last = l_lt;
+            }
+        }
+        std::sort( p_first, p_last, p_comp );
+    }
+
+} // namespace detail
+
+/*!
+ * @brief Sorts [p_first, p_last[ using a parallel quicksort :
+ *        each partition step spawns one side as a new task.
+ *        Small (or degenerated) partitions fall back to std::sort.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sort( work_stealing_pool& p_pool,
+                    RandomIt            p_first,
+                    RandomIt            p_last,
+                    Compare             p_comp = {} )
+{
+    const std::ptrdiff_t l_count = p_last - p_first;
+    const std::ptrdiff_t l_cutoff =
+        std::max<std::ptrdiff_t>( 1 << 14, l_count / ( 16 * p_pool.size() ) );
+
+    if ( l_count <= l_cutoff || p_pool.size() == 1 ) {
+        std::sort( p_first, p_last, p_comp );
+        return;
+    }
+
+    int l_depth = 0;
+    for ( std::ptrdiff_t n = l_count; n > 1; n >>= 1 ) { l_depth += 2; }
+
+    task_group l_group( p_pool );
+    detail::parallel_sort_rec( l_group, p_first, p_last, p_comp, l_cutoff, l_depth );
+    l_group.wait();
+}
+
+} // namespace pstl_lite
+
+#endif // PARALLEL_ALGORITHMS_HPP
@@ -0,0 +1,188 @@
+#ifndef PARALLEL_MERGE_HPP
+#define PARALLEL_MERGE_HPP
+
+/*!
+ * @brief Merging of already sorted runs.
+ *
+ *        - parallel_merge : two-way merge split with "co-ranking" :
+ *          for any output position k, a binary search finds how many
+ *          elements (i, k - i) of each input come before it. Every task
+ *          then merges its own slice of the output with std::merge,
+ *          without any synchronisation.
+ *
+ *        - kway_merge : k-way merge through a loser tree (tournament
+ *          tree storing the loser of each match). Replacing the winner
+ *          only replays the log2(k) matches on its path to the root,
+ *          with a single comparison per level.
+ *
+ *        Both are stable : on equal elements, the first run wins.
+ *
+ * More infos here :
+ *   - "Merge Path - Parallel Merging Made Simple", S. Odeh, O. Green,
+ *     Z. Mwassi, O. Shmueli and Y. Birk (2012)
+ *   - "The Art of Computer Programming, Vol. 3", D. Knuth, section 5.4.1
+ */
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <work-stealing-pool.hpp>
+#include <parallel-algorithms.hpp>
+
+namespace pstl_lite {
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Returns i such that merging [p_a, p_a + i[ and [p_b, p_b + k - i[
+ *        gives the first p_k elements of the merge of the two ranges.
+ */
+template <typename RandomIt1, typename RandomIt2, typename Compare>
+std::ptrdiff_t co_rank( std::ptrdiff_t p_k,
+                        RandomIt1      p_a, std::ptrdiff_t p_na,
+                        RandomIt2      p_b, std::ptrdiff_t p_nb,
+                        Compare&       p_comp )
+{
+    std::ptrdiff_t l_lo = std::max<std::ptrdiff_t>( 0, p_k - p_nb );
+    std::ptrdiff_t l_hi = std::min( p_k, p_na );
+
+    // Smallest i for which a[i] (if any) comes strictly after b[k - i - 1]
+    while ( l_lo < l_hi ) {
+        const std::ptrdiff_t i = l_lo + ( l_hi - l_lo ) / 2;
+        const std::ptrdiff_t j = p_k - i;
+        if ( j > 0 && !p_comp( p_b[j - 1], p_a[i] ) ) { l_lo = i + 1; }
+        else                                          { l_hi = i;     }
+    }
+    return l_lo;
+}
+
+/*!
+ * @brief Merges the sorted ranges [p_first1, p_last1[ and [p_first2, p_last2[
+ *        into p_out, in parallel. Returns the end of the output range.
+ */
+template <typename RandomIt1, typename RandomIt2, typename OutIt, typename Compare = std::less<>>
+OutIt parallel_merge( work_stealing_pool& p_pool,
+                      RandomIt1 p_first1, RandomIt1 p_last1,
+                      RandomIt2 p_first2, RandomIt2 p_last2,
+                      OutIt     p_out,
+                      Compare   p_comp = {} )
+{
+    const std::ptrdiff_t l_na    = std::distance( p_first1, p_last1 );
+    const std::ptrdiff_t l_nb    = std::distance( p_first2, p_last2 );
+    const std::ptrdiff_t l_total = l_na + l_nb;
+
+    // Below that, the co-ranking and the tasks cost more than they save
+    constexpr std::ptrdiff_t MIN_SLICE { 1 << 15 };
+    const std::ptrdiff_t l_slice = std::max( MIN_SLICE, default_grain( p_pool, l_total ) );
+
+    if ( l_total <= l_slice ) {
+        return std::merge( p_first1, p_last1, p_first2, p_last2, p_out, p_comp );
+    }
+
+    const std::ptrdiff_t l_slices = ( l_total + l_slice - 1 ) / l_slice;
+    parallel_for( p_pool, std::ptrdiff_t{0}, l_slices, [&]( std::ptrdiff_t p_begin, std::ptrdiff_t p_end ) {
+        for ( std::ptrdiff_t s = p_begin; s < p_end; ++s ) {
+            const std::ptrdiff_t l_k0 = s * l_slice;
+            const std::ptrdiff_t l_k1 = std::min( l_total, l_k0 + l_slice );
+            const std::ptrdiff_t l_i0 = co_rank( l_k0, p_first1, l_na, p_first2, l_nb, p_comp );
+            const std::ptrdiff_t l_i1 = co_rank( l_k1, p_first1, l_na, p_first2, l_nb, p_comp );
+
+            std::merge( p_first1 + l_i0,          p_first1 + l_i1,
+                        p_first2 + ( l_k0 - l_i0 ), p_first2 + ( l_k1 - l_i1 ),
+                        p_out + l_k0, p_comp );
+        }
+    }, std::ptrdiff_t{1} );
+
+    return p_out + l_total;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief loser_tree
+ *        Tournament tree over k sorted runs [first, last[.
+ *        winner() is the index of the run holding the smallest head,
+ *        pop() consumes it and replays the matches of that run.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+class loser_tree
+{
+public:
+    using run = std::pair<RandomIt, RandomIt>;
+
+    explicit loser_tree( std::vector<run> p_runs, Compare p_comp = {} ) :
+        m_runs( std::move( p_runs ) ),
+        m_comp( p_comp )
+    {
+        m_leaves = 1;
+        while ( m_leaves < m_runs.size() ) { m_leaves *= 2; }
+
+        // Play the whole tournament once, bottom-up
+        std::vector<std::size_t> l_winners( 2 * m_leaves );
+        m_losers.assign( m_leaves, 0 );
+        for ( std::size_t i = 0; i < m_leaves; ++i ) { l_winners[m_leaves + i] = i; }
+        for ( std::size_t n = m_leaves - 1; n > 0; --n ) {
+            const std::size_t l_a = l_winners[2 * n], l_b = l_winners[2 * n + 1];
+            if ( beats( l_a, l_b ) ) { l_winners[n] = l_a; m_losers[n] = l_b; }
+            else                     { l_winners[n] = l_b; m_losers[n] = l_a; }
+        }
+        m_winner = l_winners[1];
+    }
+
+    bool        empty () const { return exhausted( m_winner ); }
+    std::size_t winner() const { return m_winner; }
+    RandomIt    top   () const { return m_runs[m_winner].first; }
+
+    void pop()
+    {
+        ++m_runs[m_winner].first;
+
+        std::size_t l_winner = m_winner;
+        for ( std::size_t n = ( m_leaves + l_winner ) / 2; n > 0; n /= 2 ) {
+            if ( beats( m_losers[n], l_winner ) ) { std::swap( m_losers[n], l_winner ); }
+        }
+        m_winner = l_winner;
+    }
+
+private:
+    // Padding leaves (index >= k) behave like exhausted runs
+    bool exhausted( std::size_t p_run ) const {
+        return p_run >= m_runs.size() || m_runs[p_run].first == m_runs[p_run].second;
+    }
+
+    // Does run p_a win against run p_b ? (ties go to the first run : stable)
+    bool beats( std::size_t p_a, std::size_t p_b ) const {
+        if ( exhausted( p_a ) ) return false;
+        if ( exhausted( p_b ) ) return true;
+        if ( m_comp( *m_runs[p_b].first, *m_runs[p_a].first ) ) return false;
+        if ( m_comp( *m_runs[p_a].first, *m_runs[p_b].first ) ) return true;
+        return p_a < p_b;
+    }
+
+    std::vector<run>         m_runs;
+    Compare                  m_comp;
+    std::size_t              m_leaves;
+    std::vector<std::size_t> m_losers; /*!< m_losers[n] : loser of the match at node n */
+    std::size_t              m_winner;
+};
+
+/*!
+ * @brief Merges the sorted runs p_runs into p_out.
+ *        Returns the end of the output range.
+ */
+template <typename RandomIt, typename OutIt, typename Compare = std::less<>>
+OutIt kway_merge( const std::vector<std::pair<RandomIt, RandomIt>>& p_runs,
+                  OutIt                                             p_out,
+                  Compare                                           p_comp = {} )
+{
+    if ( p_runs.size() == 1 ) return std::copy( p_runs[0].first, p_runs[0].second, p_out );
+
+    loser_tree<RandomIt, Compare> l_tree( p_runs, p_comp );
+    for ( ; !l_tree.empty(); l_tree.pop() ) { *p_out++ = *l_tree.top(); }
+    return p_out;
+}
+
+} // namespace pstl_lite
+
+#endif // PARALLEL_MERGE_HPP
@@ -0,0 +1,286 @@
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+/*!
+ * @brief LSD radix sort for numeric keys (int32, int64, float, double).
+ *
+ *        Keys are mapped to unsigned integers whose natural order matches
+ *        the order of the keys :
+ *          - signed integers : flip the sign bit.
+ *          - IEEE-754 floats : flip every bit of negative values (their
+ *            magnitude order is reversed) and only the sign bit of
+ *            positive ones ("sign flip trick").
+ *        Then the keys are sorted 8 bits at a time, from the least
+ *        significant byte to the most significant one, with a stable
+ *        counting sort. Passes where every key has the same byte are skipped.
+ *
+ *        The parallel version splits the input into one chunk per task :
+ *        each chunk builds its own histogram, the histograms are combined
+ *        into per-chunk write offsets and each chunk then scatters its
+ *        elements independently (which keeps the sort stable).
+ *
+ * More infos here :
+ *   - http://stereopsis.com/radix.html
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <work-stealing-pool.hpp>
+#include <parallel-algorithms.hpp>
+#include <first-touch.hpp>
+
+namespace pstl_lite {
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief radix_traits
+ *        Order preserving conversion from a key to an unsigned integer.
+ */
+template <typename Key, typename = void>
+struct radix_traits;
+
+template <typename Key>
+struct radix_traits<Key, std::enable_if_t<std::is_integral_v<Key>>>
+{
+    using bits_type = std::make_unsigned_t<Key>;
+
+    static bits_type to_bits( Key p_key ) {
+        bits_type l_bits = static_cast<bits_type>( p_key );
+        if constexpr ( std::is_signed_v<Key> ) {
+            l_bits ^= bits_type{1} << ( 8 * sizeof(Key) - 1 );
+        }
+        return l_bits;
+    }
+};
+
+template <typename Key>
+struct radix_traits<Key, std::enable_if_t<std::is_floating_point_v<Key>>>
+{
+    static_assert( sizeof(Key) == 4 || sizeof(Key) == 8, "Only float and double are supported" );
+    using bits_type = std::conditional_t<sizeof(Key) == 4, std::uint32_t, std::uint64_t>;
+
+    static bits_type to_bits( Key p_key ) {
+        bits_type l_bits;
+        std::memcpy( &l_bits, &p_key, sizeof(Key) );
+
+        constexpr bits_type SIGN { bits_type{1} << ( 8 * sizeof(Key) - 1 ) };
+        return ( l_bits & SIGN ) ? ~l_bits : ( l_bits | SIGN );
+    }
+};
+
+namespace detail {
+
+    constexpr std::size_t RADIX_BITS    { 8 };
+    constexpr std::size_t RADIX_BUCKETS { 1 << RADIX_BITS };
+
+    using radix_histogram = std::array<std::size_t, RADIX_BUCKETS>;
+
+    template <typename Key>
+    std::size_t radix_digit( Key p_key, std::size_t p_pass ) {
+        return ( radix_traits<Key>::to_bits( p_key ) >> ( p_pass * RADIX_BITS ) ) & ( RADIX_BUCKETS - 1 );
+    }
+
+    /*!
+     * @brief Core of the sort. p_payload may be nullptr (Payload is then unused).
+     *        Runs on p_chunks chunks, through p_pool when it is not nullptr.
+     */
+    template <typename Key, typename Payload>
+    void radix_sort_impl( work_stealing_pool* p_pool,
+                          std::size_t         p_chunks,
+                          Key*                p_keys,
+                          std::size_t         p_count,
+                          Payload*            p_payload )
+    {
+        constexpr std::size_t PASSES { sizeof(Key) };
+        if ( p_count < 2 ) return;
+
+        const std::size_t l_chunk_size = ( p_count + p_chunks - 1 ) / p_chunks;
+        p_chunks = ( p_count + l_chunk_size - 1 ) / l_chunk_size;
+
+        // Chunk c always runs on the same worker, so that every pass finds
+        // its chunk of the temporary buffers where it first-touched it.
+        // The workers get contiguous groups of chunks : about the blocks of
+        // static_for (and of first_touch_fill).
+        auto for_each_chunk = [&]( auto&& p_func ) {
+            if ( p_pool ) {
+                task_group l_group( *p_pool );
+                for ( std::size_t c = 0; c < p_chunks; ++c ) {
+                    const auto l_worker = static_cast<unsigned>( c * p_pool->size() / p_chunks );
+                    l_group.run_on( l_worker, [&p_func, c] { p_func( c ); } );
+                }
+                l_group.wait();
+            }
+            else {
+                for ( std::size_t c = 0; c < p_chunks; ++c ) { p_func( c ); }
+            }
+        };
+
+        // Global histograms of every pass, built in a single read of the input :
+        // they tell which passes can be skipped.
+        std::vector<std::array<radix_histogram, PASSES>> l_global( p_chunks );
+        for_each_chunk( [&]( std::size_t c ) {
+            auto&             l_h     = l_global[c];
+            const std::size_t l_begin = c * l_chunk_size;
+            const std::size_t l_end   = std::min( p_count, l_begin + l_chunk_size );
+            for ( auto& h : l_h ) { h.fill( 0 ); }
+            for ( std::size_t i = l_begin; i < l_end; ++i ) {
+                const auto l_bits = radix_traits<Key>::to_bits( p_keys[i] );
+                for ( std::size_t p = 0; p < PASSES; ++p ) {
+                    ++l_h[p][( l_bits >> ( p * RADIX_BITS ) ) & ( RADIX_BUCKETS - 1 )];
+                }
+            }
+        });
+
+        // Left uninitialized, then first-touched by the worker of each chunk
+        first_touch_vector<Key>     l_keys_tmp( p_count );
+        first_touch_vector<Payload> l_payload_tmp( p_payload ? p_count : 0 );
+        if ( p_pool ) {
+            for_each_chunk( [&]( std::size_t c ) {
+                const std::size_t l_begin = c * l_chunk_size;
+                const std::size_t l_end   = std::min( p_count, l_begin + l_chunk_size );
+                std::fill( l_keys_tmp.data() + l_begin, l_keys_tmp.data() + l_end, Key{} );
+                if constexpr ( std::is_trivially_default_constructible_v<Payload> ) {
+                    if ( p_payload ) { std::fill( l_payload_tmp.data() + l_begin, l_payload_tmp.data() + l_end, Payload{} ); }
+                }
+            });
+        }
+
+        Key*     l_src_keys    = p_keys;
+        Key*     l_dst_keys    = l_keys_tmp.data();
+        Payload* l_src_payload = p_payload;
+        Payload* l_dst_payload = l_payload_tmp.data();
+
+        std::vector<radix_histogram> l_offsets( p_chunks );
+        for ( std::size_t p = 0; p < PASSES; ++p ) {
+            // Skip the pass if every key falls into the same bucket
+            radix_histogram l_total{};
+            for ( std::size_t c = 0; c < p_chunks; ++c ) {
+                for ( std::size_t b = 0; b < RADIX_BUCKETS; ++b ) { l_total[b] += l_global[c][p][b]; }
+            }
+            if ( std::find( std::begin(l_total), std::end(l_total), p_count ) != std::end(l_total) ) {
+                continue;
+            }
+
+            // Per chunk histograms of the current digit (the previous
+            // passes moved the keys around, so they have to be rebuilt).
+            if ( p_chunks == 1 ) {
+                l_offsets[0] = l_total;
+            }
+            else {
+                for_each_chunk( [&]( std::size_t c ) {
+                    auto&             l_h     = l_offsets[c];
+                    const std::size_t l_begin = c * l_chunk_size;
+                    const std::size_t l_end   = std::min( p_count, l_begin + l_chunk_size );
+                    l_h.fill( 0 );
+                    for ( std::size_t i = l_begin; i < l_end; ++i ) { ++l_h[radix_digit( l_src_keys[i], p )]; }
+                });
+            }
+
+            // Offsets : bucket major, chunk minor (keeps the sort stable)
+            std::size_t l_sum{0};
+            for ( std::size_t b = 0; b < RADIX_BUCKETS; ++b ) {
+                for ( std::size_t c = 0; c < p_chunks; ++c ) {
+                    const std::size_t l_nb = l_offsets[c][b];
+                    l_offsets[c][b] = l_sum;
+                    l_sum          += l_nb;
+                }
+            }
+
+            for_each_chunk( [&]( std::size_t c ) {
+                auto&             l_off   = l_offsets[c];
+                const std::size_t l_begin = c * l_chunk_size;
+                const std::size_t l_end   = std::min( p_count, l_begin + l_chunk_size );
+                for ( std::size_t i = l_begin; i < l_end; ++i ) {
+                    const std::size_t l_pos = l_off[radix_digit( l_src_keys[i], p )]++;
+                    l_dst_keys[l_pos] = l_src_keys[i];
+                    if ( p_payload ) { l_dst_payload[l_pos] = std::move( l_src_payload[i] ); }
+                }
+            });
+
+            std::swap( l_src_keys, l_dst_keys );
+            std::swap( l_src_payload, l_dst_payload );
+        }
+
+        // Odd number of passes : the result lives in the temporary buffers
+        if ( l_src_keys != p_keys ) {
+            for_each_chunk( [&]( std::size_t c ) {
+                const std::size_t l_begin = c * l_chunk_size;
+                const std::size_t l_end   = std::min( p_count, l_begin + l_chunk_size );
+                std::copy( l_src_keys + l_begin, l_src_keys + l_end, p_keys + l_begin );
+                if ( p_payload ) {
+                    std::move( l_src_payload + l_begin, l_src_payload + l_end, p_payload + l_begin );
+                }
+            });
+        }
+    }
+
+    template <typename Pool>
+    std::size_t radix_chunks( const Pool& p_pool, std::size_t p_count ) {
+        // Below ~64K elements per chunk, merging histograms costs more than it saves
+        constexpr std::size_t MIN_CHUNK { 1 << 16 };
+        return std::max<std::size_t>( 1, std::min<std::size_t>( 4 * p_pool.size(), p_count / MIN_CHUNK ) );
+    }
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Sequential radix sort of [p_first, p_last[ (contiguous range).
+ */
+template <typename ContiguousIt>
+void radix_sort( ContiguousIt p_first, ContiguousIt p_last )
+{
+    if ( p_first == p_last ) return; // &*p_first would dereference end
+    using key_t = std::remove_reference_t<decltype(*p_first)>;
+    detail::radix_sort_impl<key_t, char>( nullptr, 1, &*p_first, p_last - p_first, nullptr );
+}
+
+/*!
+ * @brief Sequential radix sort of [p_first, p_last[, applying
+ *        the same permutation to the range starting at p_payload.
+ */
+template <typename ContiguousIt, typename PayloadIt>
+void radix_sort( ContiguousIt p_first, ContiguousIt p_last, PayloadIt p_payload )
+{
+    if ( p_first == p_last ) return;
+    using key_t     = std::remove_reference_t<decltype(*p_first)>;
+    using payload_t = std::remove_reference_t<decltype(*p_payload)>;
+    detail::radix_sort_impl<key_t, payload_t>( nullptr, 1, &*p_first, p_last - p_first, &*p_payload );
+}
+
+/*!
+ * @brief Parallel radix sort of [p_first, p_last[ (contiguous range).
+ */
+template <typename ContiguousIt>
+void radix_sort( work_stealing_pool& p_pool, ContiguousIt p_first, ContiguousIt p_last )
+{
+    if ( p_first == p_last ) return;
+    using key_t = std::remove_reference_t<decltype(*p_first)>;
+    const std::size_t l_count = p_last - p_first;
+    detail::radix_sort_impl<key_t, char>( &p_pool, detail::radix_chunks( p_pool, l_count ),
+                                          &*p_first, l_count, nullptr );
+}
+
+/*!
+ * @brief Parallel radix sort of [p_first, p_last[, applying
+ *        the same permutation to the range starting at p_payload.
+ */
+template <typename ContiguousIt, typename PayloadIt>
+void radix_sort( work_stealing_pool& p_pool, ContiguousIt p_first, ContiguousIt p_last, PayloadIt p_payload )
+{
+    if ( p_first == p_last ) return;
+    using key_t     = std::remove_reference_t<decltype(*p_first)>;
+    using payload_t = std::remove_reference_t<decltype(*p_payload)>;
+    const std::size_t l_count = p_last - p_first;
+    detail::radix_sort_impl<key_t, payload_t>( &p_pool, detail::radix_chunks( p_pool, l_count ),
+                                               &*p_first, l_count, &*p_payload );
+}
+
+} // namespace pstl_lite
+
+#endif // RADIX_SORT_HPP
@@ -0,0 +1,26 @@
+#ifndef RANDOM_DATA_HPP
+#define RANDOM_DATA_HPP
+
+#include <random>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Creates a vector of size p_size filled with random doubles
+ *        in [0, 100[ (the generation of pool-benchmark.cpp).
+ *        p_seed allows to create several different vectors.
+ */
+inline std::vector<double> createDoubleVector( std::size_t p_size, unsigned p_seed = 0 )
+{
+    std::uniform_real_distribution<double> distrib( 0, 100 );
+    std::default_random_engine             random_engine;
+
+    if ( p_seed ) { random_engine.seed( p_seed ); }
+
+    std::vector<double> myVec( p_size );
+    for ( auto& v : myVec ) { v = distrib(random_engine); }
+
+    return myVec;
+}
+
+#endif // RANDOM_DATA_HPP
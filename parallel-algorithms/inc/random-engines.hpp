@@ -0,0 +1,541 @@
+#ifndef RANDOM_ENGINES_HPP
+#define RANDOM_ENGINES_HPP
+
+/*!
+ * @brief Small and fast random engines, meeting the UniformRandomBitGenerator
+ *        requirements (usable with std::sample, std::shuffle and the std
+ *        distributions) :
+ *          - xoshiro256ss : xoshiro256**, 256 bits of state, 64 bits outputs.
+ *          - wyrand       : a 64 bits counter hashed by a 128 bits product.
+ *          - pcg32        : 64 bits LCG with a permuted 32 bits output.
+ *        std::mt19937 drags 2.5 KB of state, std::default_random_engine
+ *        (minstd_rand with libstdc++) needs two calls per 64 bits.
+ *
+ *        jump() moves an engine far ahead (2^128 steps for xoshiro256ss,
+ *        2^48 for the others) : the engines e, e.jump(), e.jump().jump()...
+ *        are non overlapping streams, one per thread. xoshiro256ss also
+ *        has long_jump() (2^192 steps).
+ *
+ *        fill_bits() and fill_uniform() produce whole arrays. With AVX2, the
+ *        xoshiro256ss bulk fills run 8 jumped engines side by side, one per
+ *        64 bits lane of two registers : the values are not the ones of n
+ *        successive calls, but they come from non overlapping streams.
+ *        fill_uniform() maps 32 bits per value when the range allows it,
+ *        with Lemire's multiply-shift instead of a division.
+ *        parallel_fill_uniform() splits the array between 8 streams per
+ *        worker : for a given seed and pool size, the output is always the same.
+ *
+ * More infos here :
+ *   - https://prng.di.unimi.it/ (xoshiro256**, splitmix64)
+ *   - https://github.com/wangyi-fudan/wyhash (wyrand)
+ *   - https://www.pcg-random.org/ (pcg32)
+ *   - "Fast Random Integer Generation in an Interval", D. Lemire (2019)
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <work-stealing-pool.hpp>
+#include <parallel-algorithms.hpp>
+
+namespace fast_random {
+
+namespace detail {
+
+    using wide_t = unsigned __int128;
+
+    constexpr std::uint64_t rotl( std::uint64_t p_x, int p_k ) { return ( p_x << p_k ) | ( p_x >> ( 64 - p_k ) ); }
+
+    // Seeds the other engines from a single 64 bits value
+    constexpr std::uint64_t splitmix64( std::uint64_t& p_state )
+    {
+        std::uint64_t z = ( p_state += 0x9E3779B97F4A7C15ull );
+        z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+        z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+        return z ^ ( z >> 31 );
+    }
+
+    // 64 bits of seed out of a std::seed_seq like object
+    template <typename SeedSeq>
+    std::uint64_t seed_from( SeedSeq& p_seq )
+    {
+        std::array<std::uint32_t, 2> l_words;
+        p_seq.generate( std::begin(l_words), std::end(l_words) );
+        return ( std::uint64_t{ l_words[1] } << 32 ) | l_words[0];
+    }
+
+    // Keeps the seed sequence constructors away from the copies of Engine
+    template <typename SeedSeq, typename Engine>
+    using if_seed_seq = std::enable_if_t<!std::is_convertible_v<SeedSeq, std::uint64_t>
+                                         && !std::is_same_v<std::remove_cv_t<SeedSeq>, Engine>>;
+
+    template <typename URBG>
+    class bulk_bits;
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief xoshiro256ss
+ *        xoshiro256** : period 2^256 - 1, passes BigCrush.
+ */
+class xoshiro256ss
+{
+public:
+    using result_type = std::uint64_t;
+
+    explicit xoshiro256ss( std::uint64_t p_seed = 0 ) { seed( p_seed ); }
+    template <typename SeedSeq, typename = detail::if_seed_seq<SeedSeq, xoshiro256ss>>
+    explicit xoshiro256ss( SeedSeq& p_seq ) { seed( detail::seed_from( p_seq ) ); }
+
+    void seed( std::uint64_t p_seed ) {
+        for ( auto& l_word : m_s ) { l_word = detail::splitmix64( p_seed ); }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        const std::uint64_t l_res = detail::rotl( m_s[1] * 5, 7 ) * 9;
+        const std::uint64_t l_t   = m_s[1] << 17;
+
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= l_t;
+        m_s[3]  = detail::rotl( m_s[3], 45 );
+
+        return l_res;
+    }
+
+    void discard( unsigned long long p_count ) { while ( p_count-- ) { (*this)(); } }
+
+    /*!
+     * @brief Equivalent to 2^128 calls.
+     */
+    xoshiro256ss& jump() { return jump_by( { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                             0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull } ); }
+
+    /*!
+     * @brief Equivalent to 2^192 calls.
+     */
+    xoshiro256ss& long_jump() { return jump_by( { 0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull,
+                                                   0x77710069854EE241ull, 0x39109BB02ACBE635ull } ); }
+
+    bool operator==( const xoshiro256ss& o ) const { return m_s == o.m_s; }
+    bool operator!=( const xoshiro256ss& o ) const { return m_s != o.m_s; }
+
+private:
+    friend class detail::bulk_bits<xoshiro256ss>; // Reads the state to build its lanes
+
+    // Jump polynomial applied to the state
+    xoshiro256ss& jump_by( const std::array<std::uint64_t, 4>& p_poly )
+    {
+        std::array<std::uint64_t, 4> l_s{};
+        for ( const auto l_word : p_poly ) {
+            for ( int b = 0; b < 64; ++b ) {
+                if ( l_word & ( std::uint64_t{1} << b ) ) {
+                    for ( int i = 0; i < 4; ++i ) { l_s[i] ^= m_s[i]; }
+                }
+                (*this)();
+            }
+        }
+        m_s = l_s;
+        return *this;
+    }
+
+    std::array<std::uint64_t, 4> m_s;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief wyrand
+ *        Period 2^64, passes BigCrush and PractRand.
+ *        The n-th value only depends on the seed and n : discard() is O(1).
+ */
+class wyrand
+{
+public:
+    using result_type = std::uint64_t;
+
+    explicit wyrand( std::uint64_t p_seed = 0 ) : m_state( p_seed ) {}
+    template <typename SeedSeq, typename = detail::if_seed_seq<SeedSeq, wyrand>>
+    explicit wyrand( SeedSeq& p_seq ) : m_state( detail::seed_from( p_seq ) ) {}
+
+    void seed( std::uint64_t p_seed ) { m_state = p_seed; }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() { return mix( m_state += INCREMENT ); }
+
+    void    discard( unsigned long long p_count ) { m_state += p_count * INCREMENT; }
+    wyrand& jump   ()                             { discard( 1ull << 48 ); return *this; }
+
+    bool operator==( const wyrand& o ) const { return m_state == o.m_state; }
+    bool operator!=( const wyrand& o ) const { return m_state != o.m_state; }
+
+private:
+    static constexpr std::uint64_t INCREMENT { 0xA0761D6478BD642Full };
+
+    static result_type mix( std::uint64_t p_state ) {
+        const detail::wide_t l_prod = detail::wide_t{ p_state } * ( p_state ^ 0xE7037ED1A0B428DBull );
+        return static_cast<std::uint64_t>( l_prod >> 64 ) ^ static_cast<std::uint64_t>( l_prod );
+    }
+
+    std::uint64_t m_state;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief pcg32
+ *        PCG-XSH-RR : period 2^64, 2^63 selectable streams.
+ *        discard() is O(log n).
+ */
+class pcg32
+{
+public:
+    using result_type = std::uint32_t;
+
+    explicit pcg32( std::uint64_t p_seed = 0, std::uint64_t p_stream = 0 ) { seed( p_seed, p_stream ); }
+    template <typename SeedSeq, typename = detail::if_seed_seq<SeedSeq, pcg32>>
+    explicit pcg32( SeedSeq& p_seq ) { seed( detail::seed_from( p_seq ) ); }
+
+    void seed( std::uint64_t p_seed, std::uint64_t p_stream = 0 ) {
+        m_state = 0;
+        m_inc   = ( p_stream << 1 ) | 1;
+        step();
+        m_state += p_seed;
+        step();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        const std::uint64_t l_old = m_state;
+        step();
+        const auto l_xorshifted = static_cast<std::uint32_t>( ( ( l_old >> 18 ) ^ l_old ) >> 27 );
+        const auto l_rot        = static_cast<unsigned>( l_old >> 59 );
+        return ( l_xorshifted >> l_rot ) | ( l_xorshifted << ( ( 32 - l_rot ) & 31 ) );
+    }
+
+    /*!
+     * @brief Advances the LCG by p_count steps : s = a^n.s + c.(a^n - 1)/(a - 1),
+     *        computed by squaring.
+     */
+    void discard( unsigned long long p_count )
+    {
+        std::uint64_t l_mul = MULTIPLIER, l_add = m_inc;
+        std::uint64_t l_acc_mul = 1, l_acc_add = 0;
+        for ( ; p_count; p_count >>= 1 ) {
+            if ( p_count & 1 ) {
+                l_acc_mul *= l_mul;
+                l_acc_add  = l_acc_add * l_mul + l_add;
+            }
+            l_add *= l_mul + 1;
+            l_mul *= l_mul;
+        }
+        m_state = l_acc_mul * m_state + l_acc_add;
+    }
+    pcg32& jump() { discard( 1ull << 48 ); return *this; }
+
+    bool operator==( const pcg32& o ) const { return m_state == o.m_state && m_inc == o.m_inc; }
+    bool operator!=( const pcg32& o ) const { return !this->operator==(o); }
+
+private:
+    static constexpr std::uint64_t MULTIPLIER { 6364136223846793005ull };
+
+    void step() { m_state = m_state * MULTIPLIER + m_inc; }
+
+    std::uint64_t m_state;
+    std::uint64_t m_inc;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief 64 random bits from any UniformRandomBitGenerator
+ *        (the standard ones may output less bits per call).
+ */
+template <typename URBG>
+std::uint64_t next_bits( URBG& p_urbg )
+{
+    if constexpr ( URBG::min() == 0 && URBG::max() == std::numeric_limits<std::uint64_t>::max() ) {
+        return static_cast<std::uint64_t>( p_urbg() );
+    }
+    else if constexpr ( URBG::min() == 0 && URBG::max() == std::numeric_limits<std::uint32_t>::max() ) {
+        const std::uint64_t l_high = p_urbg();
+        return ( l_high << 32 ) | p_urbg();
+    }
+    else {
+        std::uniform_int_distribution<std::uint64_t> l_dist;
+        return l_dist( p_urbg );
+    }
+}
+
+namespace detail {
+
+    /*!
+     * @brief bulk_bits
+     *        Produces the random bits of a bulk fill of p_count values,
+     *        block after block.
+     */
+    template <typename URBG>
+    class bulk_bits
+    {
+    public:
+        bulk_bits( URBG& p_urbg, std::size_t ) : m_urbg( p_urbg ) {}
+
+        void operator()( std::uint64_t* p_first, std::uint64_t* p_last ) {
+            for ( ; p_first != p_last; ++p_first ) { *p_first = next_bits( m_urbg ); }
+        }
+
+    private:
+        URBG& m_urbg;
+    };
+
+#if defined(__AVX2__)
+    // xoshiro256ss : LANES engines (p_urbg jumped 0, 1... LANES - 1 times) run
+    // side by side, each word of their states in AVX2 registers (4 lanes each).
+    // p_urbg ends up jumped LANES times.
+    template <>
+    class bulk_bits<xoshiro256ss>
+    {
+    public:
+        static constexpr std::size_t LANES     { 8 };
+        static constexpr std::size_t MIN_COUNT { 1 << 14 }; // Amortizes the jumps
+
+        bulk_bits( xoshiro256ss& p_urbg, std::size_t p_count ) : m_urbg( p_urbg ), m_lanes( p_count >= MIN_COUNT )
+        {
+            if ( !m_lanes ) return;
+
+            alignas(32) std::uint64_t l_words[4][LANES];
+            for ( std::size_t l = 0; l < LANES; ++l ) {
+                for ( std::size_t w = 0; w < 4; ++w ) { l_words[w][l] = p_urbg.m_s[w]; }
+                p_urbg.jump();
+            }
+            for ( std::size_t w = 0; w < 4; ++w ) {
+                m_s[w][0] = _mm256_load_si256( reinterpret_cast<const __m256i*>( l_words[w] ) );
+                m_s[w][1] = _mm256_load_si256( reinterpret_cast<const __m256i*>( l_words[w] + 4 ) );
+            }
+        }
+
+        void operator()( std::uint64_t* p_first, std::uint64_t* p_last )
+        {
+            const std::size_t l_count = static_cast<std::size_t>( p_last - p_first );
+            std::size_t       i       = 0;
+            if ( m_lanes ) {
+                __m256i s0 = m_s[0][0], s1 = m_s[1][0], s2 = m_s[2][0], s3 = m_s[3][0];
+                __m256i u0 = m_s[0][1], u1 = m_s[1][1], u2 = m_s[2][1], u3 = m_s[3][1];
+                for ( ; i + LANES <= l_count; i += LANES ) {
+                    _mm256_storeu_si256( reinterpret_cast<__m256i*>( p_first + i     ), result( s1 ) );
+                    _mm256_storeu_si256( reinterpret_cast<__m256i*>( p_first + i + 4 ), result( u1 ) );
+                    step( s0, s1, s2, s3 );
+                    step( u0, u1, u2, u3 );
+                }
+                m_s[0][0] = s0; m_s[1][0] = s1; m_s[2][0] = s2; m_s[3][0] = s3;
+                m_s[0][1] = u0; m_s[1][1] = u1; m_s[2][1] = u2; m_s[3][1] = u3;
+            }
+            for ( ; i < l_count; ++i ) { p_first[i] = m_urbg(); }
+        }
+
+    private:
+        static __m256i rotl( __m256i p_x, int p_k ) {
+            return _mm256_or_si256( _mm256_slli_epi64( p_x, p_k ), _mm256_srli_epi64( p_x, 64 - p_k ) );
+        }
+
+        // rotl( s1 * 5, 7 ) * 9, without 64 bits multiplication (AVX-512 only)
+        static __m256i result( __m256i p_s1 ) {
+            const __m256i l_x5 = _mm256_add_epi64( p_s1, _mm256_slli_epi64( p_s1, 2 ) );
+            const __m256i l_r  = rotl( l_x5, 7 );
+            return _mm256_add_epi64( l_r, _mm256_slli_epi64( l_r, 3 ) );
+        }
+
+        static void step( __m256i& s0, __m256i& s1, __m256i& s2, __m256i& s3 ) {
+            const __m256i l_t = _mm256_slli_epi64( s1, 17 );
+            s2 = _mm256_xor_si256( s2, s0 );
+            s3 = _mm256_xor_si256( s3, s1 );
+            s1 = _mm256_xor_si256( s1, s2 );
+            s0 = _mm256_xor_si256( s0, s3 );
+            s2 = _mm256_xor_si256( s2, l_t );
+            s3 = rotl( s3, 45 );
+        }
+
+        xoshiro256ss& m_urbg;
+        const bool    m_lanes;
+        __m256i       m_s[4][2]; /*!< Word w of the lanes 0-3, then 4-7 */
+    };
+#endif // __AVX2__
+
+    // Moves p_urbg to the next independent stream of a parallel fill
+    template <typename URBG>
+    void next_stream( URBG& p_urbg ) { p_urbg.jump(); }
+    inline void next_stream( xoshiro256ss& p_urbg ) { p_urbg.long_jump(); } // jump() is used by the lanes
+
+} // namespace detail
+
+/*!
+ * @brief Fills [p_first, p_last[ with random bits.
+ */
+template <typename URBG>
+void fill_bits( URBG& p_urbg, std::uint64_t* p_first, std::uint64_t* p_last )
+{
+    detail::bulk_bits<URBG>( p_urbg, static_cast<std::size_t>( p_last - p_first ) )( p_first, p_last );
+}
+
+namespace detail {
+
+    // Values are produced from blocks of bits small enough to stay in L1
+    constexpr std::size_t FILL_BLOCK { 1 << 10 };
+
+    /*!
+     * @brief Lemire's multiply-shift : maps p_bits to [0, p_range[ without
+     *        division, rejecting (rarely) the values that would bias the result.
+     */
+    template <typename URBG>
+    std::uint64_t bounded( std::uint64_t p_bits, std::uint64_t p_range, URBG& p_urbg )
+    {
+        wide_t        l_prod = wide_t{ p_bits } * p_range;
+        std::uint64_t l_low  = static_cast<std::uint64_t>( l_prod );
+        if ( l_low < p_range ) {
+            const std::uint64_t l_threshold = ( 0 - p_range ) % p_range;
+            while ( l_low < l_threshold ) {
+                l_prod = wide_t{ next_bits( p_urbg ) } * p_range;
+                l_low  = static_cast<std::uint64_t>( l_prod );
+            }
+        }
+        return static_cast<std::uint64_t>( l_prod >> 64 );
+    }
+
+    /*!
+     * @brief Same on 32 bits, two values out of each word of p_bits :
+     *        the multiplications of the first loop vectorize, the rare
+     *        rejected values are drawn again in a second loop.
+     */
+    template <typename T, typename U, typename URBG>
+    void bounded32( T* p_out, std::size_t p_count, const std::uint64_t* p_bits,
+                    U p_min, std::uint32_t p_range, URBG& p_urbg )
+    {
+        auto l_word = [p_bits]( std::size_t i ) { return static_cast<std::uint32_t>( p_bits[i / 2] >> ( 32 * ( i & 1 ) ) ); };
+
+        auto l_map  = [p_min, p_range]( std::uint32_t p_x ) {
+            return static_cast<T>( static_cast<U>( p_min + ( ( std::uint64_t{ p_x } * p_range ) >> 32 ) ) );
+        };
+        for ( std::size_t j = 0; j < p_count / 2; ++j ) {
+            p_out[2 * j]     = l_map( static_cast<std::uint32_t>( p_bits[j] ) );
+            p_out[2 * j + 1] = l_map( static_cast<std::uint32_t>( p_bits[j] >> 32 ) );
+        }
+        if ( p_count & 1 ) { p_out[p_count - 1] = l_map( l_word( p_count - 1 ) ); }
+
+        const std::uint32_t l_threshold = ( 0u - p_range ) % p_range; // 2^32 mod p_range
+        if ( !l_threshold ) return;
+        for ( std::size_t i = 0; i < p_count; ++i ) {
+            std::uint64_t l_prod = std::uint64_t{ l_word( i ) } * p_range;
+            if ( static_cast<std::uint32_t>( l_prod ) >= l_threshold ) continue;
+            while ( static_cast<std::uint32_t>( l_prod ) < l_threshold ) {
+                l_prod = std::uint64_t{ static_cast<std::uint32_t>( next_bits( p_urbg ) ) } * p_range;
+            }
+            p_out[i] = static_cast<T>( static_cast<U>( p_min + ( l_prod >> 32 ) ) );
+        }
+    }
+
+} // namespace detail
+
+/*!
+ * @brief Fills [p_first, p_last[ with values uniformly distributed in
+ *        [p_min, p_max] (integers) or [p_min, p_max[ (floating points).
+ */
+template <typename URBG, typename T>
+void fill_uniform( URBG& p_urbg, T* p_first, T* p_last, T p_min, T p_max )
+{
+    static_assert( std::is_arithmetic_v<T> && sizeof(T) <= 8, "fill_uniform : integers or floating points" );
+
+    using unsigned_t = std::make_unsigned_t<std::conditional_t<std::is_integral_v<T>, T, int>>;
+
+    // Integers : ranges up to 2^32 - 1 take 32 bits per value (two values per word)
+    std::uint64_t l_range = 0;
+    unsigned_t    l_min   = 0;
+    if constexpr ( std::is_integral_v<T> ) {
+        l_min   = static_cast<unsigned_t>( p_min );
+        l_range = std::uint64_t{ static_cast<unsigned_t>( static_cast<unsigned_t>( p_max ) - l_min ) } + 1;
+        if ( l_range > std::numeric_limits<unsigned_t>::max() ) { l_range = 0; } // The whole type
+    }
+    const bool l_narrow = l_range && l_range <= std::numeric_limits<std::uint32_t>::max();
+
+    detail::bulk_bits<URBG> l_source( p_urbg, static_cast<std::size_t>( p_last - p_first ) / ( l_narrow ? 2 : 1 ) );
+    std::uint64_t           l_bits[detail::FILL_BLOCK];
+    while ( p_first != p_last ) {
+        const std::size_t l_count = std::min<std::size_t>( p_last - p_first, detail::FILL_BLOCK );
+        const std::size_t l_words = l_narrow ? ( l_count + 1 ) / 2 : l_count;
+        l_source( l_bits, l_bits + l_words );
+
+        if constexpr ( std::is_floating_point_v<T> ) {
+            // As many bits as the mantissa holds (24 for float, 53 for double) : the
+            // integer is exact in T. p_min + x can still round up to p_max : clamped.
+            constexpr int DIGITS { std::numeric_limits<T>::digits };
+            const T       l_scale = ( p_max - p_min ) * std::ldexp( T{1}, -DIGITS );
+            const T       l_below = p_max > p_min ? std::nextafter( p_max, p_min ) : p_min;
+            for ( std::size_t i = 0; i < l_count; ++i ) {
+                p_first[i] = std::min( l_below, p_min + static_cast<T>( l_bits[i] >> ( 64 - DIGITS ) ) * l_scale );
+            }
+        }
+        else if ( l_narrow ) {
+            detail::bounded32( p_first, l_count, l_bits, l_min, static_cast<std::uint32_t>( l_range ), p_urbg );
+        }
+        else if ( l_range ) {
+            for ( std::size_t i = 0; i < l_count; ++i ) {
+                p_first[i] = static_cast<T>( static_cast<unsigned_t>( l_min + detail::bounded( l_bits[i], l_range, p_urbg ) ) );
+            }
+        }
+        else {
+            for ( std::size_t i = 0; i < l_count; ++i ) { p_first[i] = static_cast<T>( l_bits[i] ); }
+        }
+        p_first += l_count;
+    }
+}
+
+/*!
+ * @brief Same as fill_uniform, split between 8 streams per worker of p_pool :
+ *        the stream i is Engine( p_seed ) jumped i times (long_jump() for
+ *        xoshiro256ss, whose bulk fills use jump()).
+ */
+template <typename Engine = xoshiro256ss, typename T>
+void parallel_fill_uniform( work_stealing_pool& p_pool, T* p_first, T* p_last, T p_min, T p_max, std::uint64_t p_seed )
+{
+    const std::ptrdiff_t l_count = p_last - p_first;
+    if ( l_count <= 0 ) return;
+
+    const std::ptrdiff_t l_streams = std::min<std::ptrdiff_t>( l_count, 8 * p_pool.size() );
+    const std::ptrdiff_t l_grain   = ( l_count + l_streams - 1 ) / l_streams;
+
+    std::vector<Engine> l_engines( 1, Engine( p_seed ) );
+    while ( static_cast<std::ptrdiff_t>( l_engines.size() ) < l_streams ) {
+        l_engines.push_back( l_engines.back() );
+        detail::next_stream( l_engines.back() );
+    }
+
+    pstl_lite::parallel_for( p_pool, std::ptrdiff_t{0}, l_streams, [&]( std::ptrdiff_t p_begin, std::ptrdiff_t p_end ) {
+        for ( std::ptrdiff_t s = p_begin; s < p_end; ++s ) {
+            fill_uniform( l_engines[s], p_first + std::min( l_count, s * l_grain ),
+                          p_first + std::min( l_count, ( s + 1 ) * l_grain ), p_min, p_max );
+        }
+    }, std::ptrdiff_t{1} );
+}
+
+} // namespace fast_random
+
+#endif // RANDOM_ENGINES_HPP
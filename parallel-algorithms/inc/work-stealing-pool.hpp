@@ -0,0 +1,569 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+/*!
+ * @brief A small fork/join thread pool where every worker owns a
+ *        Chase-Lev deque :
+ *          - the owner pushes and pops at the bottom (LIFO, cache friendly)
+ *          - idle workers steal from the top of a victim's deque (FIFO,
+ *            i.e. the biggest pieces of work first).
+ *
+ * More infos here :
+ *   - "Dynamic Circular Work-Stealing Deque", D. Chase and Y. Lev (2005)
+ *   - "Correct and Efficient Work-Stealing for Weak Memory Models",
+ *     N. M. Lê, A. Pop, A. Cohen and F. Zappa Nardelli (2013)
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Pins the calling thread to the p_index-th CPU it is allowed to
+ *        run on (modulo the number of such CPUs).
+ *        Returns false when pinning is not supported or failed.
+ */
+inline bool pin_current_thread( unsigned p_index )
+{
+#ifdef __linux__
+    cpu_set_t l_allowed;
+    CPU_ZERO( &l_allowed );
+    if ( sched_getaffinity( 0, sizeof(l_allowed), &l_allowed ) != 0 ) return false;
+
+    const int l_count = CPU_COUNT( &l_allowed );
+    if ( l_count == 0 ) return false;
+
+    int l_target = static_cast<int>( p_index % l_count );
+    for ( int cpu = 0; cpu < CPU_SETSIZE; ++cpu ) {
+        if ( CPU_ISSET( cpu, &l_allowed ) && l_target-- == 0 ) {
+            cpu_set_t l_set;
+            CPU_ZERO( &l_set );
+            CPU_SET( cpu, &l_set );
+            return pthread_setaffinity_np( pthread_self(), sizeof(l_set), &l_set ) == 0;
+        }
+    }
+    return false;
+#else
+    (void)p_index;
+    return false;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief chase_lev_deque
+ *        Single-owner / multiple-thieves deque.
+ *        Only the owner thread may call push() and pop(),
+ *        any thread may call steal().
+ *
+ * @note T has to be trivially copyable (we store pointers to tasks).
+ */
+template <typename T>
+class chase_lev_deque
+{
+private:
+    class ring
+    {
+    public:
+        explicit ring( std::int64_t p_capacity ) :
+            m_capacity( p_capacity ),
+            m_mask    ( p_capacity - 1 ),
+            m_buffer  ( new std::atomic<T>[p_capacity] )
+        {}
+
+        std::int64_t capacity() const { return m_capacity; }
+
+        T get( std::int64_t p_idx ) const {
+            return m_buffer[p_idx & m_mask].load( std::memory_order_relaxed );
+        }
+        void put( std::int64_t p_idx, T p_val ) {
+            m_buffer[p_idx & m_mask].store( p_val, std::memory_order_relaxed );
+        }
+
+        ring* grow( std::int64_t p_bottom, std::int64_t p_top ) const {
+            ring* l_res = new ring( 2 * m_capacity );
+            for ( std::int64_t i = p_top; i < p_bottom; ++i ) { l_res->put( i, get(i) ); }
+            return l_res;
+        }
+
+    private:
+        const std::int64_t                  m_capacity;
+        const std::int64_t                  m_mask;
+        std::unique_ptr<std::atomic<T>[]>   m_buffer;
+    };
+
+public:
+    explicit chase_lev_deque( std::int64_t p_capacity = 1024 ) :
+        m_top   ( 0 ),
+        m_bottom( 0 ),
+        m_ring  ( new ring( p_capacity ) )
+    {
+        m_garbage.emplace_back( m_ring.load( std::memory_order_relaxed ) );
+    }
+
+    chase_lev_deque( const chase_lev_deque& )            = delete;
+    chase_lev_deque& operator=( const chase_lev_deque& ) = delete;
+
+    bool empty() const {
+        return m_bottom.load( std::memory_order_relaxed ) <= m_top.load( std::memory_order_relaxed );
+    }
+
+    // Owner only
+    void push( T p_val ) {
+        const std::int64_t l_bottom = m_bottom.load( std::memory_order_relaxed );
+        const std::int64_t l_top    = m_top   .load( std::memory_order_acquire );
+        ring*              l_ring   = m_ring  .load( std::memory_order_relaxed );
+
+        if ( l_bottom - l_top > l_ring->capacity() - 1 ) {
+            // Thieves may still read the old ring : keep it alive
+            // until the deque itself is destroyed.
+            l_ring = l_ring->grow( l_bottom, l_top );
+            m_garbage.emplace_back( l_ring );
+            m_ring.store( l_ring, std::memory_order_release );
+        }
+
+        l_ring->put( l_bottom, p_val );
+        std::atomic_thread_fence( std::memory_order_release );
+        m_bottom.store( l_bottom + 1, std::memory_order_relaxed );
+    }
+
+    // Owner only
+    std::optional<T> pop() {
+        const std::int64_t l_bottom = m_bottom.load( std::memory_order_relaxed ) - 1;
+        ring*              l_ring   = m_ring  .load( std::memory_order_relaxed );
+        m_bottom.store( l_bottom, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        std::int64_t       l_top    = m_top.load( std::memory_order_relaxed );
+
+        if ( l_top > l_bottom ) {
+            // Empty deque
+            m_bottom.store( l_bottom + 1, std::memory_order_relaxed );
+            return std::nullopt;
+        }
+
+        std::optional<T> l_res{ l_ring->get( l_bottom ) };
+        if ( l_top == l_bottom ) {
+            // Last element : race against thieves
+            if ( !m_top.compare_exchange_strong( l_top, l_top + 1,
+                                                 std::memory_order_seq_cst,
+                                                 std::memory_order_relaxed ) ) {
+                l_res = std::nullopt;
+            }
+            m_bottom.store( l_bottom + 1, std::memory_order_relaxed );
+        }
+        return l_res;
+    }
+
+    // Any thread
+    std::optional<T> steal() {
+        std::int64_t       l_top    = m_top.load( std::memory_order_acquire );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        const std::int64_t l_bottom = m_bottom.load( std::memory_order_acquire );
+
+        if ( l_top >= l_bottom ) return std::nullopt;
+
+        ring* l_ring = m_ring.load( std::memory_order_acquire );
+        T     l_val  = l_ring->get( l_top );
+        if ( !m_top.compare_exchange_strong( l_top, l_top + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed ) ) {
+            return std::nullopt; // Lost the race
+        }
+        return l_val;
+    }
+
+private:
+    alignas(64) std::atomic<std::int64_t> m_top;
+    alignas(64) std::atomic<std::int64_t> m_bottom;
+    alignas(64) std::atomic<ring*>        m_ring;
+    std::vector<std::unique_ptr<ring>>    m_garbage;
+};
+
+class work_stealing_pool;
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief task_group
+ *        Fork/join handle : run() spawns a task into the pool,
+ *        wait() blocks until every spawned task is done.
+ *
+ * @note The waiting thread does not sleep, it executes pending
+ *       tasks meanwhile (which also makes nested groups deadlock-free).
+ *       The first exception thrown by a task is rethrown by wait().
+ */
+class task_group
+{
+public:
+    explicit task_group( work_stealing_pool& p_pool ) : m_pool( p_pool ) {}
+    ~task_group() { wait_no_throw(); }
+
+    task_group( const task_group& )            = delete;
+    task_group& operator=( const task_group& ) = delete;
+
+    template <typename Func>
+    void run( Func&& p_func );
+
+    /*!
+     * @brief Spawns a task that only the p_worker-th worker (modulo the
+     *        pool size) executes : it is never stolen (e.g. to touch memory
+     *        on the node of a pinned worker).
+     */
+    template <typename Func>
+    void run_on( unsigned p_worker, Func&& p_func );
+
+    void wait();
+
+private:
+    friend class work_stealing_pool;
+
+    void wait_no_throw();
+    void done( std::exception_ptr p_exc );
+
+    work_stealing_pool& m_pool;
+    std::atomic<std::size_t> m_pending{0};
+    std::mutex               m_exc_mutex;
+    std::exception_ptr       m_exc;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief work_stealing_pool
+ *        A fixed set of workers, each owning a chase_lev_deque.
+ *        Tasks spawned from a worker go to its own deque,
+ *        tasks spawned from outside go to a shared injection queue.
+ */
+class work_stealing_pool
+{
+private:
+    struct task {
+        std::function<void()> m_func;
+        task_group*           m_group;
+    };
+
+    struct counters {
+        std::atomic<std::size_t>   m_tasks  {0};
+        std::atomic<std::size_t>   m_steals {0};
+        std::atomic<std::uint64_t> m_busy_ns{0};
+    };
+
+    struct worker {
+        chase_lev_deque<task*>   m_deque;
+        counters                 m_counters;
+        std::mutex               m_mailbox_mutex;
+        std::deque<task*>        m_mailbox;     /*!< Tasks for this worker only */
+        std::atomic<std::size_t> m_mailed{0};
+    };
+
+public:
+    /*!
+     * @brief Activity of one thread since the last reset_stats().
+     */
+    struct thread_stats {
+        std::size_t              tasks;  /*!< Number of tasks executed       */
+        std::size_t              steals; /*!< Tasks taken from other workers */
+        std::chrono::nanoseconds busy;   /*!< Time spent executing tasks     */
+    };
+
+    /*!
+     * @param p_threads Number of workers.
+     * @param p_pin     Pin worker i to the i-th allowed CPU, so that the
+     *                  memory it touches first stays local to it (NUMA).
+     */
+    explicit work_stealing_pool( unsigned p_threads = std::thread::hardware_concurrency(),
+                                 bool     p_pin     = false ) :
+        m_pinned( p_pin )
+    {
+        if ( p_threads == 0 ) { p_threads = 1; }
+
+        m_workers.reserve( p_threads );
+        for ( unsigned i = 0; i < p_threads; ++i ) {
+            m_workers.emplace_back( std::make_unique<worker>() );
+        }
+        m_threads.reserve( p_threads );
+        for ( unsigned i = 0; i < p_threads; ++i ) {
+            m_threads.emplace_back( [this, i] {
+                if ( m_pinned ) { pin_current_thread( i ); }
+                worker_loop(i);
+            });
+        }
+    }
+
+    ~work_stealing_pool()
+    {
+        {
+            std::lock_guard<std::mutex> l_lock( m_sleep_mutex );
+            m_stop = true;
+        }
+        m_sleep_cv.notify_all();
+        for ( auto& t : m_threads ) { t.join(); }
+    }
+
+    work_stealing_pool( const work_stealing_pool& )            = delete;
+    work_stealing_pool& operator=( const work_stealing_pool& ) = delete;
+
+    unsigned size  () const { return static_cast<unsigned>( m_workers.size() ); }
+    bool     pinned() const { return m_pinned; }
+
+    /*!
+     * @brief Per-worker activity (one entry per worker), followed by
+     *        the activity of external threads helping in task_group::wait().
+     */
+    std::vector<thread_stats> stats() const
+    {
+        std::vector<thread_stats> l_res;
+        auto l_read = []( const counters& c ) {
+            return thread_stats{ c.m_tasks  .load( std::memory_order_relaxed ),
+                                 c.m_steals .load( std::memory_order_relaxed ),
+                                 std::chrono::nanoseconds( c.m_busy_ns.load( std::memory_order_relaxed ) ) };
+        };
+        for ( const auto& w : m_workers ) { l_res.push_back( l_read( w->m_counters ) ); }
+        l_res.push_back( l_read( m_external ) );
+        return l_res;
+    }
+
+    void reset_stats()
+    {
+        auto l_reset = []( counters& c ) {
+            c.m_tasks  .store( 0, std::memory_order_relaxed );
+            c.m_steals .store( 0, std::memory_order_relaxed );
+            c.m_busy_ns.store( 0, std::memory_order_relaxed );
+        };
+        for ( auto& w : m_workers ) { l_reset( w->m_counters ); }
+        l_reset( m_external );
+    }
+
+    /*!
+     * @brief Index of the calling thread among the workers
+     *        of this pool, or -1 for an external thread.
+     */
+    int current_worker() const { return s_pool == this ? s_index : -1; }
+
+private:
+    friend class task_group;
+
+    void spawn( task* p_task )
+    {
+        if ( s_pool == this ) {
+            m_workers[s_index]->m_deque.push( p_task );
+        }
+        else {
+            std::lock_guard<std::mutex> l_lock( m_inject_mutex );
+            m_inject.push_back( p_task );
+        }
+
+        m_queued.fetch_add( 1, std::memory_order_seq_cst );
+        if ( m_sleepers.load( std::memory_order_seq_cst ) > 0 ) {
+            std::lock_guard<std::mutex> l_lock( m_sleep_mutex );
+            m_sleep_cv.notify_one();
+        }
+    }
+
+    void spawn_on( unsigned p_worker, task* p_task )
+    {
+        worker& l_worker = *m_workers[p_worker % m_workers.size()];
+        {
+            std::lock_guard<std::mutex> l_lock( l_worker.m_mailbox_mutex );
+            l_worker.m_mailbox.push_back( p_task );
+        }
+        l_worker.m_mailed.fetch_add( 1, std::memory_order_seq_cst );
+
+        // Only one worker can take it : wake them all, not any one
+        m_queued.fetch_add( 1, std::memory_order_seq_cst );
+        if ( m_sleepers.load( std::memory_order_seq_cst ) > 0 ) {
+            std::lock_guard<std::mutex> l_lock( m_sleep_mutex );
+            m_sleep_cv.notify_all();
+        }
+    }
+
+    task* take_task( bool& p_stolen )
+    {
+        p_stolen = false;
+        std::optional<task*> l_task;
+        const int            l_self = current_worker();
+
+        // 0 - Own mailbox
+        if ( l_self >= 0 && m_workers[l_self]->m_mailed.load( std::memory_order_seq_cst ) > 0 ) {
+            worker&                     l_worker = *m_workers[l_self];
+            std::lock_guard<std::mutex> l_lock( l_worker.m_mailbox_mutex );
+            if ( !l_worker.m_mailbox.empty() ) {
+                l_task = l_worker.m_mailbox.front();
+                l_worker.m_mailbox.pop_front();
+                l_worker.m_mailed.fetch_sub( 1, std::memory_order_relaxed );
+            }
+        }
+
+        // 1 - Own deque (newest task first)
+        if ( l_self >= 0 && !l_task ) {
+            l_task = m_workers[l_self]->m_deque.pop();
+        }
+
+        // 2 - Injection queue
+        if ( !l_task ) {
+            std::lock_guard<std::mutex> l_lock( m_inject_mutex );
+            if ( !m_inject.empty() ) {
+                l_task = m_inject.front();
+                m_inject.pop_front();
+            }
+        }
+
+        // 3 - Steal from a random victim (oldest task first)
+        if ( !l_task ) {
+            thread_local std::minstd_rand l_rng{ std::random_device{}() };
+            const std::size_t l_nb    = m_workers.size();
+            const std::size_t l_start = l_rng() % l_nb;
+            for ( std::size_t i = 0; i < l_nb && !l_task; ++i ) {
+                const std::size_t l_victim = ( l_start + i ) % l_nb;
+                if ( static_cast<int>( l_victim ) != l_self ) {
+                    l_task   = m_workers[l_victim]->m_deque.steal();
+                    p_stolen = l_task.has_value();
+                }
+            }
+        }
+
+        if ( !l_task ) return nullptr;
+
+        m_queued.fetch_sub( 1, std::memory_order_relaxed );
+        return *l_task;
+    }
+
+    /*!
+     * @note The statistics are updated before the group is notified,
+     *       so they are complete once task_group::wait() returns.
+     */
+    static void execute( task* p_task, counters& p_counters, bool p_stolen )
+    {
+        const auto         l_start = std::chrono::steady_clock::now();
+        std::exception_ptr l_exc;
+        try                                 { p_task->m_func();                  }
+        catch (...)                         { l_exc = std::current_exception();  }
+
+        const auto l_busy = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - l_start ).count();
+        p_counters.m_tasks  .fetch_add( 1,        std::memory_order_relaxed );
+        p_counters.m_steals .fetch_add( p_stolen, std::memory_order_relaxed );
+        p_counters.m_busy_ns.fetch_add( l_busy,   std::memory_order_relaxed );
+
+        task_group* l_group = p_task->m_group;
+        delete p_task;
+        l_group->done( l_exc );
+    }
+
+    // Used by waiting threads to help instead of blocking
+    bool try_execute_one()
+    {
+        bool  l_stolen;
+        task* l_task = take_task( l_stolen );
+        if ( !l_task ) return false;
+
+        const int l_self = current_worker();
+        execute( l_task, l_self >= 0 ? m_workers[l_self]->m_counters : m_external, l_stolen );
+        return true;
+    }
+
+    void worker_loop( unsigned p_index )
+    {
+        s_pool  = this;
+        s_index = static_cast<int>( p_index );
+
+        constexpr int SPINS { 64 };
+        int           l_idle{ 0 };
+
+        while ( true ) {
+            if ( try_execute_one() ) { l_idle = 0; continue; }
+
+            if ( ++l_idle < SPINS ) { std::this_thread::yield(); continue; }
+
+            // Nothing to do for a while : go to sleep until something is spawned
+            std::unique_lock<std::mutex> l_lock( m_sleep_mutex );
+            m_sleepers.fetch_add( 1, std::memory_order_seq_cst );
+            m_sleep_cv.wait( l_lock, [this] {
+                return m_stop || m_queued.load( std::memory_order_seq_cst ) > 0;
+            });
+            m_sleepers.fetch_sub( 1, std::memory_order_seq_cst );
+            if ( m_stop ) break;
+            l_idle = 0;
+        }
+
+        s_pool  = nullptr;
+        s_index = -1;
+    }
+
+private:
+    const bool                           m_pinned;
+    std::vector<std::unique_ptr<worker>> m_workers;
+    std::vector<std::thread>             m_threads;
+    counters                             m_external;
+
+    std::mutex                           m_inject_mutex;
+    std::deque<task*>                    m_inject;
+
+    std::atomic<std::int64_t>            m_queued  {0};
+    std::atomic<int>                     m_sleepers{0};
+    std::mutex                           m_sleep_mutex;
+    std::condition_variable              m_sleep_cv;
+    bool                                 m_stop{false};
+
+    inline static thread_local work_stealing_pool* s_pool {nullptr};
+    inline static thread_local int                 s_index{-1};
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename Func>
+void task_group::run( Func&& p_func )
+{
+    m_pending.fetch_add( 1, std::memory_order_relaxed );
+    m_pool.spawn( new work_stealing_pool::task{ std::forward<Func>(p_func), this } );
+}
+
+template <typename Func>
+void task_group::run_on( unsigned p_worker, Func&& p_func )
+{
+    m_pending.fetch_add( 1, std::memory_order_relaxed );
+    m_pool.spawn_on( p_worker, new work_stealing_pool::task{ std::forward<Func>(p_func), this } );
+}
+
+inline void task_group::done( std::exception_ptr p_exc )
+{
+    if ( p_exc ) {
+        std::lock_guard<std::mutex> l_lock( m_exc_mutex );
+        if ( !m_exc ) { m_exc = p_exc; }
+    }
+    m_pending.fetch_sub( 1, std::memory_order_acq_rel );
+}
+
+inline void task_group::wait_no_throw()
+{
+    while ( m_pending.load( std::memory_order_acquire ) > 0 ) {
+        if ( !m_pool.try_execute_one() ) { std::this_thread::yield(); }
+    }
+}
+
+inline void task_group::wait()
+{
+    wait_no_throw();
+
+    std::exception_ptr l_exc;
+    {
+        std::lock_guard<std::mutex> l_lock( m_exc_mutex );
+        std::swap( l_exc, m_exc );
+    }
+    if ( l_exc ) { std::rethrow_exception( l_exc ); }
+}
+
+#endif // WORK_STEALING_POOL_HPP
@@ -0,0 +1,146 @@
+/************************************************************
+ *          Parallel two-way and k-way merge of runs        *
+ ************************************************************/
+
+/*!
+ * @brief We often end up with several already sorted vectors (e.g. the
+ *        results of each thread) that have to be merged. std::merge only
+ *        handles two runs and, without TBB, serially.
+ *
+ *        Here we compare (see inc/parallel-merge.hpp) :
+ *          - TWO-WAY : std::merge seq/par and pstl_lite::parallel_merge
+ *            (co-ranking split points)
+ *          - K-WAY   : pstl_lite::kway_merge (loser tree)
+ *        against simply concatenating the runs and sorting the result.
+ *
+ * Usage : merge-benchmark [elements] [threads]
+ */
+
+#include <algorithm>
+#include <execution>
+#include <vector>
+#include <iostream>
+#include <string>
+
+#include <time-measure.hpp>
+#include <work-stealing-pool.hpp>
+#include <parallel-algorithms.hpp>
+#include <parallel-merge.hpp>
+#include <random-data.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define ELEMENTS 1e7 // The default total number of elements in the runs
+
+using run_t = std::vector<double>;
+
+/*!
+ * @brief Creates p_nb sorted runs of random doubles
+ *        holding p_total elements overall.
+ */
+std::vector<run_t> createRuns( std::size_t p_nb, std::size_t p_total )
+{
+    std::vector<run_t> l_runs;
+    for ( std::size_t r = 0; r < p_nb; ++r ) {
+        l_runs.push_back( createDoubleVector( p_total / p_nb + ( r < p_total % p_nb ), r + 1 ) );
+        std::sort( std::begin(l_runs.back()), std::end(l_runs.back()) );
+    }
+    return l_runs;
+}
+
+std::vector<double> concatenate( const std::vector<run_t>& p_runs )
+{
+    std::vector<double> l_res;
+    for ( const auto& r : p_runs ) { l_res.insert( std::end(l_res), std::begin(r), std::end(r) ); }
+    return l_res;
+}
+
+void benchTwoWay( std::size_t p_total, work_stealing_pool& p_pool )
+{
+    std::cout << "\nTWO-WAY MERGE of 2 runs\n";
+
+    const auto          l_runs = createRuns( 2, p_total );
+    const auto&         l_a    = l_runs[0];
+    const auto&         l_b    = l_runs[1];
+    std::vector<double> l_ref( p_total ), l_out( p_total );
+
+    {
+        stopwatch myWatch("\tstd::merge seq");
+        std::merge( std::execution::seq, std::begin(l_a), std::end(l_a),
+                    std::begin(l_b), std::end(l_b), std::begin(l_ref) );
+    }
+    {
+        stopwatch myWatch("\tstd::merge par");
+        std::merge( std::execution::par, std::begin(l_a), std::end(l_a),
+                    std::begin(l_b), std::end(l_b), std::begin(l_out) );
+    }
+    {
+        std::fill( std::begin(l_out), std::end(l_out), 0.0 );
+        {
+            stopwatch myWatch("\tpstl_lite::parallel_merge");
+            pstl_lite::parallel_merge( p_pool, std::begin(l_a), std::end(l_a),
+                                       std::begin(l_b), std::end(l_b), std::begin(l_out) );
+        }
+        if ( l_out != l_ref ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+    {
+        stopwatch myWatch("\tconcatenate + std::sort par");
+        l_out = concatenate( l_runs );
+        std::sort( std::execution::par, std::begin(l_out), std::end(l_out) );
+    }
+}
+
+void benchKWay( std::size_t p_nb, std::size_t p_total, work_stealing_pool& p_pool )
+{
+    std::cout << "\nK-WAY MERGE of " << p_nb << " runs\n";
+
+    const auto          l_runs = createRuns( p_nb, p_total );
+    std::vector<double> l_ref, l_out( p_total );
+
+    {
+        stopwatch myWatch("\tconcatenate + std::sort seq");
+        l_ref = concatenate( l_runs );
+        std::sort( std::execution::seq, std::begin(l_ref), std::end(l_ref) );
+    }
+    {
+        stopwatch myWatch("\tconcatenate + std::sort par");
+        l_out = concatenate( l_runs );
+        std::sort( std::execution::par, std::begin(l_out), std::end(l_out) );
+    }
+    {
+        stopwatch myWatch("\tconcatenate + pstl_lite::parallel_sort");
+        l_out = concatenate( l_runs );
+        pstl_lite::parallel_sort( p_pool, std::begin(l_out), std::end(l_out) );
+    }
+    {
+        std::vector<std::pair<run_t::const_iterator, run_t::const_iterator>> l_ranges;
+        for ( const auto& r : l_runs ) { l_ranges.emplace_back( std::begin(r), std::end(r) ); }
+
+        std::fill( std::begin(l_out), std::end(l_out), 0.0 );
+        {
+            stopwatch myWatch("\tpstl_lite::kway_merge (loser tree)");
+            pstl_lite::kway_merge( l_ranges, std::begin(l_out) );
+        }
+        if ( l_out != l_ref ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_elements = argc > 1 ? static_cast<std::size_t>( std::stod( argv[1] ) )
+                                            : static_cast<std::size_t>( ELEMENTS );
+    const unsigned    l_threads  = argc > 2 ? std::stoul( argv[2] )
+                                            : std::thread::hardware_concurrency();
+
+    work_stealing_pool l_pool( l_threads );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nElements - " << l_elements
+              << "\nPool threads - "           << l_pool.size();
+    std::cout << "\n--------------------------------------------------\n";
+
+    benchTwoWay( l_elements, l_pool );
+    for ( std::size_t l_nb : { 4, 16, 64, 256 } ) { benchKWay( l_nb, l_elements, l_pool ); }
+
+    return EXIT_SUCCESS;
+}
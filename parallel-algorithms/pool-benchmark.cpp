@@ -0,0 +1,139 @@
+/************************************************************
+ *     Work-stealing thread pool vs std::execution policies *
+ ************************************************************/
+
+/*!
+ * @brief stl-algorithms-policies.cpp relies on std::execution::par.
+ *        With libstdc++, the parallel policies are implemented on top
+ *        of Intel TBB : without it (or without linking -ltbb), they
+ *        silently run sequentially.
+ *
+ *        Here we compare them with an in-tree work-stealing pool
+ *        (see inc/work-stealing-pool.hpp) and the parallel_for,
+ *        parallel_reduce and parallel_sort entry points built on it
+ *        (see inc/parallel-algorithms.hpp).
+ *
+ * Usage : pool-benchmark [elements] [threads]
+ */
+
+#include <algorithm>
+#include <execution>
+#include <vector>
+#include <iostream>
+#include <random>
+#include <numeric>
+#include <cmath>
+#include <string>
+
+#include <time-measure.hpp>
+#include <work-stealing-pool.hpp>
+#include <parallel-algorithms.hpp>
+#include <random-data.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define ELEMENTS 1e6 // The default number of elements in the vector
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_elements = argc > 1 ? std::stoull( argv[1] )
+                                            : static_cast<std::size_t>( ELEMENTS );
+    const unsigned    l_threads  = argc > 2 ? std::stoul( argv[2] )
+                                            : std::thread::hardware_concurrency();
+
+    work_stealing_pool l_pool( l_threads );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nElements - " << l_elements
+              << "\nPool threads - "           << l_pool.size();
+    std::cout << "\n--------------------------------------------------\n";
+
+    const auto          myRefVec = createDoubleVector( l_elements );
+    std::vector<double> myVec;
+
+    // ----- Sort ----- //
+    std::cout << "\nSORT\n";
+    {
+        myVec = myRefVec;
+        stopwatch myWatch("\tstd::sort seq");
+        std::sort( std::execution::seq, std::begin(myVec), std::end(myVec) );
+    }
+    const auto mySortedVec = myVec;
+    {
+        myVec = myRefVec;
+        stopwatch myWatch("\tstd::sort par");
+        std::sort( std::execution::par, std::begin(myVec), std::end(myVec) );
+    }
+    {
+        myVec = myRefVec;
+        stopwatch myWatch("\tstd::sort par_unseq");
+        std::sort( std::execution::par_unseq, std::begin(myVec), std::end(myVec) );
+    }
+    {
+        myVec = myRefVec;
+        {
+            stopwatch myWatch("\tpstl_lite::parallel_sort");
+            pstl_lite::parallel_sort( l_pool, std::begin(myVec), std::end(myVec) );
+        }
+        if ( myVec != mySortedVec ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+
+    // ----- Reduce ----- //
+    std::cout << "\nREDUCE\n";
+    double l_ref{0}, l_res{0};
+    {
+        stopwatch myWatch("\tstd::reduce seq");
+        l_ref = std::reduce( std::execution::seq, std::begin(myRefVec), std::end(myRefVec), 0.0 );
+    }
+    {
+        stopwatch myWatch("\tstd::reduce par");
+        l_res = std::reduce( std::execution::par, std::begin(myRefVec), std::end(myRefVec), 0.0 );
+    }
+    {
+        stopwatch myWatch("\tstd::reduce par_unseq");
+        l_res = std::reduce( std::execution::par_unseq, std::begin(myRefVec), std::end(myRefVec), 0.0 );
+    }
+    {
+        {
+            stopwatch myWatch("\tpstl_lite::parallel_reduce");
+            l_res = pstl_lite::parallel_reduce( l_pool, std::begin(myRefVec), std::end(myRefVec), 0.0 );
+        }
+        // Summation order differs : only compare up to rounding errors
+        if ( std::abs( l_res - l_ref ) > 1e-9 * std::abs( l_ref ) ) {
+            std::cout << "SOMETHING WENT WRONG!\n";
+        }
+    }
+
+    // ----- For each ----- //
+    std::cout << "\nFOR_EACH (sqrt of every element)\n";
+    auto l_work = []( double& v ) { v = std::sqrt( v ); };
+    {
+        myVec = myRefVec;
+        stopwatch myWatch("\tstd::for_each seq");
+        std::for_each( std::execution::seq, std::begin(myVec), std::end(myVec), l_work );
+    }
+    const auto myRootVec = myVec;
+    {
+        myVec = myRefVec;
+        stopwatch myWatch("\tstd::for_each par");
+        std::for_each( std::execution::par, std::begin(myVec), std::end(myVec), l_work );
+    }
+    {
+        myVec = myRefVec;
+        stopwatch myWatch("\tstd::for_each par_unseq");
+        std::for_each( std::execution::par_unseq, std::begin(myVec), std::end(myVec), l_work );
+    }
+    {
+        myVec = myRefVec;
+        {
+            stopwatch myWatch("\tpstl_lite::parallel_for");
+            pstl_lite::parallel_for( l_pool, std::size_t{0}, myVec.size(),
+                                     [&]( std::size_t p_begin, std::size_t p_end ) {
+                for ( std::size_t i = p_begin; i < p_end; ++i ) { l_work( myVec[i] ); }
+            });
+        }
+        if ( myVec != myRootVec ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,198 @@
+/************************************************************
+ *     Radix sort vs comparison sorts and execution policies *
+ ************************************************************/
+
+/*!
+ * @brief stl-algorithms-policies.cpp only compares comparison sorts.
+ *        For large numeric arrays, a LSD radix sort on the bit pattern
+ *        of the keys (see inc/radix-sort.hpp) does a fixed number of
+ *        linear passes instead of O(n.log(n)) comparisons.
+ *
+ *        For each key type (int32, int64, float, double) and each size
+ *        (1e3 to the given maximum, x10 each step), we compare :
+ *          - std::sort with std::execution::seq, par and par_unseq
+ *          - pstl_lite::parallel_sort (work-stealing quicksort)
+ *          - pstl_lite::radix_sort, sequential and parallel
+ *        and finally the sort of double keys carrying a payload.
+ *
+ * Usage : radix-benchmark [max elements] [threads]
+ *
+ * NB : 1e9 double elements need 8 GB for the data, plus as much
+ *      for the radix sort buffer and for the reference copy.
+ */
+
+#include <algorithm>
+#include <execution>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <numeric>
+#include <string>
+#include <cstdint>
+
+#include <time-measure.hpp>
+#include <work-stealing-pool.hpp>
+#include <parallel-algorithms.hpp>
+#include <radix-sort.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define MIN_ELEMENTS 1e3 // The smallest benchmarked size
+#define MAX_ELEMENTS 1e7 // The default biggest benchmarked size
+#define MIN_WORK     1e7 // Small sizes are repeated to sort at least that many elements
+
+/*!
+ * @brief Creates a vector of size p_size filled with random
+ *        values (covering negative and positive values).
+ */
+template <typename T>
+std::vector<T> createVector( std::size_t p_size )
+{
+    std::default_random_engine random_engine;
+    std::vector<T>             myVec( p_size );
+
+    if constexpr ( std::is_floating_point_v<T> ) {
+        std::uniform_real_distribution<T> distrib( -100, 100 );
+        for ( auto& v : myVec ) { v = distrib(random_engine); }
+    }
+    else {
+        std::uniform_int_distribution<T> distrib( std::numeric_limits<T>::min(),
+                                                  std::numeric_limits<T>::max() );
+        for ( auto& v : myVec ) { v = distrib(random_engine); }
+    }
+
+    return myVec;
+}
+
+/*!
+ * @brief Average time (in us) of p_sort over the copies of p_ref.
+ *        Checks the result against p_expected.
+ */
+template <typename T, typename Sort>
+double benchSort( const std::vector<T>& p_ref, const std::vector<T>& p_expected, Sort&& p_sort )
+{
+    const std::size_t l_reps = std::max<std::size_t>( 1, MIN_WORK / p_ref.size() );
+    std::vector<T>    l_vec;
+    double            l_total{0};
+
+    for ( std::size_t r = 0; r < l_reps; ++r ) {
+        l_vec = p_ref;
+        l_total += measure( [&] { p_sort( l_vec ); } );
+    }
+    if ( l_vec != p_expected ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+
+    return l_total / l_reps;
+}
+
+template <typename T>
+void benchType( const std::string& p_name, std::size_t p_max, work_stealing_pool& p_pool )
+{
+    std::cout << "\n" << p_name << " keys (average time in us)\n";
+    std::cout << std::setw(12) << "elements"
+              << std::setw(12) << "seq"
+              << std::setw(12) << "par"
+              << std::setw(12) << "par_unseq"
+              << std::setw(12) << "pool sort"
+              << std::setw(12) << "radix"
+              << std::setw(12) << "pool radix" << "\n";
+
+    for ( std::size_t l_size = MIN_ELEMENTS; l_size <= p_max; l_size *= 10 )
+    {
+        const auto myRefVec = createVector<T>( l_size );
+        auto       mySorted = myRefVec;
+        std::sort( std::begin(mySorted), std::end(mySorted) );
+
+        std::cout << std::setw(12) << l_size << std::fixed << std::setprecision(0);
+        std::cout << std::setw(12) << benchSort( myRefVec, mySorted, []( auto& v ) {
+            std::sort( std::execution::seq, std::begin(v), std::end(v) );
+        });
+        std::cout << std::setw(12) << benchSort( myRefVec, mySorted, []( auto& v ) {
+            std::sort( std::execution::par, std::begin(v), std::end(v) );
+        });
+        std::cout << std::setw(12) << benchSort( myRefVec, mySorted, []( auto& v ) {
+            std::sort( std::execution::par_unseq, std::begin(v), std::end(v) );
+        });
+        std::cout << std::setw(12) << benchSort( myRefVec, mySorted, [&]( auto& v ) {
+            pstl_lite::parallel_sort( p_pool, std::begin(v), std::end(v) );
+        });
+        std::cout << std::setw(12) << benchSort( myRefVec, mySorted, []( auto& v ) {
+            pstl_lite::radix_sort( std::begin(v), std::end(v) );
+        });
+        std::cout << std::setw(12) << benchSort( myRefVec, mySorted, [&]( auto& v ) {
+            pstl_lite::radix_sort( p_pool, std::begin(v), std::end(v) );
+        });
+        std::cout << "\n";
+    }
+}
+
+/*!
+ * @brief Sorting double keys along with their original index :
+ *        std::sort on pairs vs radix sort with payload permutation.
+ */
+void benchPayload( std::size_t p_size, work_stealing_pool& p_pool )
+{
+    std::cout << "\ndouble keys + uint32 payload over " << p_size << " elements\n";
+
+    const auto myKeys = createVector<double>( p_size );
+
+    std::vector<std::pair<double, std::uint32_t>> myPairs( p_size );
+    for ( std::size_t i = 0; i < p_size; ++i ) { myPairs[i] = { myKeys[i], static_cast<std::uint32_t>(i) }; }
+    {
+        stopwatch myWatch("\tstd::stable_sort par on pairs");
+        std::stable_sort( std::execution::par, std::begin(myPairs), std::end(myPairs),
+                          []( const auto& a, const auto& b ) { return a.first < b.first; } );
+    }
+
+    auto                       l_keys = myKeys;
+    std::vector<std::uint32_t> l_payload( p_size );
+    std::iota( std::begin(l_payload), std::end(l_payload), 0 );
+    {
+        stopwatch myWatch("\tpstl_lite::radix_sort pool with payload");
+        pstl_lite::radix_sort( p_pool, std::begin(l_keys), std::end(l_keys), std::begin(l_payload) );
+    }
+
+    // Both sorts are stable : the permutations must be the same
+    for ( std::size_t i = 0; i < p_size; ++i ) {
+        if ( myPairs[i].first != l_keys[i] || myPairs[i].second != l_payload[i] ) {
+            std::cout << "SOMETHING WENT WRONG!\n";
+            break;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_max     = argc > 1 ? static_cast<std::size_t>( std::stod( argv[1] ) )
+                                           : static_cast<std::size_t>( MAX_ELEMENTS );
+    const unsigned    l_threads = argc > 2 ? std::stoul( argv[2] )
+                                           : std::thread::hardware_concurrency();
+
+    work_stealing_pool l_pool( l_threads );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nElements - " << static_cast<std::size_t>( MIN_ELEMENTS )
+              << " to "                        << l_max
+              << "\nPool threads - "           << l_pool.size();
+    std::cout << "\n--------------------------------------------------\n";
+
+    benchType<std::int32_t>( "int32",  l_max, l_pool );
+    benchType<std::int64_t>( "int64",  l_max, l_pool );
+    benchType<float>       ( "float",  l_max, l_pool );
+    benchType<double>      ( "double", l_max, l_pool );
+
+    benchPayload( l_max, l_pool );
+
+    // Empty ranges must not be dereferenced
+    {
+        std::vector<double>        l_keys;
+        std::vector<std::uint32_t> l_payload;
+        pstl_lite::radix_sort( std::begin(l_keys), std::end(l_keys) );
+        pstl_lite::radix_sort( std::begin(l_keys), std::end(l_keys), std::begin(l_payload) );
+        pstl_lite::radix_sort( l_pool, std::begin(l_keys), std::end(l_keys) );
+        pstl_lite::radix_sort( l_pool, std::begin(l_keys), std::end(l_keys), std::begin(l_payload) );
+        if ( !l_keys.empty() ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+/************************************************************
+ *      Random engines for large data sets generation       *
+ ************************************************************/
+
+/*!
+ * @brief createIntVector() (string_conversion.cpp) fills its vector with
+ *        std::default_random_engine and std::uniform_int_distribution,
+ *        std-sample.cpp uses std::mt19937 : for large data sets, the
+ *        generation shows in the profiles.
+ *        We fill a vector of ints in [0, INT_MAX] (see inc/random-engines.hpp) :
+ *          - one call per value with the std engines and std::uniform_int_distribution
+ *          - same with xoshiro256ss, wyrand and pcg32
+ *          - fast_random::fill_uniform (bulk, Lemire's bounded integers)
+ *          - fast_random::parallel_fill_uniform (one stream per chunk)
+ *
+ *        The floating point fills are checked to stay below their maximum.
+ *
+ * Usage : random-benchmark [elements] [max threads]
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <time-measure.hpp>
+#include <work-stealing-pool.hpp>
+#include <random-engines.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define ELEMENTS 1e8 // Default number of generated values
+
+/*!
+ * @brief Fills p_vec as createIntVector() does, with the engine URBG.
+ */
+template <typename URBG>
+void fillOneByOne( std::vector<int>& p_vec )
+{
+    std::uniform_int_distribution<int> distrib( 0, INT_MAX );
+    URBG                               random_engine;
+
+    for ( auto& v : p_vec ) { v = distrib(random_engine); }
+}
+
+/*!
+ * @brief Checks that the values are in [0, INT_MAX] and that their mean is
+ *        close to INT_MAX / 2 (std dev of the mean : 0.29 / sqrt(n)).
+ */
+void check( const std::vector<int>& p_vec )
+{
+    const double l_mean = std::accumulate( std::begin(p_vec), std::end(p_vec), 0.0 ) / p_vec.size() / INT_MAX;
+    if ( std::any_of( std::begin(p_vec), std::end(p_vec), []( int v ) { return v < 0; } )
+         || ( p_vec.size() >= 1000 && std::abs( l_mean - 0.5 ) > 0.05 ) ) {
+        std::cout << "SOMETHING WENT WRONG!\n";
+    }
+}
+
+/*!
+ * @brief Engine returning only ones : the largest value of each fill_uniform.
+ */
+struct ones_engine {
+    using result_type = std::uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type{0}; }
+    result_type operator()() { return max(); }
+};
+
+/*!
+ * @brief Floating points must be in [p_min, p_max[, p_max excluded even
+ *        when the random bits are all ones.
+ */
+template <typename T>
+bool checkFloating( T p_min, T p_max )
+{
+    std::vector<T> l_vec( 1 << 16 );
+    auto l_in_range = [&] {
+        return std::all_of( std::begin(l_vec), std::end(l_vec), [&]( T v ) { return v >= p_min && v < p_max; } );
+    };
+
+    fast_random::xoshiro256ss l_engine;
+    fast_random::fill_uniform( l_engine, l_vec.data(), l_vec.data() + l_vec.size(), p_min, p_max );
+    const bool l_ok = l_in_range();
+
+    ones_engine l_ones;
+    fast_random::fill_uniform( l_ones, l_vec.data(), l_vec.data() + l_vec.size(), p_min, p_max );
+    return l_ok && l_in_range();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const size_t   l_size    = argc > 1 ? static_cast<size_t>( std::stod( argv[1] ) ) : static_cast<size_t>( ELEMENTS );
+    const unsigned l_threads = argc > 2 ? static_cast<unsigned>( std::stoul( argv[2] ) )
+                                        : std::max( 1u, std::thread::hardware_concurrency() );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nElements - " << l_size << "\nThreads  - " << l_threads;
+    std::cout << "\n--------------------------------------------------\n";
+
+    std::vector<int>   myVec( l_size );
+    work_stealing_pool myPool( l_threads );
+
+    std::cout << "\n" << std::setw(34) << "method" << std::setw(12) << "time (ms)" << std::setw(14) << "Mvalues/s" << "\n";
+    auto bench = [&]( const char* p_name, auto&& p_fill ) {
+        std::fill( std::begin(myVec), std::end(myVec), -1 );
+        const auto l_time = measure<std::chrono::milliseconds>( p_fill );
+        std::cout << std::setw(34) << p_name << std::setw(12) << l_time << std::setw(14) << std::setprecision(4)
+                  << l_size / ( std::max<double>( 1, l_time ) * 1e3 ) << "\n";
+        check( myVec );
+    };
+
+    using namespace fast_random;
+
+    // One call per value, through std::uniform_int_distribution
+    bench( "std::default_random_engine",   [&] { fillOneByOne<std::default_random_engine>( myVec ); } );
+    bench( "std::mt19937",                 [&] { fillOneByOne<std::mt19937>             ( myVec ); } );
+    bench( "std::mt19937_64",              [&] { fillOneByOne<std::mt19937_64>          ( myVec ); } );
+    bench( "xoshiro256ss",                 [&] { fillOneByOne<xoshiro256ss>             ( myVec ); } );
+    bench( "wyrand",                       [&] { fillOneByOne<wyrand>                   ( myVec ); } );
+    bench( "pcg32",                        [&] { fillOneByOne<pcg32>                    ( myVec ); } );
+
+    // Whole array at once
+    auto fill = [&]( auto p_engine ) { fill_uniform( p_engine, myVec.data(), myVec.data() + myVec.size(), 0, INT_MAX ); };
+    bench( "fill_uniform std::mt19937_64",  [&] { fill( std::mt19937_64{} ); } );
+    bench( "fill_uniform xoshiro256ss",     [&] { fill( xoshiro256ss{} );    } );
+    bench( "fill_uniform wyrand",           [&] { fill( wyrand{} );          } );
+    bench( "fill_uniform pcg32",            [&] { fill( pcg32{} );           } );
+
+    // Whole array, one stream per chunk
+    auto parallel_fill = [&]( auto p_engine ) {
+        parallel_fill_uniform<decltype(p_engine)>( myPool, myVec.data(), myVec.data() + myVec.size(), 0, INT_MAX, 42 );
+    };
+    bench( "parallel_fill_uniform xoshiro256ss", [&] { parallel_fill( xoshiro256ss{} ); } );
+    bench( "parallel_fill_uniform wyrand",       [&] { parallel_fill( wyrand{} );       } );
+
+    if ( !checkFloating( 0.0f, 1.0f ) || !checkFloating( 1.0f, 2.0f ) || !checkFloating( -1.0, 1.0 ) ) {
+        std::cout << "SOMETHING WENT WRONG!\n";
+    }
+
+    return EXIT_SUCCESS;
+}
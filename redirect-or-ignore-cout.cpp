@@ -4,23 +4,10 @@
  ************************************************************/
 
 #include <iostream>
-#include <fstream>
-#include <ios>
 #include <string>
 
-class cout_redirect {
-    public:
-        explicit cout_redirect( const std::string& p_fileName = ""):
-            m_ofs{p_fileName},
-            m_backup{ std::cout.rdbuf( m_ofs.rdbuf() ) }
-        {}
-
-        ~cout_redirect() { std::cout.rdbuf( m_backup ); }
-
-    private:
-        std::ofstream   m_ofs;
-        std::streambuf* m_backup;
-};
+// The cout_redirect class, shared with the benchmarks of cout-redirect/
+#include "cout-redirect/inc/cout-redirect.hpp"
 
 
 int main()
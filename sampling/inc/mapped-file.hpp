@@ -0,0 +1,139 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+/*!
+ * @brief mapped_file
+ *        Read-only memory mapping of a whole file (POSIX mmap) : the file
+ *        is read by the OS page by page while it is accessed, without any
+ *        copy into a user buffer. It can be bigger than the memory.
+ *
+ *        line_iterator walks over its lines (as std::string_view), looking
+ *        for the end of lines with memchr.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sampling {
+
+class mapped_file
+{
+public:
+    /*!
+     * @brief Maps p_path, returns std::nullopt if it cannot be opened.
+     */
+    static std::optional<mapped_file> open( const std::string& p_path )
+    {
+        const int l_fd = ::open( p_path.c_str(), O_RDONLY );
+        if ( l_fd < 0 ) return std::nullopt;
+
+        struct stat l_stat;
+        if ( ::fstat( l_fd, &l_stat ) != 0 ) { ::close( l_fd ); return std::nullopt; }
+
+        mapped_file l_file;
+        l_file.m_size = static_cast<std::size_t>( l_stat.st_size );
+        if ( l_file.m_size ) {
+            void* l_data = ::mmap( nullptr, l_file.m_size, PROT_READ, MAP_PRIVATE, l_fd, 0 );
+            if ( l_data == MAP_FAILED ) { ::close( l_fd ); return std::nullopt; }
+            ::madvise( l_data, l_file.m_size, MADV_SEQUENTIAL ); // Read ahead aggressively
+            l_file.m_data = static_cast<const char*>( l_data );
+        }
+        ::close( l_fd ); // The mapping stays valid
+
+        return l_file;
+    }
+
+    mapped_file( const mapped_file& )            = delete;
+    mapped_file& operator=( const mapped_file& ) = delete;
+    mapped_file( mapped_file&& p_other ) noexcept :
+        m_data( std::exchange( p_other.m_data, nullptr ) ),
+        m_size( std::exchange( p_other.m_size, 0 ) )
+    {}
+    mapped_file& operator=( mapped_file&& p_other ) noexcept {
+        std::swap( m_data, p_other.m_data );
+        std::swap( m_size, p_other.m_size );
+        return *this;
+    }
+    ~mapped_file() { if ( m_data ) { ::munmap( const_cast<char*>( m_data ), m_size ); } }
+
+    const char*      data() const { return m_data; }
+    std::size_t      size() const { return m_size; }
+    std::string_view view() const { return { m_data, m_size }; }
+
+private:
+    mapped_file() = default;
+
+    const char* m_data { nullptr };
+    std::size_t m_size { 0 };
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief line_iterator
+ *        Forward iterator over the lines of a buffer (without their '\n').
+ *        A last line without '\n' is still a line.
+ */
+class line_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::string_view;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const std::string_view*;
+    using reference         = const std::string_view&;
+
+    line_iterator() = default;
+    explicit line_iterator( std::string_view p_buffer ) :
+        m_next( p_buffer.data() ),
+        m_end ( p_buffer.data() + p_buffer.size() )
+    {
+        ++(*this);
+    }
+
+    reference operator* () const { return m_line; }
+    pointer   operator->() const { return &m_line; }
+
+    line_iterator& operator++() {
+        if ( m_next == m_end ) { m_next = nullptr; return *this; } // Past the last line : end
+
+        const char* l_eol = static_cast<const char*>( std::memchr( m_next, '\n', m_end - m_next ) );
+        if ( !l_eol ) { l_eol = m_end; }
+        m_line = { m_next, static_cast<std::size_t>( l_eol - m_next ) };
+        m_next = l_eol == m_end ? m_end : l_eol + 1;
+        return *this;
+    }
+    line_iterator operator++(int) { line_iterator tmp{*this}; ++(*this); return tmp; }
+
+    // The start of the next line identifies the position (nullptr : end)
+    bool operator==( const line_iterator& o ) const { return m_next == o.m_next; }
+    bool operator!=( const line_iterator& o ) const { return !this->operator==(o); }
+
+private:
+    const char*      m_next { nullptr }; /*!< Start of the next line, nullptr at the end */
+    const char*      m_end  { nullptr };
+    std::string_view m_line;
+};
+
+/*!
+ * @brief The lines of p_buffer, for range-based for loops and algorithms.
+ */
+struct lines {
+    std::string_view buffer;
+
+    line_iterator begin() const { return line_iterator( buffer ); }
+    line_iterator end  () const { return line_iterator(); }
+};
+
+} // namespace sampling
+
+#endif // MAPPED_FILE_HPP
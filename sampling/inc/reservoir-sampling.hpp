@@ -0,0 +1,161 @@
+#ifndef RESERVOIR_SAMPLING_HPP
+#define RESERVOIR_SAMPLING_HPP
+
+/*!
+ * @brief std::sample needs forward iterators (or a random access output)
+ *        and the size of the population. Reservoir sampling draws k
+ *        elements uniformly in a single pass over a stream of unknown
+ *        length, keeping only the k current candidates in memory.
+ *
+ *        Algorithm R replaces a random candidate with the probability
+ *        k / (i + 1) : one random number per element. Algorithm L draws
+ *        instead how many elements to skip before the next replacement
+ *        (geometric distribution) : O(k.(1 + log(n / k))) random numbers,
+ *        and the skipped elements are never copied.
+ *
+ *        The order of the sample is not preserved (as std::sample with
+ *        input iterators).
+ *
+ * More infos here :
+ *   - "Reservoir-Sampling Algorithms of Time Complexity O(n(1 + log(N/n)))",
+ *     K.-H. Li, ACM Transactions on Mathematical Software (1994)
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sampling {
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief reservoir
+ *        Push based Algorithm L : every element of the stream goes through
+ *        offer(), which tells whether it must be kept. When it returns false,
+ *        the caller does not even have to build the element.
+ *        skip() tells how many upcoming elements will be refused, so that
+ *        they can be jumped over all at once.
+ */
+template <typename T, typename URBG>
+class reservoir
+{
+public:
+    reservoir( std::size_t p_k, URBG& p_urbg ) : m_k( p_k ), m_urbg( p_urbg ) { m_sample.reserve( p_k ); }
+
+    /*!
+     * @brief Number of upcoming elements that will not be kept.
+     */
+    std::size_t skip() const { return m_next - m_seen; }
+
+    /*!
+     * @brief Acknowledges p_count refused elements (p_count <= skip()).
+     */
+    void skipped( std::size_t p_count ) { m_seen += p_count; }
+
+    /*!
+     * @brief Offers the next element : kept if it is a candidate.
+     */
+    template <typename U>
+    bool offer( U&& p_elm )
+    {
+        if ( m_seen++ != m_next ) return false;
+
+        if ( m_sample.size() < m_k ) {
+            m_sample.emplace_back( std::forward<U>( p_elm ) );
+            if ( m_sample.size() == m_k ) { m_w = std::exp( std::log( random() ) / m_k ); next(); }
+            else                          { ++m_next; }
+        }
+        else {
+            std::uniform_int_distribution<std::size_t> l_slot( 0, m_k - 1 );
+            m_sample[l_slot( m_urbg )] = std::forward<U>( p_elm );
+            m_w *= std::exp( std::log( random() ) / m_k );
+            next();
+        }
+        return true;
+    }
+
+    std::size_t           seen  () const { return m_seen;   }
+    const std::vector<T>& sample() const { return m_sample; }
+    std::vector<T>        take  ()       { return std::move( m_sample ); }
+
+private:
+    // Uniform in ]0, 1[ : log() must stay finite
+    double random() {
+        std::uniform_real_distribution<double> l_dist( std::numeric_limits<double>::min(), 1.0 );
+        return l_dist( m_urbg );
+    }
+
+    // The index of the next candidate follows a geometric distribution
+    void next() {
+        if ( m_k == 0 ) { m_next = std::numeric_limits<std::size_t>::max(); return; }
+        const double l_skip = std::floor( std::log( random() ) / std::log1p( -m_w ) );
+        m_next = l_skip >= static_cast<double>( std::numeric_limits<std::size_t>::max() - m_seen )
+                     ? std::numeric_limits<std::size_t>::max()
+                     : m_seen + static_cast<std::size_t>( l_skip );
+    }
+
+    std::size_t    m_k;
+    URBG&          m_urbg;
+    std::vector<T> m_sample;
+    std::size_t    m_seen { 0 }; /*!< Number of elements offered (or skipped) so far */
+    std::size_t    m_next { 0 }; /*!< Index of the next element to keep              */
+    double         m_w    { 0 };
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Uniform sample of p_k elements of [p_first, p_last[ (Algorithm L).
+ *        Only needs input iterators : skipped elements are only incremented
+ *        over, never dereferenced.
+ */
+template <typename InputIt, typename URBG>
+std::vector<typename std::iterator_traits<InputIt>::value_type>
+reservoir_sample( InputIt p_first, InputIt p_last, std::size_t p_k, URBG&& p_urbg )
+{
+    using value_t = typename std::iterator_traits<InputIt>::value_type;
+
+    reservoir<value_t, std::remove_reference_t<URBG>> l_reservoir( p_k, p_urbg );
+    if ( p_k == 0 ) return {};
+
+    while ( p_first != p_last ) {
+        const std::size_t l_skip    = l_reservoir.skip();
+        std::size_t       l_skipped = 0;
+        for ( ; l_skipped < l_skip && p_first != p_last; ++l_skipped ) { ++p_first; }
+        l_reservoir.skipped( l_skipped );
+        if ( p_first == p_last ) break;
+
+        l_reservoir.offer( *p_first );
+        ++p_first;
+    }
+    return l_reservoir.take();
+}
+
+/*!
+ * @brief Same with Algorithm R : a random number per element.
+ */
+template <typename InputIt, typename URBG>
+std::vector<typename std::iterator_traits<InputIt>::value_type>
+reservoir_sample_r( InputIt p_first, InputIt p_last, std::size_t p_k, URBG&& p_urbg )
+{
+    std::vector<typename std::iterator_traits<InputIt>::value_type> l_sample;
+    l_sample.reserve( p_k );
+    if ( p_k == 0 ) return l_sample;
+
+    for ( std::size_t i = 0; p_first != p_last; ++p_first, ++i ) {
+        if ( i < p_k ) { l_sample.push_back( *p_first ); continue; }
+
+        std::uniform_int_distribution<std::size_t> l_dist( 0, i );
+        const std::size_t                          l_slot = l_dist( p_urbg );
+        if ( l_slot < p_k ) { l_sample[l_slot] = *p_first; }
+    }
+    return l_sample;
+}
+
+} // namespace sampling
+
+#endif // RESERVOIR_SAMPLING_HPP
@@ -0,0 +1,293 @@
+#ifndef WEIGHTED_SAMPLING_HPP
+#define WEIGHTED_SAMPLING_HPP
+
+/*!
+ * @brief Weighted sampling without replacement, and parallel sampling.
+ *
+ *        A-ES (Efraimidis and Spirakis) : every element gets a random key
+ *        E / w, with E following an exponential distribution of rate 1 and
+ *        w its weight. The k elements of smallest keys are a weighted
+ *        sample : an element of weight w comes first with a probability
+ *        w / sum(w). With every weight at 1, it is a uniform sample.
+ *
+ *        The keys make the samples mergeable : the k smallest keys of two
+ *        disjoint shards, merged, are the k smallest keys of their union.
+ *        The shards are sampled in parallel (see pstl_lite::parallel_for),
+ *        each one with its own engine (xoshiro256ss by default, see
+ *        random-engines.hpp), then merged.
+ *
+ *        A-ExpJ : once the reservoir is full, instead of drawing a key per
+ *        element, draw the total weight to skip before the next element
+ *        whose key gets under the current threshold T : exponential of
+ *        rate T. That element gets a key drawn in [0, T[.
+ *        With unit weights and random access iterators, the jump is O(1).
+ *
+ * More infos here :
+ *   - "Weighted random sampling with a reservoir",
+ *     P. S. Efraimidis and P. G. Spirakis, Information Processing Letters (2006)
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <parallel-algorithms.hpp>
+#include <random-engines.hpp>
+
+namespace sampling {
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief keyed_reservoir
+ *        Keeps the p_k elements of smallest keys in a max-heap :
+ *        the biggest kept key (the threshold) is at the top.
+ */
+template <typename T>
+class keyed_reservoir
+{
+public:
+    explicit keyed_reservoir( std::size_t p_k ) : m_k( p_k ) { m_heap.reserve( p_k ); }
+
+    std::size_t capacity() const { return m_k; }
+    bool        full    () const { return m_heap.size() >= m_k; }
+
+    /*!
+     * @brief The key an element must be under to be kept.
+     */
+    double threshold() const { return full() ? ( m_k ? m_heap.front().first : 0.0 ) : std::numeric_limits<double>::infinity(); }
+
+    template <typename U>
+    bool offer( double p_key, U&& p_elm )
+    {
+        if ( !full() ) {
+            m_heap.emplace_back( p_key, std::forward<U>( p_elm ) );
+            std::push_heap( std::begin(m_heap), std::end(m_heap), compare );
+            return true;
+        }
+        if ( !( p_key < threshold() ) ) return false;
+
+        std::pop_heap( std::begin(m_heap), std::end(m_heap), compare );
+        m_heap.back() = { p_key, std::forward<U>( p_elm ) };
+        std::push_heap( std::begin(m_heap), std::end(m_heap), compare );
+        return true;
+    }
+
+    /*!
+     * @brief Keeps the p_k smallest keys of both reservoirs.
+     */
+    void merge( keyed_reservoir&& p_other )
+    {
+        for ( auto& l_item : p_other.m_heap ) { offer( l_item.first, std::move( l_item.second ) ); }
+        p_other.m_heap.clear();
+    }
+
+    /*!
+     * @brief The sample, by increasing key (i.e. in drawing order).
+     */
+    std::vector<T> take()
+    {
+        std::sort_heap( std::begin(m_heap), std::end(m_heap), compare );
+
+        std::vector<T> l_res;
+        l_res.reserve( m_heap.size() );
+        for ( auto& l_item : m_heap ) { l_res.push_back( std::move( l_item.second ) ); }
+        m_heap.clear();
+        return l_res;
+    }
+
+private:
+    static bool compare( const std::pair<double, T>& a, const std::pair<double, T>& b ) { return a.first < b.first; }
+
+    std::size_t                       m_k;
+    std::vector<std::pair<double, T>> m_heap; /*!< Max-heap on the keys */
+};
+
+namespace detail {
+
+    // Uniform in ]0, 1[ : log() must stay finite
+    template <typename URBG>
+    double open_uniform( URBG& p_urbg ) {
+        std::uniform_real_distribution<double> l_dist( std::numeric_limits<double>::min(), 1.0 );
+        return l_dist( p_urbg );
+    }
+
+    // Exponential key of an element of weight p_w, conditioned to be under p_threshold
+    template <typename URBG>
+    double exponential_key( double p_w, double p_threshold, URBG& p_urbg ) {
+        const double l_min = std::exp( -p_threshold * p_w ); // 0 when p_threshold is infinite
+        std::uniform_real_distribution<double> l_dist( l_min, 1.0 );
+        double l_u = l_dist( p_urbg );
+        if ( l_u <= 0.0 ) { l_u = std::numeric_limits<double>::min(); }
+        return std::min( -std::log( l_u ) / p_w, std::nextafter( p_threshold, 0.0 ) );
+    }
+
+    /*!
+     * @brief A-ExpJ over [p_first, p_last[ into p_reservoir.
+     *        Elements of weight <= 0 are never sampled.
+     */
+    template <typename T, typename InputIt, typename WeightFn, typename URBG>
+    void weighted_sample_into( keyed_reservoir<T>& p_reservoir, InputIt p_first, InputIt p_last,
+                               WeightFn& p_weight, URBG& p_urbg )
+    {
+        if ( !p_reservoir.capacity() ) return;
+
+        // Filling : one key per element
+        for ( ; p_first != p_last && !p_reservoir.full(); ++p_first ) {
+            const double l_w = p_weight( *p_first );
+            if ( l_w > 0 ) { p_reservoir.offer( detail::exponential_key( l_w, p_reservoir.threshold(), p_urbg ), *p_first ); }
+        }
+
+        // Jumps : the weight to skip follows an exponential distribution of rate threshold()
+        double l_jump = -std::log( detail::open_uniform( p_urbg ) ) / p_reservoir.threshold();
+        for ( ; p_first != p_last; ++p_first ) {
+            const double l_w = p_weight( *p_first );
+            if ( !( l_w > 0 ) ) continue;
+            if ( ( l_jump -= l_w ) > 0 ) continue;
+
+            p_reservoir.offer( detail::exponential_key( l_w, p_reservoir.threshold(), p_urbg ), *p_first );
+            l_jump = -std::log( detail::open_uniform( p_urbg ) ) / p_reservoir.threshold();
+        }
+    }
+
+    /*!
+     * @brief Same with unit weights : the jumps are O(1) on random access iterators.
+     */
+    template <typename T, typename RandomIt, typename URBG>
+    void uniform_sample_into( keyed_reservoir<T>& p_reservoir, RandomIt p_first, RandomIt p_last, URBG& p_urbg )
+    {
+        if ( !p_reservoir.capacity() ) return;
+
+        for ( ; p_first != p_last && !p_reservoir.full(); ++p_first ) {
+            p_reservoir.offer( -std::log( detail::open_uniform( p_urbg ) ), *p_first );
+        }
+
+        while ( p_first != p_last ) {
+            const double l_jump = std::floor( -std::log( detail::open_uniform( p_urbg ) ) / p_reservoir.threshold() );
+            if ( l_jump >= static_cast<double>( p_last - p_first ) ) break;
+
+            p_first += static_cast<typename std::iterator_traits<RandomIt>::difference_type>( l_jump );
+            p_reservoir.offer( detail::exponential_key( 1.0, p_reservoir.threshold(), p_urbg ), *p_first );
+            ++p_first;
+        }
+    }
+
+    // Independent engine for the shard p_index
+    template <typename Engine>
+    Engine shard_engine( std::uint64_t p_seed, std::size_t p_index ) {
+        std::seed_seq l_seq{ static_cast<std::uint32_t>( p_seed ), static_cast<std::uint32_t>( p_seed >> 32 ),
+                             static_cast<std::uint32_t>( p_index ), static_cast<std::uint32_t>( p_index >> 32 ) };
+        return Engine( l_seq );
+    }
+
+    /*!
+     * @brief Samples p_shards shards of [p_first, p_last[ in parallel with p_sample_shard,
+     *        then merges them in order : the result only depends on p_seed and
+     *        p_shards, not on which worker samples which shard.
+     */
+    template <typename T, typename Engine, typename RandomIt, typename SampleShard>
+    std::vector<T> parallel_sample_shards( work_stealing_pool& p_pool, RandomIt p_first, RandomIt p_last,
+                                           std::size_t p_k, std::uint64_t p_seed, std::ptrdiff_t p_shards,
+                                           SampleShard p_sample_shard )
+    {
+        const std::ptrdiff_t l_count = std::distance( p_first, p_last );
+        if ( l_count <= 0 || !p_k ) return {};
+
+        const std::ptrdiff_t l_shards = std::max<std::ptrdiff_t>( 1, std::min( p_shards, l_count ) );
+        const std::ptrdiff_t l_grain  = ( l_count + l_shards - 1 ) / l_shards;
+
+        std::vector<keyed_reservoir<T>> l_partials( l_shards, keyed_reservoir<T>( p_k ) );
+        pstl_lite::parallel_for( p_pool, std::ptrdiff_t{0}, l_shards, [&]( std::ptrdiff_t p_begin, std::ptrdiff_t p_end ) {
+            for ( std::ptrdiff_t s = p_begin; s < p_end; ++s ) {
+                Engine l_engine = shard_engine<Engine>( p_seed, static_cast<std::size_t>( s ) );
+                p_sample_shard( l_partials[s], p_first + std::min( l_count, s * l_grain ),
+                                p_first + std::min( l_count, ( s + 1 ) * l_grain ), l_engine );
+            }
+        }, std::ptrdiff_t{1} );
+
+        for ( std::ptrdiff_t s = 1; s < l_shards; ++s ) { l_partials[0].merge( std::move( l_partials[s] ) ); }
+        return l_partials[0].take();
+    }
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Weighted sample of p_k elements of [p_first, p_last[, without replacement.
+ *        A-ES : one exponential key per element.
+ */
+template <typename InputIt, typename WeightFn, typename URBG>
+std::vector<typename std::iterator_traits<InputIt>::value_type>
+weighted_sample_es( InputIt p_first, InputIt p_last, std::size_t p_k, WeightFn p_weight, URBG&& p_urbg )
+{
+    keyed_reservoir<typename std::iterator_traits<InputIt>::value_type> l_reservoir( p_k );
+    if ( !p_k ) return {};
+
+    for ( ; p_first != p_last; ++p_first ) {
+        const double l_w = p_weight( *p_first );
+        if ( !( l_w > 0 ) ) continue;
+
+        const double l_key = -std::log( detail::open_uniform( p_urbg ) ) / l_w;
+        if ( l_key < l_reservoir.threshold() ) { l_reservoir.offer( l_key, *p_first ); }
+    }
+    return l_reservoir.take();
+}
+
+/*!
+ * @brief Same sample distribution with A-ExpJ : O(k.log(n / k)) random numbers.
+ */
+template <typename InputIt, typename WeightFn, typename URBG>
+std::vector<typename std::iterator_traits<InputIt>::value_type>
+weighted_sample( InputIt p_first, InputIt p_last, std::size_t p_k, WeightFn p_weight, URBG&& p_urbg )
+{
+    keyed_reservoir<typename std::iterator_traits<InputIt>::value_type> l_reservoir( p_k );
+    detail::weighted_sample_into( l_reservoir, p_first, p_last, p_weight, p_urbg );
+    return l_reservoir.take();
+}
+
+/*!
+ * @brief Weighted sample of [p_first, p_last[ computed by shards in parallel.
+ *        The weights are read in parallel, one shard per worker : each shard
+ *        fills a reservoir of p_k elements, and their serial merge costs
+ *        O(workers.k.log k) on top of the serial A-ExpJ. The same p_seed
+ *        gives the same sample only with a pool of the same size.
+ */
+template <typename Engine = fast_random::xoshiro256ss, typename RandomIt, typename WeightFn>
+std::vector<typename std::iterator_traits<RandomIt>::value_type>
+parallel_weighted_sample( work_stealing_pool& p_pool, RandomIt p_first, RandomIt p_last,
+                          std::size_t p_k, WeightFn p_weight, std::uint64_t p_seed )
+{
+    using value_t = typename std::iterator_traits<RandomIt>::value_type;
+
+    return detail::parallel_sample_shards<value_t, Engine>( p_pool, p_first, p_last, p_k, p_seed, p_pool.size(),
+        [&p_weight]( keyed_reservoir<value_t>& p_res, RandomIt p_begin, RandomIt p_end, Engine& p_engine ) {
+            detail::weighted_sample_into( p_res, p_begin, p_end, p_weight, p_engine );
+        });
+}
+
+/*!
+ * @brief Uniform sample of [p_first, p_last[ computed by shards in parallel.
+ *        Only the sampled elements are read : one shard per worker, so the
+ *        same p_seed gives the same sample only with a pool of the same size.
+ */
+template <typename Engine = fast_random::xoshiro256ss, typename RandomIt>
+std::vector<typename std::iterator_traits<RandomIt>::value_type>
+parallel_sample( work_stealing_pool& p_pool, RandomIt p_first, RandomIt p_last,
+                 std::size_t p_k, std::uint64_t p_seed )
+{
+    using value_t = typename std::iterator_traits<RandomIt>::value_type;
+
+    return detail::parallel_sample_shards<value_t, Engine>( p_pool, p_first, p_last, p_k, p_seed, p_pool.size(),
+        []( keyed_reservoir<value_t>& p_res, RandomIt p_begin, RandomIt p_end, Engine& p_engine ) {
+            detail::uniform_sample_into( p_res, p_begin, p_end, p_engine );
+        });
+}
+
+} // namespace sampling
+
+#endif // WEIGHTED_SAMPLING_HPP
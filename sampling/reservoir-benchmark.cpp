@@ -0,0 +1,180 @@
+/************************************************************
+ *        Sampling a file bigger than the memory            *
+ ************************************************************/
+
+/*!
+ * @brief Draws a uniform sample of k lines out of a log file :
+ *          - loading every line in a vector, then std::sample
+ *          - reading the lines with std::getline, then Algorithm R / L
+ *            (see inc/reservoir-sampling.hpp) : only k lines in memory
+ *          - mapping the file (see inc/mapped-file.hpp) : std::sample needs
+ *            2 passes (to count the lines), Algorithm R and L only one
+ *
+ *        The lines are numbered : the mean index of the sample must be
+ *        close to the middle of the file.
+ *        The file is written right before being sampled, hence comes from
+ *        the page cache : the measures are CPU bound.
+ *
+ * Usage : reservoir-benchmark [lines] [sample size]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <time-measure.hpp>
+#include <mapped-file.hpp>
+#include <reservoir-sampling.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define NB_LINES    5e6 // Default number of lines of the file
+#define SAMPLE_SIZE 1e3 // Default number of sampled lines
+#define FILE_NAME   "/tmp/reservoir-benchmark.log"
+
+/*!
+ * @brief A line of a std::istream, to read it with std::istream_iterator.
+ */
+struct line
+{
+    std::string value;
+    friend std::istream& operator>>( std::istream& p_is, line& p_line ) { return std::getline( p_is, p_line.value ); }
+};
+
+/*!
+ * @brief Writes p_lines numbered log lines into p_path.
+ */
+void write_log( const std::string& p_path, size_t p_lines )
+{
+    static const char* LEVELS[] = { "INFO ", "DEBUG", "WARN ", "ERROR" };
+
+    std::mt19937                          l_gen;
+    std::uniform_int_distribution<size_t> l_level( 0, 3 ), l_worker( 0, 63 ), l_time( 1, 999 );
+
+    std::ofstream l_file( p_path );
+    for ( size_t i = 0; i < p_lines; ++i ) {
+        l_file << "2024-01-01T00:00:00 [" << LEVELS[l_level( l_gen )] << "] worker-" << l_worker( l_gen )
+               << " request " << i << " served in " << l_time( l_gen ) << " ms\n";
+    }
+}
+
+/*!
+ * @brief Index of a line written by write_log.
+ */
+size_t line_index( std::string_view p_line )
+{
+    const auto l_pos = p_line.find( "request " );
+    return l_pos == std::string_view::npos ? 0 : std::stoul( std::string( p_line.substr( l_pos + 8, 20 ) ) );
+}
+
+/*!
+ * @brief Checks the size of the sample, that its lines are distinct,
+ *        and returns their mean index relative to p_lines.
+ */
+template <typename Lines>
+double check( const Lines& p_sample, size_t p_k, size_t p_lines )
+{
+    std::vector<size_t> l_indices;
+    for ( const auto& l_line : p_sample ) { l_indices.push_back( line_index( l_line ) ); }
+    std::sort( std::begin(l_indices), std::end(l_indices) );
+
+    if ( p_sample.size() != std::min( p_k, p_lines )
+         || std::adjacent_find( std::begin(l_indices), std::end(l_indices) ) != std::end(l_indices) ) {
+        std::cout << "SOMETHING WENT WRONG!\n";
+    }
+
+    double l_sum = 0;
+    for ( const auto l_idx : l_indices ) { l_sum += l_idx; }
+    return l_indices.empty() ? 0 : l_sum / l_indices.size() / p_lines;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const size_t l_lines = argc > 1 ? static_cast<size_t>( std::stod( argv[1] ) ) : static_cast<size_t>( NB_LINES );
+    const size_t l_k     = argc > 2 ? static_cast<size_t>( std::stod( argv[2] ) ) : static_cast<size_t>( SAMPLE_SIZE );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nLines       - " << l_lines << "\nSample size - " << l_k;
+    std::cout << "\n--------------------------------------------------\n";
+
+    write_log( FILE_NAME, l_lines );
+
+    std::mt19937_64 l_gen{ std::random_device{}() };
+
+    std::cout << "\n" << std::setw(30) << "method" << std::setw(12) << "time (ms)" << std::setw(12) << "mean pos" << "\n";
+    auto report = [&]( const char* p_name, auto p_time, double p_mean ) {
+        std::cout << std::setw(30) << p_name << std::setw(12) << p_time << std::setw(12) << std::setprecision(3) << p_mean << "\n";
+        // A uniform sample of 1000 lines has a mean within 0.5 +- 0.01 (1 sigma)
+        if ( l_k >= 1000 && ( p_mean < 0.45 || p_mean > 0.55 ) ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    };
+
+    // Everything in memory, then std::sample
+    {
+        std::vector<std::string> mySample;
+        const auto myTime = measure<std::chrono::milliseconds>( [&] {
+            std::ifstream            l_file( FILE_NAME );
+            std::vector<std::string> l_all;
+            for ( std::string l_line; std::getline( l_file, l_line ); ) { l_all.push_back( std::move( l_line ) ); }
+            std::sample( std::begin(l_all), std::end(l_all), std::back_inserter(mySample), l_k, l_gen );
+        });
+        report( "load + std::sample", myTime, check( mySample, l_k, l_lines ) );
+    }
+
+    // Streamed lines, only the sample in memory
+    {
+        std::vector<line> mySample;
+        const auto myTime = measure<std::chrono::milliseconds>( [&] {
+            std::ifstream l_file( FILE_NAME );
+            mySample = sampling::reservoir_sample_r( std::istream_iterator<line>( l_file ),
+                                                     std::istream_iterator<line>(), l_k, l_gen );
+        });
+        std::vector<std::string> l_values;
+        for ( auto& l_line : mySample ) { l_values.push_back( std::move( l_line.value ) ); }
+        report( "getline + Algorithm R", myTime, check( l_values, l_k, l_lines ) );
+    }
+    {
+        std::vector<line> mySample;
+        const auto myTime = measure<std::chrono::milliseconds>( [&] {
+            std::ifstream l_file( FILE_NAME );
+            mySample = sampling::reservoir_sample( std::istream_iterator<line>( l_file ),
+                                                   std::istream_iterator<line>(), l_k, l_gen );
+        });
+        std::vector<std::string> l_values;
+        for ( auto& l_line : mySample ) { l_values.push_back( std::move( l_line.value ) ); }
+        report( "getline + Algorithm L", myTime, check( l_values, l_k, l_lines ) );
+    }
+
+    // Mapped file : the lines are views on the mapping, nothing is copied
+    {
+        auto myFile = sampling::mapped_file::open( FILE_NAME );
+        if ( !myFile ) { std::cout << "SOMETHING WENT WRONG!\n"; return EXIT_FAILURE; }
+        const sampling::lines myLines{ myFile->view() };
+
+        std::vector<std::string_view> mySample;
+        auto myTime = measure<std::chrono::milliseconds>( [&] {
+            std::sample( std::begin(myLines), std::end(myLines), std::back_inserter(mySample), l_k, l_gen );
+        });
+        report( "mmap + std::sample", myTime, check( mySample, l_k, l_lines ) );
+
+        myTime = measure<std::chrono::milliseconds>( [&] {
+            mySample = sampling::reservoir_sample_r( std::begin(myLines), std::end(myLines), l_k, l_gen );
+        });
+        report( "mmap + Algorithm R", myTime, check( mySample, l_k, l_lines ) );
+
+        myTime = measure<std::chrono::milliseconds>( [&] {
+            mySample = sampling::reservoir_sample( std::begin(myLines), std::end(myLines), l_k, l_gen );
+        });
+        report( "mmap + Algorithm L", myTime, check( mySample, l_k, l_lines ) );
+    }
+
+    std::remove( FILE_NAME );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/************************************************************
+ *        Parallel and weighted sampling                    *
+ ************************************************************/
+
+/*!
+ * @brief std::sample (see std-sample.cpp) draws a uniform sample on a
+ *        single thread, reading the whole population. We sample k
+ *        elements of a population of n integers (see inc/weighted-sampling.hpp) :
+ *          - uniform : std::sample vs the A-ES keys with jumps, serial and
+ *            merged from shards sampled by a work_stealing_pool
+ *          - weighted (the weight of the value v is v + 1) : one key per
+ *            element (A-ES) vs jumps (A-ExpJ), serial and parallel (with
+ *            the speedup of the parallel one over the serial A-ExpJ)
+ *
+ *        The mean of a uniform sample is close to n / 2, the mean of the
+ *        weighted one to 2n / 3.
+ *
+ * Usage : weighted-benchmark [population] [sample size] [max threads]
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <time-measure.hpp>
+#include <weighted-sampling.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define POPULATION  1e8 // Default size of the population
+#define SAMPLE_SIZE 1e3 // Default number of sampled elements
+
+/*!
+ * @brief Checks the sample size and that its values are distinct,
+ *        returns their mean relative to p_n.
+ */
+double check( std::vector<unsigned> p_sample, std::size_t p_k, std::size_t p_n )
+{
+    std::sort( std::begin(p_sample), std::end(p_sample) );
+    if ( p_sample.size() != std::min( p_k, p_n )
+         || std::adjacent_find( std::begin(p_sample), std::end(p_sample) ) != std::end(p_sample) ) {
+        std::cout << "SOMETHING WENT WRONG!\n";
+    }
+    const double l_sum = std::accumulate( std::begin(p_sample), std::end(p_sample), 0.0 );
+    return p_sample.empty() ? 0 : l_sum / p_sample.size() / p_n;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const size_t   l_n       = argc > 1 ? static_cast<size_t>( std::stod( argv[1] ) ) : static_cast<size_t>( POPULATION );
+    const size_t   l_k       = argc > 2 ? static_cast<size_t>( std::stod( argv[2] ) ) : static_cast<size_t>( SAMPLE_SIZE );
+    const unsigned l_threads = argc > 3 ? static_cast<unsigned>( std::stoul( argv[3] ) )
+                                        : std::max( 1u, std::thread::hardware_concurrency() );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nPopulation  - " << l_n << "\nSample size - " << l_k << "\nThreads     - " << l_threads;
+    std::cout << "\n--------------------------------------------------\n";
+
+    std::vector<unsigned> myPopulation( l_n );
+    std::iota( std::begin(myPopulation), std::end(myPopulation), 0u );
+
+    std::mt19937_64    myGen{ std::random_device{}() };
+    work_stealing_pool myPool( l_threads );
+
+    std::cout << "\n" << std::setw(26) << "method" << std::setw(12) << "time (us)"
+              << std::setw(16) << "samples/s" << std::setw(10) << "mean" << "\n";
+    auto report = [&]( const char* p_name, auto p_time, double p_mean, double p_expected ) {
+        std::cout << std::setw(26) << p_name << std::setw(12) << p_time << std::setw(16) << std::setprecision(3)
+                  << l_k / ( std::max<double>( 1, p_time ) * 1e-6 ) << std::setw(10) << p_mean << "\n";
+        // With 1000 elements, the mean is within 0.01 of its expected value (1 sigma)
+        if ( l_k >= 1000 && l_n >= 100 * l_k && std::abs( p_mean - p_expected ) > 0.05 ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    };
+
+    std::vector<unsigned> mySample;
+
+    // Uniform
+    auto myTime = measure( [&] {
+        mySample.clear();
+        std::sample( std::begin(myPopulation), std::end(myPopulation), std::back_inserter(mySample), l_k, myGen );
+    });
+    report( "std::sample", myTime, check( mySample, l_k, l_n ), 0.5 );
+
+    myTime = measure( [&] {
+        mySample = sampling::weighted_sample_es( std::begin(myPopulation), std::end(myPopulation), l_k,
+                                                 []( unsigned ) { return 1.0; }, myGen );
+    });
+    report( "A-ES keys", myTime, check( mySample, l_k, l_n ), 0.5 );
+
+    myTime = measure( [&] {
+        mySample = sampling::parallel_sample( myPool, std::begin(myPopulation), std::end(myPopulation), l_k, myGen() );
+    });
+    report( "parallel_sample", myTime, check( mySample, l_k, l_n ), 0.5 );
+
+    // Weighted
+    const auto myWeight = []( unsigned v ) { return v + 1.0; };
+
+    myTime = measure( [&] {
+        mySample = sampling::weighted_sample_es( std::begin(myPopulation), std::end(myPopulation), l_k, myWeight, myGen );
+    });
+    report( "weighted A-ES", myTime, check( mySample, l_k, l_n ), 2.0 / 3 );
+
+    myTime = measure( [&] {
+        mySample = sampling::weighted_sample( std::begin(myPopulation), std::end(myPopulation), l_k, myWeight, myGen );
+    });
+    report( "weighted A-ExpJ", myTime, check( mySample, l_k, l_n ), 2.0 / 3 );
+    const auto mySerialTime = myTime;
+
+    myTime = measure( [&] {
+        mySample = sampling::parallel_weighted_sample( myPool, std::begin(myPopulation), std::end(myPopulation),
+                                                       l_k, myWeight, myGen() );
+    });
+    report( "parallel_weighted_sample", myTime, check( mySample, l_k, l_n ), 2.0 / 3 );
+    std::cout << std::setw(26) << "" << "  speedup vs A-ExpJ : " << std::setprecision(3)
+              << static_cast<double>( mySerialTime ) / std::max<double>( 1, myTime ) << " with " << myPool.size() << " threads\n";
+
+    return EXIT_SUCCESS;
+}
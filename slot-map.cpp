@@ -0,0 +1,411 @@
+/************************************************************
+ *           SLOT MAP : STABLE HANDLES ON TOP OF            *
+ *                O(1) VECTOR ELEMENT REMOVAL               *
+ ************************************************************/
+
+/*!
+ * @brief fast-remove-in-vectors.cpp removes an element from a std::vector
+ *        in O(1) time by moving the last element into its place.
+ *        The downside is that the index of that last element changes :
+ *        we cannot keep indices to the elements (e.g. entity ids).
+ *
+ *        A slot_map fixes that with one level of indirection :
+ *          - the values live in a dense std::vector (contiguous iteration,
+ *            O(1) removal with fast_remove).
+ *          - a handle is an index into a sparse table of slots, each slot
+ *            knowing where its value currently lives in the dense vector.
+ *          - every slot carries a generation, incremented when its value
+ *            is erased : a handle to an erased value never finds the
+ *            value that reuses its slot later on.
+ *        Insertion, removal and lookup are all O(1).
+ *
+ * More infos here :
+ *   - https://www.youtube.com/watch?v=SHaAR7XPtNU (Allan Deutsch, CppCon 2017)
+ *   - http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2017/p0661r0.pdf
+ */
+
+/*!
+ * @note The benchmark compares the slot_map to other ways to store
+ *       entities that must stay reachable through a stable id :
+ *          - std::vector + erase   : ids are looked up by binary search
+ *                                    (O(log n)), erase is O(n).
+ *          - std::list             : iterators are stable handles.
+ *          - std::unordered_map    : id to value.
+ *       for iteration (sum of every value), lookups from ids and
+ *       churn (erase a random entity and insert a new one).
+ */
+
+#include <iostream>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <limits>
+
+#define ELEMENTS 100000 // Number of live entities
+#define CHURNS   10000  // Number of erase + insert operations
+#define LOOKUPS  1000000
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*
+ * @brief A stopwatch class to perform measures
+ */
+template < typename Clock = std::chrono::high_resolution_clock >
+class stopwatch
+{
+private:
+    const std::string                m_title;
+    const typename Clock::time_point m_start;
+
+public:
+    stopwatch(const std::string& p_title = "") : m_title(p_title), m_start( Clock::now() ) {}
+    ~stopwatch() {
+        std::cout << "Computation using " << m_title << " performed in "
+                  << elapsed_time<unsigned int, std::chrono::milliseconds>() << " ms\n";
+    }
+
+    template < typename Rep   = typename Clock::duration::rep,
+               typename Units = typename Clock::duration >
+    Rep elapsed_time(void) const
+    {
+        std::atomic_thread_fence(std::memory_order_relaxed);
+        auto l_time = std::chrono::duration_cast<Units>(Clock::now() - m_start).count();
+        std::atomic_thread_fence(std::memory_order_relaxed);
+
+        return static_cast<Rep>(l_time);
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//  Same as in fast-remove-in-vectors.cpp, with a move instead of a swap
+template< typename T>
+void fast_remove( std::vector<T>& p_vec, std::size_t p_idx )
+{
+    if ( p_idx < p_vec.size() )
+    {
+        p_vec[p_idx] = std::move( p_vec.back() );
+        p_vec.pop_back();
+    }
+}
+
+/*!
+ * @brief slot_map
+ *        Dense storage of T values reachable through stable handles.
+ */
+template< typename T >
+class slot_map {
+    public:
+        struct handle {
+            std::uint32_t index     { std::numeric_limits<std::uint32_t>::max() };
+            std::uint32_t generation{ 0 };
+
+            bool operator==( const handle& o ) const { return index == o.index && generation == o.generation; }
+            bool operator!=( const handle& o ) const { return !this->operator==(o); }
+        };
+
+        using iterator       = typename std::vector<T>::iterator;
+        using const_iterator = typename std::vector<T>::const_iterator;
+
+    public:
+        slot_map() = default;
+
+        template< typename... Args >
+        handle emplace( Args&&... p_args ) {
+            std::uint32_t l_slot;
+            if ( m_free_head != NONE ) {
+                // Reuse a free slot : its generation was bumped on erase
+                l_slot      = m_free_head;
+                m_free_head = m_slots[l_slot].position;
+            }
+            else {
+                l_slot = static_cast<std::uint32_t>( m_slots.size() );
+                m_slots.push_back( {} );
+            }
+
+            m_values.emplace_back( std::forward<Args>(p_args)... );
+            m_owners.push_back( l_slot );
+            m_slots[l_slot].position = static_cast<std::uint32_t>( m_values.size() - 1 );
+
+            return { l_slot, m_slots[l_slot].generation };
+        }
+
+        handle insert( const T& p_val ) { return emplace( p_val );            }
+        handle insert( T&& p_val )      { return emplace( std::move(p_val) ); }
+
+        /*!
+         * @brief Removes the value of p_h in O(1) time.
+         *        Returns false if p_h does not refer to a live value.
+         */
+        bool erase( const handle& p_h ) {
+            if ( !contains(p_h) ) return false;
+
+            slot&             l_slot = m_slots[p_h.index];
+            const std::size_t l_pos  = l_slot.position;
+
+            // The last value moves into the hole : update its slot
+            m_slots[m_owners.back()].position = static_cast<std::uint32_t>( l_pos );
+            fast_remove( m_values, l_pos );
+            fast_remove( m_owners, l_pos );
+
+            ++l_slot.generation;
+            l_slot.position = m_free_head;
+            m_free_head     = p_h.index;
+
+            return true;
+        }
+
+        bool contains( const handle& p_h ) const {
+            if ( p_h.index >= m_slots.size() ) return false;
+
+            // A free slot stores the next free slot instead of a position
+            const slot& l_slot = m_slots[p_h.index];
+            return l_slot.generation == p_h.generation &&
+                   l_slot.position   <  m_owners.size() &&
+                   m_owners[l_slot.position] == p_h.index;
+        }
+
+        T*       find( const handle& p_h )       { return contains(p_h) ? &m_values[m_slots[p_h.index].position] : nullptr; }
+        const T* find( const handle& p_h ) const { return contains(p_h) ? &m_values[m_slots[p_h.index].position] : nullptr; }
+
+        // Unchecked access
+        T&       operator[]( const handle& p_h )       { return m_values[m_slots[p_h.index].position]; }
+        const T& operator[]( const handle& p_h ) const { return m_values[m_slots[p_h.index].position]; }
+
+        std::size_t size () const { return m_values.size();  }
+        bool        empty() const { return m_values.empty(); }
+        void        reserve( std::size_t p_size ) {
+            m_values.reserve( p_size );
+            m_owners.reserve( p_size );
+            m_slots .reserve( p_size );
+        }
+
+        // Contiguous iteration over the values (in no particular order)
+        iterator       begin()       { return m_values.begin(); }
+        iterator       end  ()       { return m_values.end();   }
+        const_iterator begin() const { return m_values.begin(); }
+        const_iterator end  () const { return m_values.end();   }
+
+    private:
+        static constexpr std::uint32_t NONE { std::numeric_limits<std::uint32_t>::max() };
+
+        struct slot {
+            std::uint32_t position  { NONE }; /*!< Index in m_values, or next free slot */
+            std::uint32_t generation{ 0 };
+        };
+
+        std::vector<T>             m_values;            /*!< Dense values               */
+        std::vector<std::uint32_t> m_owners;            /*!< Slot of each dense value   */
+        std::vector<slot>          m_slots;             /*!< Sparse handle table        */
+        std::uint32_t              m_free_head{ NONE }; /*!< Head of the free slots list */
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief A typical entity : some data and an id.
+ */
+struct entity {
+    std::uint64_t id;
+    double        pos[3];
+    double        value;
+};
+
+static volatile double g_sink{0}; // Prevents the compiler from dropping the computations
+
+template< typename Container, typename Get >
+void iterate( const std::string& p_title, const Container& p_cont, Get&& p_get )
+{
+    stopwatch myWatch( p_title );
+    double    l_sum{0};
+    for ( int cycle = 0; cycle < 100; ++cycle ) {
+        for ( const auto& elm : p_cont ) { l_sum += p_get(elm).value; }
+    }
+    g_sink = l_sum;
+}
+
+int main()
+{
+    std::cout << "----- Stable handles -----\n";
+    {
+        slot_map<std::string> myMap;
+        auto h1 = myMap.insert( "first"  );
+        auto h2 = myMap.insert( "second" );
+        auto h3 = myMap.insert( "third"  );
+
+        // With a plain fast_remove, "third" would now be reachable
+        // through the index of "first" only.
+        myMap.erase( h1 );
+        std::cout << "h2 -> " << myMap[h2] << ", h3 -> " << myMap[h3] << "\n";
+
+        // The slot of h1 is reused, but with another generation
+        auto h4 = myMap.insert( "fourth" );
+        std::cout << "h1 is " << ( myMap.contains(h1) ? "still valid" : "invalid" )
+                  << ", h4 -> " << myMap[h4] << "\n";
+
+        std::cout << "Values : ";
+        for ( const auto& v : myMap ) { std::cout << v << " "; }
+        std::cout << "\n";
+    }
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nElements - " << ELEMENTS
+              << "\nChurns - "                 << CHURNS
+              << "\nLookups - "                << LOOKUPS;
+    std::cout << "\n--------------------------------------------------\n";
+
+    std::default_random_engine random_engine;
+    auto make_entity = [&, l_next = std::uint64_t{0}]() mutable {
+        const double v = std::uniform_real_distribution<double>(0, 1)(random_engine);
+        return entity{ l_next++, { v, v, v }, v };
+    };
+
+    // Each container holds the same entities, and we keep a handle to each
+    slot_map<entity>                                     mySlotMap;
+    std::vector<slot_map<entity>::handle>                mySlotHandles;
+    std::vector<entity>                                  myVec;       // Sorted by id
+    std::list<entity>                                    myList;
+    std::vector<std::list<entity>::iterator>             myListHandles;
+    std::unordered_map<std::uint64_t, entity>            myHashMap;
+    std::vector<std::uint64_t>                           myIds;
+
+    mySlotMap.reserve( ELEMENTS );
+    myHashMap.reserve( ELEMENTS );
+    for ( std::size_t i = 0; i < ELEMENTS; ++i ) {
+        const entity e = make_entity();
+        mySlotHandles.push_back( mySlotMap.insert(e) );
+        myVec.push_back( e );
+        myListHandles.push_back( myList.insert( std::end(myList), e ) );
+        myHashMap.emplace( e.id, e );
+        myIds.push_back( e.id );
+    }
+
+    // ----- Churn ----- //
+    std::cout << "\nCHURN (erase a random entity, insert a new one)\n";
+    // Distinct victims : every id is erased at most once
+    std::vector<std::size_t> l_victims( ELEMENTS );
+    std::iota   ( std::begin(l_victims), std::end(l_victims), 0 );
+    std::shuffle( std::begin(l_victims), std::end(l_victims), random_engine );
+    l_victims.resize( CHURNS );
+    std::vector<entity> l_newcomers( CHURNS );
+    for ( auto& e : l_newcomers ) { e = make_entity(); }
+
+    {
+        stopwatch myWatch("slot_map");
+        for ( std::size_t c = 0; c < CHURNS; ++c ) {
+            mySlotMap.erase( mySlotHandles[l_victims[c]] );
+            mySlotHandles[l_victims[c]] = mySlotMap.insert( l_newcomers[c] );
+        }
+    }
+    {
+        stopwatch myWatch("std::vector + erase");
+        for ( std::size_t c = 0; c < CHURNS; ++c ) {
+            auto it = std::lower_bound( std::begin(myVec), std::end(myVec), myIds[l_victims[c]],
+                                        []( const entity& e, std::uint64_t id ) { return e.id < id; } );
+            myVec.erase( it );
+            myVec.push_back( l_newcomers[c] ); // Ids are increasing : still sorted
+        }
+    }
+    {
+        stopwatch myWatch("std::list");
+        for ( std::size_t c = 0; c < CHURNS; ++c ) {
+            myList.erase( myListHandles[l_victims[c]] );
+            myListHandles[l_victims[c]] = myList.insert( std::end(myList), l_newcomers[c] );
+        }
+    }
+    {
+        stopwatch myWatch("std::unordered_map");
+        for ( std::size_t c = 0; c < CHURNS; ++c ) {
+            myHashMap.erase( myIds[l_victims[c]] );
+            myHashMap.emplace( l_newcomers[c].id, l_newcomers[c] );
+        }
+    }
+    for ( std::size_t c = 0; c < CHURNS; ++c ) { myIds[l_victims[c]] = l_newcomers[c].id; }
+
+    // Make sure every container holds the same entities
+    for ( std::size_t i = 0; i < ELEMENTS; ++i ) {
+        if ( mySlotMap[mySlotHandles[i]].id != myIds[i] ||
+             myListHandles[i]->id           != myIds[i] ||
+             myHashMap.at( myIds[i] ).id    != myIds[i] ) {
+            std::cout << "SOMETHING WENT WRONG!\n";
+            break;
+        }
+    }
+
+    // ----- Iteration ----- //
+    std::cout << "\nITERATION (100 sums over every entity)\n";
+    iterate( "slot_map",            mySlotMap, []( const entity& e )     { return e; } );
+    iterate( "std::vector",         myVec,     []( const entity& e )     { return e; } );
+    iterate( "std::list",           myList,    []( const entity& e )     { return e; } );
+    iterate( "std::unordered_map",  myHashMap, []( const auto& p ) -> const entity& { return p.second; } );
+
+    // ----- Lookups ----- //
+    std::cout << "\nLOOKUPS (random entity from its handle/id)\n";
+    std::vector<std::size_t> l_queries( LOOKUPS );
+    for ( auto& q : l_queries ) { q = std::uniform_int_distribution<std::size_t>(0, ELEMENTS - 1)(random_engine); }
+    {
+        stopwatch myWatch("slot_map");
+        double    l_sum{0};
+        for ( auto q : l_queries ) { l_sum += mySlotMap.find( mySlotHandles[q] )->value; }
+        g_sink = l_sum;
+    }
+    {
+        stopwatch myWatch("std::vector (binary search)");
+        double    l_sum{0};
+        for ( auto q : l_queries ) {
+            l_sum += std::lower_bound( std::begin(myVec), std::end(myVec), myIds[q],
+                                       []( const entity& e, std::uint64_t id ) { return e.id < id; } )->value;
+        }
+        g_sink = l_sum;
+    }
+    {
+        stopwatch myWatch("std::list");
+        double    l_sum{0};
+        for ( auto q : l_queries ) { l_sum += myListHandles[q]->value; }
+        g_sink = l_sum;
+    }
+    {
+        stopwatch myWatch("std::unordered_map");
+        double    l_sum{0};
+        for ( auto q : l_queries ) { l_sum += myHashMap.find( myIds[q] )->second.value; }
+        g_sink = l_sum;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*
+----- Stable handles -----
+h2 -> second, h3 -> third
+h1 is invalid, h4 -> fourth
+Values : third second fourth 
+
+--------------------------------------------------
+		PARAMETERS
+Elements - 100000
+Churns - 10000
+Lookups - 1000000
+--------------------------------------------------
+
+CHURN (erase a random entity, insert a new one)
+Computation using slot_map performed in 2 ms
+Computation using std::vector + erase performed in 820 ms
+Computation using std::list performed in 3 ms
+Computation using std::unordered_map performed in 6 ms
+
+ITERATION (100 sums over every entity)
+Computation using slot_map performed in 16 ms
+Computation using std::vector performed in 17 ms
+Computation using std::list performed in 136 ms
+Computation using std::unordered_map performed in 142 ms
+
+LOOKUPS (random entity from its handle/id)
+Computation using slot_map performed in 12 ms
+Computation using std::vector (binary search) performed in 213 ms
+Computation using std::list performed in 8 ms
+Computation using std::unordered_map performed in 29 ms
+*/
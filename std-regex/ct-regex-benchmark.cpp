@@ -0,0 +1,176 @@
+/************************************************************
+ *        Compile-time regexes vs std::regex                *
+ ************************************************************/
+
+/*!
+ * @brief The std-regex-basics.cpp patterns are known at compile time :
+ *        std::regex parses them at run time, then interprets them. We
+ *        compare (see inc/ct-regex.hpp and inc/lazy-dfa.hpp) :
+ *          - the construction of std::regex and lazy_dfa::regex, done
+ *            CONSTRUCTIONS times (ct_regex::regex has nothing to build)
+ *          - the iteration over every match in a book
+ *          - the match of a whole text, read through a volatile pointer
+ *            so that the loop-invariant matches are not hoisted
+ *
+ *        Every engine must find the same matches (count and total length).
+ *
+ * Usage : ct-regex-benchmark [input file] [iterations]
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <regex>
+#include <string>
+#include <string_view>
+
+#include <fileLoader.hpp>
+#include <time-measure.hpp>
+#include <ct-regex.hpp>
+#include <lazy-dfa.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define INPUT_FILE    "../std-search/input/HP.txt"
+#define ITERATIONS    5    // Default number of passes over the text
+#define CONSTRUCTIONS 1000 // Number of constructions of each runtime regex
+
+static constexpr char WORDS[]      = "(\\w+)";
+static constexpr char LONG_WORDS[] = "(\\w{8,})";
+static constexpr char NAMES[]      = "harry|hermione";
+static constexpr char TEXT[]       = "[\\w\\s.,;:!?'\"()/-]*";
+static constexpr char CONTROLS[]   = "[\\x00-\\x1f]+";
+static constexpr char X_STAR[]     = "x*";
+
+// Read at each iteration : the compiler can not hoist the (pure) matches out of the loops
+static const std::string* volatile g_line { nullptr };
+
+struct result {
+    std::size_t count  { 0 };
+    std::size_t length { 0 };
+
+    bool operator!=( const result& o ) const { return count != o.count || length != o.length; }
+};
+
+/*!
+ * @brief Construction and iteration over the matches of Pattern in p_text.
+ */
+template <const char* Pattern, std::regex_constants::syntax_option_type Flags = std::regex_constants::ECMAScript>
+void benchPattern( const std::string& p_text, int p_iterations )
+{
+    std::cout << "\nPattern " << Pattern << "\n";
+
+    // Construction
+    const auto myStdBuild = measure( [&] {
+        for ( int i = 0; i < CONSTRUCTIONS; ++i ) { std::regex myRegex( Pattern, Flags ); }
+    });
+    const auto myDfaBuild = measure( [&] {
+        for ( int i = 0; i < CONSTRUCTIONS; ++i ) { lazy_dfa::regex myRegex( Pattern, Flags ); }
+    });
+    std::cout << "\tconstruction : std::regex " << myStdBuild * 1e3 / CONSTRUCTIONS << " ns, lazy_dfa::regex "
+              << myDfaBuild * 1e3 / CONSTRUCTIONS << " ns\n";
+
+    // Iteration over the matches
+    const std::regex      myStdRegex( Pattern, Flags );
+    const lazy_dfa::regex myDfaRegex( Pattern, Flags );
+    result                myStdRes, myDfaRes, myCtRes;
+    {
+        stopwatch myWatch("\tstd::sregex_iterator    ");
+        for ( int i = 0; i < p_iterations; ++i ) {
+            myStdRes = {};
+            for ( auto it = std::sregex_iterator( std::begin(p_text), std::end(p_text), myStdRegex );
+                  it != std::sregex_iterator(); ++it ) {
+                ++myStdRes.count;
+                myStdRes.length += it->length();
+            }
+        }
+    }
+    {
+        stopwatch myWatch("\tlazy_dfa::regex matches ");
+        for ( int i = 0; i < p_iterations; ++i ) {
+            myDfaRes = {};
+            for ( const std::string_view l_match : myDfaRegex.matches( p_text ) ) {
+                ++myDfaRes.count;
+                myDfaRes.length += l_match.size();
+            }
+        }
+    }
+    {
+        stopwatch myWatch("\tct_regex::regex matches ");
+        for ( int i = 0; i < p_iterations; ++i ) {
+            myCtRes = {};
+            for ( const std::string_view l_match : ct_regex::regex<Pattern, Flags>::matches( p_text ) ) {
+                ++myCtRes.count;
+                myCtRes.length += l_match.size();
+            }
+        }
+    }
+    std::cout << "\t" << myCtRes.count << " matches\n";
+
+    if ( myStdRes != myDfaRes || myStdRes != myCtRes ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::string l_file       = argc > 1 ? argv[1] : INPUT_FILE;
+    const int         l_iterations = argc > 2 ? std::stoi( argv[2] ) : ITERATIONS;
+
+    const auto myText = loadFile( l_file );
+    if ( !myText ) {
+        std::cout << "Unable to open " << l_file << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nInput      - " << l_file << " (" << myText->size() << " bytes)"
+              << "\nIterations - " << l_iterations;
+    std::cout << "\n--------------------------------------------------\n";
+
+    benchPattern<WORDS>     ( *myText, l_iterations );
+    benchPattern<LONG_WORDS>( *myText, l_iterations );
+    benchPattern<NAMES, std::regex_constants::ECMAScript | std::regex_constants::icase>( *myText, l_iterations );
+
+    // Whole input matching (the beginning of the book, without the UTF-8 quotes)
+    {
+        const std::regex      myStdRegex( TEXT );
+        const lazy_dfa::regex myDfaRegex( TEXT );
+        std::string           myLine;
+        std::copy_if( std::begin(*myText), std::begin(*myText) + std::min<std::size_t>( 1000, myText->size() ),
+                      std::back_inserter(myLine), []( char c ) { return static_cast<unsigned char>( c ) < 0x80; } );
+
+        g_line = &myLine;
+
+        const int   l_matches  = l_iterations * 1000;
+        std::size_t myStdMatch = 0, myDfaMatch = 0, myCtMatch = 0;
+        std::cout << "\nMatching " << myLine.size() << " bytes with " << TEXT << "\n";
+        {
+            stopwatch myWatch("\tstd::regex_match       ");
+            for ( int i = 0; i < l_matches; ++i ) { myStdMatch += std::regex_match( *g_line, myStdRegex ); }
+        }
+        {
+            stopwatch myWatch("\tlazy_dfa::regex::match ");
+            for ( int i = 0; i < l_matches; ++i ) { myDfaMatch += myDfaRegex.match( *g_line ); }
+        }
+        {
+            stopwatch myWatch("\tct_regex::regex::match ");
+            for ( int i = 0; i < l_matches; ++i ) { myCtMatch += ct_regex::regex<TEXT>::match( *g_line ); }
+        }
+        const std::size_t l_expected = static_cast<std::size_t>( l_matches );
+        if ( myStdMatch != l_expected || myDfaMatch != l_expected || myCtMatch != l_expected ) {
+            std::cout << "SOMETHING WENT WRONG!\n";
+        }
+    }
+
+    // Escaped range bounds, and an empty view without data
+    {
+        const std::string myCtrl( "\x01\x1f" );
+        const bool myOk = ct_regex::regex<CONTROLS>::match( myCtrl ) && std::regex_match( myCtrl, std::regex( CONTROLS ) )
+                       && !ct_regex::regex<CONTROLS>::match( "a-" )
+                       && ct_regex::regex<X_STAR>::match( std::string_view{} )
+                       && ct_regex::regex<X_STAR>::search( std::string_view{} );
+        if ( !myOk ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/************************************************************
+ *        Lazy DFA regex engine vs std::regex               *
+ ************************************************************/
+
+/*!
+ * @brief std::regex (see std-regex-basics.cpp) backtracks : tokenizing a
+ *        text with it is slow. We iterate over every match of the
+ *        std-regex-basics.cpp patterns in a book (see inc/lazy-dfa.hpp) :
+ *          - std::sregex_iterator
+ *          - lazy_dfa::regex::matches (one table lookup per byte)
+ *
+ *        Both must find the same matches (count and total length), and
+ *        agree on a few corner cases (escaped range bounds, empty text).
+ *        A search after a long prefix that almost matches (a+b|c in
+ *        a...ac) must stay linear.
+ *        The compilation of the regexes is measured too, the DFA
+ *        tables being built during the first iteration.
+ *
+ * Usage : dfa-benchmark [input file] [iterations]
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+#include <iostream>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+
+#include <fileLoader.hpp>
+#include <time-measure.hpp>
+#include <lazy-dfa.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define INPUT_FILE "../std-search/input/HP.txt"
+#define ITERATIONS 5 // Default number of passes over the text
+
+struct result {
+    std::size_t count  { 0 };
+    std::size_t length { 0 };
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::string l_file       = argc > 1 ? argv[1] : INPUT_FILE;
+    const int         l_iterations = argc > 2 ? std::stoi( argv[2] ) : ITERATIONS;
+
+    const auto myText = loadFile( l_file );
+    if ( !myText ) {
+        std::cout << "Unable to open " << l_file << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nInput      - " << l_file << " (" << myText->size() << " bytes)"
+              << "\nIterations - " << l_iterations;
+    std::cout << "\n--------------------------------------------------\n";
+
+    const std::pair<const char*, std::regex_constants::syntax_option_type> myPatterns[] = {
+        { "(\\w+)",          std::regex_constants::ECMAScript },
+        { "(\\w{8,})",       std::regex_constants::ECMAScript },
+        { "harry|hermione",  std::regex_constants::ECMAScript | std::regex_constants::icase },
+    };
+
+    for ( const auto& [l_pattern, l_flags] : myPatterns ) {
+        std::cout << "\nPattern " << l_pattern << "\n";
+        result myStdRes, myDfaRes;
+
+        // Compilation
+        std::optional<std::regex>      myStdRegex;
+        std::optional<lazy_dfa::regex> myDfaRegex;
+        const auto myStdBuild = measure( [&] { myStdRegex.emplace( l_pattern, l_flags ); } );
+        const auto myDfaBuild = measure( [&] { myDfaRegex.emplace( l_pattern, l_flags ); } );
+        std::cout << "\tconstruction : std::regex " << myStdBuild << " us, lazy_dfa::regex " << myDfaBuild << " us ("
+                  << myDfaRegex->nfa_size() << " NFA states, " << myDfaRegex->nb_classes() << " byte classes)\n";
+
+        // Iteration over the matches
+        {
+            stopwatch myWatch("\tstd::sregex_iterator   ");
+            for ( int i = 0; i < l_iterations; ++i ) {
+                myStdRes = {};
+                for ( auto it = std::sregex_iterator( std::begin(*myText), std::end(*myText), *myStdRegex );
+                      it != std::sregex_iterator(); ++it ) {
+                    ++myStdRes.count;
+                    myStdRes.length += it->length();
+                }
+            }
+        }
+        {
+            stopwatch myWatch("\tlazy_dfa::regex matches");
+            for ( int i = 0; i < l_iterations; ++i ) {
+                myDfaRes = {};
+                for ( const std::string_view l_match : myDfaRegex->matches( *myText ) ) {
+                    ++myDfaRes.count;
+                    myDfaRes.length += l_match.size();
+                }
+            }
+        }
+        std::cout << "\t" << myDfaRes.count << " matches, " << myDfaRegex->dfa_size() << " DFA states built\n";
+
+        if ( myStdRes.count != myDfaRes.count || myStdRes.length != myDfaRes.length ) {
+            std::cout << "SOMETHING WENT WRONG!\n";
+        }
+    }
+
+    // Whole input matching (the beginning of the book, without the UTF-8 quotes)
+    {
+        const lazy_dfa::regex myDfaRegex( "[\\w\\s.,;:!?'\"()/-]*" );
+        const std::regex      myStdRegex( "[\\w\\s.,;:!?'\"()/-]*" );
+        std::string           myLine;
+        std::copy_if( std::begin(*myText), std::begin(*myText) + std::min<std::size_t>( 1000, myText->size() ),
+                      std::back_inserter(myLine), []( char c ) { return static_cast<unsigned char>( c ) < 0x80; } );
+
+        bool myStdMatch = false, myDfaMatch = false;
+        std::cout << "\nMatching " << myLine.size() << " bytes\n";
+        {
+            stopwatch myWatch("\tstd::regex_match      ");
+            for ( int i = 0; i < l_iterations * 1000; ++i ) { myStdMatch = std::regex_match( myLine, myStdRegex ); }
+        }
+        {
+            stopwatch myWatch("\tlazy_dfa::regex::match");
+            for ( int i = 0; i < l_iterations * 1000; ++i ) { myDfaMatch = myDfaRegex.match( myLine ); }
+        }
+        if ( !myStdMatch || !myDfaMatch ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+
+    // A long prefix that almost matches : each byte must be read a bounded number of times
+    {
+        const std::size_t     myPrefix = 40000;
+        const std::string     myLine   = std::string( myPrefix, 'a' ) + "c";
+        const lazy_dfa::regex myDfaRegex( "a+b|c" );
+
+        std::optional<std::string_view> myMatch;
+        std::cout << "\nSearching a+b|c in " << myLine.size() << " bytes (a...ac)\n";
+        {
+            stopwatch myWatch("\tlazy_dfa::regex::search");
+            for ( int i = 0; i < l_iterations; ++i ) { myMatch = myDfaRegex.search( myLine ); }
+        }
+        if ( !myMatch || myMatch->data() != myLine.data() + myPrefix || myMatch->size() != 1 ) {
+            std::cout << "SOMETHING WENT WRONG!\n";
+        }
+    }
+
+    // Escaped range bounds, and an empty view without data
+    {
+        const lazy_dfa::regex myDfaCtrl( "[\\x00-\\x1f]+" ), myDfaA( "a" ), myDfaAs( "a*" );
+        const std::regex      myStdCtrl( "[\\x00-\\x1f]+" );
+        const std::string     myCtrl( "\x01\x1f" );
+
+        const bool myOk = myDfaCtrl.match( myCtrl ) && std::regex_match( myCtrl, myStdCtrl )
+                       && !myDfaCtrl.match( "a-" ) && !std::regex_match( "a-", myStdCtrl )
+                       && !myDfaA.match( std::string_view{} )
+                       && myDfaAs.match( std::string_view{} ) && myDfaAs.search( std::string_view{} );
+        if ( !myOk ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+
+    return EXIT_SUCCESS;
+}
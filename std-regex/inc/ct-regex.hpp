@@ -0,0 +1,617 @@
+#ifndef CT_REGEX_HPP
+#define CT_REGEX_HPP
+
+/*!
+ * @brief ct_regex::regex
+ *        Most of our patterns are known at compile time : parsing them
+ *        at run time (std::regex constructor) and interpreting them
+ *        through a generic engine is wasted work.
+ *        Here, as in Hana Dusíková's CTRE, the pattern is parsed by
+ *        the compiler into a type (its syntax tree), and each node of
+ *        the tree has its own matching code : the compiler inlines and
+ *        optimizes the whole matcher, e.g. \w+ becomes a plain loop.
+ *
+ *        C++17 does not take string literals as template arguments :
+ *        the pattern is a constexpr array of static storage.
+ *
+ *            static constexpr char WORDS[] = "(\\w+)";
+ *            for ( std::string_view w : ct_regex::regex<WORDS>::matches( text ) ) { ... }
+ *
+ *        Supported subset (ECMAScript syntax, same as lazy-dfa.hpp) :
+ *          - literals, '.', escapes (\w \W \d \D \s \S \n \t \xHH ...)
+ *          - classes [a-z_], negated classes [^...]
+ *          - quantifiers * + ? {n} {n,} {n,m}, greedy or lazy ('?' suffix)
+ *          - alternation |, groups (...) and (?:...)
+ *          - std::regex_constants::icase
+ *        An invalid pattern does not compile.
+ *
+ *        Like std::regex, the matcher backtracks (leftmost-first, the
+ *        first alternative wins) : the results are the std::regex ones.
+ *        The repetition of a single character class does not recurse,
+ *        other repetitions recurse once per iteration.
+ *        Groups only group : the match is reported as a whole.
+ *
+ * More infos here :
+ *   - https://github.com/hanickadot/compile-time-regular-expressions
+ *   - "Compile Time Regular Expressions", H. Dusíková, CppCon 2019
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <regex>
+#include <string_view>
+
+namespace ct_regex {
+
+namespace detail {
+
+    constexpr int INFINITE { -1 };
+
+    /*!
+     * @brief Set of bytes, usable in constant expressions.
+     */
+    struct char_set
+    {
+        std::uint64_t bits[4] {};
+
+        constexpr void set ( unsigned char c )       { bits[c >> 6] |= std::uint64_t{1} << ( c & 63 ); }
+        constexpr bool test( unsigned char c ) const { return ( bits[c >> 6] >> ( c & 63 ) ) & 1; }
+
+        constexpr char_set operator|( const char_set& o ) const {
+            return { { bits[0] | o.bits[0], bits[1] | o.bits[1], bits[2] | o.bits[2], bits[3] | o.bits[3] } };
+        }
+        constexpr char_set operator~() const { return { { ~bits[0], ~bits[1], ~bits[2], ~bits[3] } }; }
+    };
+
+    constexpr char_set range( unsigned char p_first, unsigned char p_last ) {
+        char_set l_res;
+        for ( unsigned c = p_first; c <= p_last; ++c ) { l_res.set( static_cast<unsigned char>( c ) ); }
+        return l_res;
+    }
+    constexpr char_set word_set () { return range( 'a', 'z' ) | range( 'A', 'Z' ) | range( '0', '9' ) | range( '_', '_' ); }
+    constexpr char_set digit_set() { return range( '0', '9' ); }
+    constexpr char_set space_set() { return range( '\t', '\r' ) | range( ' ', ' ' ); }
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    // Syntax tree : one type per node
+    template <std::uint64_t B0, std::uint64_t B1, std::uint64_t B2, std::uint64_t B3>
+    struct set {
+        static constexpr char_set value { { B0, B1, B2, B3 } };
+    };
+    template <typename... Nodes>                      struct sequence    {};
+    template <typename... Nodes>                      struct alternative {};
+    template <int Min, int Max, bool Greedy, typename Node> struct repeat {};
+
+    template <typename Node, typename Seq> struct prepend;
+    template <typename Node, typename... Nodes> struct prepend<Node, sequence<Nodes...>>    { using type = sequence<Node, Nodes...>; };
+    template <typename Node, typename... Nodes> struct prepend<Node, alternative<Nodes...>> { using type = alternative<Node, Nodes...>; };
+
+    template <typename Node> struct simplify                 { using type = Node; };
+    template <typename Node> struct simplify<sequence<Node>> { using type = Node; }; // (x) is x
+
+    template <typename Node> struct as_alternative                      { using type = alternative<Node>; };
+    template <typename... Nodes> struct as_alternative<alternative<Nodes...>> { using type = alternative<Nodes...>; };
+
+    /*!
+     * @brief Result of the parsing of the pattern from a position :
+     *        the node and the position after it.
+     */
+    template <typename Node, std::size_t End>
+    struct parsed {
+        using type = Node;
+        static constexpr std::size_t end = End;
+    };
+
+    constexpr std::size_t length( const char* p_str ) {
+        std::size_t l_res = 0;
+        while ( p_str[l_res] ) { ++l_res; }
+        return l_res;
+    }
+
+    constexpr bool is_quantifier( char c ) { return c == '*' || c == '+' || c == '?' || c == '{'; }
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    /*!
+     * @brief parser
+     *        Recursive descent parser, run by the compiler : each parsing
+     *        function template returns a parsed<Node, End> (its type is the
+     *        result). The classes and escapes are computed by constexpr
+     *        functions : a syntax error in them is a throw, i.e. not a
+     *        constant expression.
+     *            alternative := concat ( '|' concat )*
+     *            concat      := repeat*
+     *            repeat      := atom [ quantifier [ '?' ] ]
+     *            atom        := '(' [ '?:' ] alternative ')' | '[' class ']' | '.' | escape | literal
+     */
+    template <const char* Pattern, bool ICase>
+    struct parser
+    {
+        static constexpr std::size_t N = length( Pattern );
+
+        static constexpr char at( std::size_t i ) { return i < N ? Pattern[i] : '\0'; }
+
+        struct set_result    { char_set set; std::size_t end; };
+        struct char_result   { int value; std::size_t end; };
+        struct member_result { int value; char_set set; std::size_t end; };
+        struct braces_result { int min; int max; std::size_t end; };
+
+        static constexpr char_set literal( unsigned char c ) {
+            char_set l_res;
+            l_res.set( c );
+            if ( ICase && c >= 'a' && c <= 'z' ) { l_res.set( static_cast<unsigned char>( c - 'a' + 'A' ) ); }
+            if ( ICase && c >= 'A' && c <= 'Z' ) { l_res.set( static_cast<unsigned char>( c - 'A' + 'a' ) ); }
+            return l_res;
+        }
+
+        static constexpr int hex( char c ) {
+            if ( c >= '0' && c <= '9' ) return c - '0';
+            if ( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+            if ( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+            throw std::regex_error( std::regex_constants::error_escape );
+        }
+
+        // The character escaped after the '\' at p_pos - 1, -1 for a class (\w, \d...)
+        static constexpr char_result escaped_char( std::size_t p_pos, bool p_in_class ) {
+            const char c = at( p_pos );
+            switch ( c ) {
+                case 'w': case 'W': case 'd': case 'D': case 's': case 'S':
+                          return { -1, p_pos };
+                case 'n': return { '\n', p_pos + 1 };
+                case 'r': return { '\r', p_pos + 1 };
+                case 't': return { '\t', p_pos + 1 };
+                case 'f': return { '\f', p_pos + 1 };
+                case 'v': return { '\v', p_pos + 1 };
+                case '0': return { '\0', p_pos + 1 };
+                case 'x': return { hex( at( p_pos + 1 ) ) * 16 + hex( at( p_pos + 2 ) ), p_pos + 3 };
+                case 'b':
+                    if ( p_in_class ) return { '\b', p_pos + 1 };
+                    throw std::regex_error( std::regex_constants::error_complexity ); // Word boundaries : not supported
+                case '\0':
+                    throw std::regex_error( std::regex_constants::error_escape );
+                default:
+                    if ( ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c >= '0' && c <= '9' ) ) {
+                        throw std::regex_error( std::regex_constants::error_escape ); // Backreferences, unknown classes...
+                    }
+                    return { static_cast<unsigned char>( c ), p_pos + 1 };
+            }
+        }
+
+        // The escape sequence after the '\' at p_pos - 1
+        static constexpr set_result escape( std::size_t p_pos, bool p_in_class ) {
+            const char_result l_char = escaped_char( p_pos, p_in_class );
+            if ( l_char.value >= 0 ) return { literal( static_cast<unsigned char>( l_char.value ) ), l_char.end };
+
+            switch ( at( p_pos ) ) {
+                case 'w': return {  word_set(),  p_pos + 1 };
+                case 'W': return { ~word_set(),  p_pos + 1 };
+                case 'd': return {  digit_set(), p_pos + 1 };
+                case 'D': return { ~digit_set(), p_pos + 1 };
+                case 's': return {  space_set(), p_pos + 1 };
+                default : return { ~space_set(), p_pos + 1 };
+            }
+        }
+
+        // A member of a class at p_pos : its set, and its character (-1 for \w, \d...)
+        static constexpr member_result class_member( std::size_t p_pos ) {
+            const char c = at( p_pos );
+            if ( c == '\0' ) { throw std::regex_error( std::regex_constants::error_brack ); }
+            if ( c != '\\' ) {
+                return { static_cast<unsigned char>( c ), literal( static_cast<unsigned char>( c ) ), p_pos + 1 };
+            }
+            const char_result l_char = escaped_char( p_pos + 1, true );
+            const set_result  l_set  = escape( p_pos + 1, true );
+            return { l_char.value, l_set.set, l_set.end };
+        }
+
+        // The class after the '[' at p_pos - 1, up to the closing ']'
+        static constexpr set_result bracket( std::size_t p_pos ) {
+            char_set   l_res;
+            const bool l_negate = at( p_pos ) == '^';
+            if ( l_negate ) { ++p_pos; }
+
+            while ( at( p_pos ) != ']' ) {
+                const member_result l_first = class_member( p_pos );
+                char_set            l_set   = l_first.set;
+                p_pos = l_first.end;
+
+                // Range a-z or \x00-\x1f (the '-' is literal at the end of the class)
+                if ( l_first.value >= 0 && at( p_pos ) == '-' && at( p_pos + 1 ) != ']' && at( p_pos + 1 ) != '\0' ) {
+                    const member_result l_last = class_member( p_pos + 1 );
+                    if ( l_last.value < l_first.value ) { // Also a class (\w...) as the last bound
+                        throw std::regex_error( std::regex_constants::error_range );
+                    }
+                    for ( int b = l_first.value; b <= l_last.value; ++b ) {
+                        l_set = l_set | literal( static_cast<unsigned char>( b ) );
+                    }
+                    p_pos = l_last.end;
+                }
+                l_res = l_res | l_set;
+            }
+            return { l_negate ? ~l_res : l_res, p_pos + 1 };
+        }
+
+        static constexpr std::size_t digits_end( std::size_t p_pos ) {
+            while ( at( p_pos ) >= '0' && at( p_pos ) <= '9' ) { ++p_pos; }
+            return p_pos;
+        }
+        static constexpr int number( std::size_t p_first, std::size_t p_last ) {
+            if ( p_first == p_last ) { throw std::regex_error( std::regex_constants::error_badbrace ); }
+            int l_res = 0;
+            for ( ; p_first != p_last; ++p_first ) { l_res = l_res * 10 + ( at( p_first ) - '0' ); }
+            return l_res;
+        }
+
+        // {n}, {n,} or {n,m} after the '{' at p_pos - 1
+        static constexpr braces_result braces( std::size_t p_pos ) {
+            const std::size_t l_min_end = digits_end( p_pos );
+            braces_result     l_res { number( p_pos, l_min_end ), 0, l_min_end };
+            l_res.max = l_res.min;
+            if ( at( l_res.end ) == ',' ) {
+                const std::size_t l_max_end = digits_end( l_res.end + 1 );
+                l_res.max = l_max_end == l_res.end + 1 ? INFINITE : number( l_res.end + 1, l_max_end );
+                l_res.end = l_max_end;
+            }
+            if ( at( l_res.end ) != '}' )                             { throw std::regex_error( std::regex_constants::error_brace ); }
+            if ( l_res.max != INFINITE && l_res.max < l_res.min )     { throw std::regex_error( std::regex_constants::error_badbrace ); }
+            ++l_res.end;
+            return l_res;
+        }
+
+        template <std::size_t I>
+        static constexpr auto alternative_() {
+            using first = decltype( concat_<I>() );
+            if constexpr ( at( first::end ) == '|' ) {
+                using rest = decltype( alternative_<first::end + 1>() );
+                using alts = typename as_alternative<typename rest::type>::type;
+                return parsed<typename prepend<typename first::type, alts>::type, rest::end>{};
+            }
+            else {
+                return first{};
+            }
+        }
+
+        template <std::size_t I>
+        static constexpr auto concat_() {
+            if constexpr ( at( I ) == '\0' || at( I ) == '|' || at( I ) == ')' ) {
+                return parsed<sequence<>, I>{};
+            }
+            else {
+                using first = decltype( repeat_<I>() );
+                using rest  = decltype( concat_<first::end>() );
+                using seq   = typename prepend<typename first::type, typename rest::type>::type;
+                return parsed<seq, rest::end>{};
+            }
+        }
+
+        template <std::size_t I>
+        static constexpr auto repeat_() {
+            using atom = decltype( atom_<I>() );
+            constexpr char c = at( atom::end );
+            if      constexpr ( c == '*' ) { return quantified_<0, INFINITE, typename atom::type, atom::end + 1>(); }
+            else if constexpr ( c == '+' ) { return quantified_<1, INFINITE, typename atom::type, atom::end + 1>(); }
+            else if constexpr ( c == '?' ) { return quantified_<0, 1,        typename atom::type, atom::end + 1>(); }
+            else if constexpr ( c == '{' ) {
+                constexpr braces_result l_braces = braces( atom::end + 1 );
+                return quantified_<l_braces.min, l_braces.max, typename atom::type, l_braces.end>();
+            }
+            else {
+                return atom{};
+            }
+        }
+
+        template <int Min, int Max, typename Node, std::size_t J>
+        static constexpr auto quantified_() {
+            constexpr bool        l_greedy = at( J ) != '?';
+            constexpr std::size_t l_end    = l_greedy ? J : J + 1;
+            static_assert( !is_quantifier( at( l_end ) ), "ct_regex : nothing to repeat" );
+            return parsed<repeat<Min, Max, l_greedy, Node>, l_end>{};
+        }
+
+        template <std::size_t I>
+        static constexpr auto atom_() {
+            constexpr char c = at( I );
+            if constexpr ( c == '(' ) {
+                constexpr bool l_non_capturing = at( I + 1 ) == '?' && at( I + 2 ) == ':';
+                static_assert( l_non_capturing || at( I + 1 ) != '?', "ct_regex : lookarounds are not supported" );
+                using inner = decltype( alternative_<l_non_capturing ? I + 3 : I + 1>() );
+                static_assert( at( inner::end ) == ')', "ct_regex : missing ')'" );
+                return parsed<typename simplify<typename inner::type>::type, inner::end + 1>{};
+            }
+            else if constexpr ( c == '[' ) {
+                constexpr set_result l_res = bracket( I + 1 );
+                return leaf<l_res.set.bits[0], l_res.set.bits[1], l_res.set.bits[2], l_res.set.bits[3], l_res.end>();
+            }
+            else if constexpr ( c == '\\' ) {
+                constexpr set_result l_res = escape( I + 1, false );
+                return leaf<l_res.set.bits[0], l_res.set.bits[1], l_res.set.bits[2], l_res.set.bits[3], l_res.end>();
+            }
+            else if constexpr ( c == '.' ) {
+                constexpr char_set l_any = ~( literal( '\n' ) | literal( '\r' ) );
+                return leaf<l_any.bits[0], l_any.bits[1], l_any.bits[2], l_any.bits[3], I + 1>();
+            }
+            else {
+                static_assert( !is_quantifier( c ),  "ct_regex : nothing to repeat" );
+                static_assert( c != '^' && c != '$', "ct_regex : anchors are not supported" );
+                constexpr char_set l_char = literal( static_cast<unsigned char>( c ) );
+                return leaf<l_char.bits[0], l_char.bits[1], l_char.bits[2], l_char.bits[3], I + 1>();
+            }
+        }
+
+        // No class type template parameters in C++17 : the set is passed as its words
+        template <std::uint64_t B0, std::uint64_t B1, std::uint64_t B2, std::uint64_t B3, std::size_t End>
+        static constexpr auto leaf() { return parsed<set<B0, B1, B2, B3>, End>{}; }
+    };
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    /*!
+     * @brief first<Node>
+     *        Bytes that may start a match of Node, and whether it matches "".
+     *        regex::search only tries the positions starting with these bytes.
+     */
+    template <typename Node> struct first;
+
+    template <std::uint64_t B0, std::uint64_t B1, std::uint64_t B2, std::uint64_t B3>
+    struct first<set<B0, B1, B2, B3>> {
+        static constexpr char_set bytes    = set<B0, B1, B2, B3>::value;
+        static constexpr bool     nullable = false;
+    };
+    template <> struct first<sequence<>> {
+        static constexpr char_set bytes    {};
+        static constexpr bool     nullable = true;
+    };
+    template <typename Node, typename... Nodes> struct first<sequence<Node, Nodes...>> {
+        static constexpr char_set bytes    = first<Node>::nullable ? first<Node>::bytes | first<sequence<Nodes...>>::bytes
+                                                                   : first<Node>::bytes;
+        static constexpr bool     nullable = first<Node>::nullable && first<sequence<Nodes...>>::nullable;
+    };
+    template <> struct first<alternative<>> {
+        static constexpr char_set bytes    {};
+        static constexpr bool     nullable = false;
+    };
+    template <typename Node, typename... Nodes> struct first<alternative<Node, Nodes...>> {
+        static constexpr char_set bytes    = first<Node>::bytes | first<alternative<Nodes...>>::bytes;
+        static constexpr bool     nullable = first<Node>::nullable || first<alternative<Nodes...>>::nullable;
+    };
+    template <int Min, int Max, bool Greedy, typename Node> struct first<repeat<Min, Max, Greedy, Node>> {
+        static constexpr char_set bytes    = first<Node>::bytes;
+        static constexpr bool     nullable = Min == 0 || Max == 0 || first<Node>::nullable;
+    };
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    /*!
+     * @brief matcher<Node>
+     *        match( p_it, p_end, p_cont ) matches Node at p_it, then calls the
+     *        continuation p_cont (the rest of the pattern) on the position
+     *        after it. Returns the end of the whole match, nullptr if none :
+     *        a nullptr from p_cont makes the node try its next alternative.
+     */
+    template <typename Node> struct matcher;
+
+    template <std::uint64_t B0, std::uint64_t B1, std::uint64_t B2, std::uint64_t B3>
+    struct matcher<set<B0, B1, B2, B3>>
+    {
+        static constexpr bool contains( char c ) { return set<B0, B1, B2, B3>::value.test( static_cast<unsigned char>( c ) ); }
+
+        template <typename Cont>
+        static const char* match( const char* p_it, const char* p_end, const Cont& p_cont ) {
+            return ( p_it != p_end && contains( *p_it ) ) ? p_cont( p_it + 1 ) : nullptr;
+        }
+    };
+
+    template <> struct matcher<sequence<>>
+    {
+        template <typename Cont>
+        static const char* match( const char* p_it, const char*, const Cont& p_cont ) { return p_cont( p_it ); }
+    };
+
+    template <typename Node, typename... Nodes> struct matcher<sequence<Node, Nodes...>>
+    {
+        template <typename Cont>
+        static const char* match( const char* p_it, const char* p_end, const Cont& p_cont ) {
+            return matcher<Node>::match( p_it, p_end, [p_end, &p_cont]( const char* p_next ) {
+                return matcher<sequence<Nodes...>>::match( p_next, p_end, p_cont );
+            });
+        }
+    };
+
+    template <> struct matcher<alternative<>>
+    {
+        template <typename Cont>
+        static const char* match( const char*, const char*, const Cont& ) { return nullptr; }
+    };
+
+    template <typename Node, typename... Nodes> struct matcher<alternative<Node, Nodes...>>
+    {
+        template <typename Cont>
+        static const char* match( const char* p_it, const char* p_end, const Cont& p_cont ) {
+            if ( const char* l_res = matcher<Node>::match( p_it, p_end, p_cont ) ) return l_res;
+            return matcher<alternative<Nodes...>>::match( p_it, p_end, p_cont );
+        }
+    };
+
+    // Repetition of a character class : the longest run is found with a loop,
+    // then the continuation is tried from each length (longest first if greedy).
+    template <int Min, int Max, bool Greedy, std::uint64_t B0, std::uint64_t B1, std::uint64_t B2, std::uint64_t B3>
+    struct matcher<repeat<Min, Max, Greedy, set<B0, B1, B2, B3>>>
+    {
+        template <typename Cont>
+        static const char* match( const char* p_it, const char* p_end, const Cont& p_cont ) {
+            const char* l_limit = ( Max == INFINITE || p_end - p_it <= Max ) ? p_end : p_it + Max;
+            const char* l_last  = p_it;
+            while ( l_last != l_limit && matcher<set<B0, B1, B2, B3>>::contains( *l_last ) ) { ++l_last; }
+            if ( l_last - p_it < Min ) return nullptr;
+
+            if constexpr ( Greedy ) {
+                for ( const char* l_pos = l_last; ; --l_pos ) {
+                    if ( const char* l_res = p_cont( l_pos ) ) return l_res;
+                    if ( l_pos == p_it + Min ) return nullptr;
+                }
+            }
+            else {
+                for ( const char* l_pos = p_it + Min; ; ++l_pos ) {
+                    if ( const char* l_res = p_cont( l_pos ) ) return l_res;
+                    if ( l_pos == l_last ) return nullptr;
+                }
+            }
+        }
+    };
+
+    // Any other repetition : one recursion per iteration
+    template <int Min, int Max, bool Greedy, typename Node>
+    struct matcher<repeat<Min, Max, Greedy, Node>>
+    {
+        template <typename Cont>
+        static const char* match( const char* p_it, const char* p_end, const Cont& p_cont ) {
+            return step( p_it, p_end, 0, p_cont );
+        }
+
+    private:
+        template <typename Cont>
+        static const char* step( const char* p_it, const char* p_end, int p_count, const Cont& p_cont ) {
+            auto l_more = [&]() -> const char* {
+                if ( Max != INFINITE && p_count >= Max ) return nullptr;
+                return matcher<Node>::match( p_it, p_end, [&]( const char* p_next ) -> const char* {
+                    if ( p_next == p_it && p_count >= Min ) return nullptr; // An empty iteration would loop forever
+                    return step( p_next, p_end, p_count + 1, p_cont );
+                });
+            };
+
+            if ( p_count < Min ) return l_more();
+            if constexpr ( Greedy ) {
+                if ( const char* l_res = l_more() ) return l_res;
+                return p_cont( p_it );
+            }
+            else {
+                if ( const char* l_res = p_cont( p_it ) ) return l_res;
+                return l_more();
+            }
+        }
+    };
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief A regex compiled with the program. It holds no data : every
+ *        member function is static. Only std::regex_constants::icase is
+ *        used in Flags.
+ */
+template <const char* Pattern, std::regex_constants::syntax_option_type Flags = std::regex_constants::ECMAScript>
+class regex
+{
+    using parser = detail::parser<Pattern, ( Flags & std::regex_constants::icase ) != std::regex_constants::syntax_option_type{}>;
+    using result = decltype( parser::template alternative_<0>() );
+    static_assert( result::end == parser::N, "ct_regex : unmatched ')'" );
+
+public:
+    /*!
+     * @brief The syntax tree of the pattern.
+     */
+    using ast = typename result::type;
+
+    /*!
+     * @brief True if the whole p_text matches (std::regex_match).
+     */
+    static bool match( std::string_view p_text )
+    {
+        p_text = not_null( p_text );
+        const char* l_end = p_text.data() + p_text.size();
+        return detail::matcher<ast>::match( p_text.data(), l_end, [l_end]( const char* p_pos ) {
+            return p_pos == l_end ? p_pos : nullptr;
+        }) != nullptr;
+    }
+
+    /*!
+     * @brief First match in p_text, starting from p_from (std::regex_search).
+     */
+    static std::optional<std::string_view> search( std::string_view p_text, std::size_t p_from = 0 )
+    {
+        if ( p_from > p_text.size() ) return std::nullopt;
+
+        p_text = not_null( p_text );
+        const char* l_end = p_text.data() + p_text.size();
+        for ( const char* l_it = p_text.data() + p_from; ; ++l_it ) {
+            if constexpr ( !detail::first<ast>::nullable ) { // Skips the bytes that cannot start a match
+                l_it = std::find_if( l_it, l_end, []( char c ) {
+                    return detail::first<ast>::bytes.test( static_cast<unsigned char>( c ) );
+                });
+            }
+            const char* l_res = detail::matcher<ast>::match( l_it, l_end, []( const char* p_pos ) { return p_pos; } );
+            if ( l_res )          return std::string_view( l_it, static_cast<std::size_t>( l_res - l_it ) );
+            if ( l_it == l_end )  return std::nullopt;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    /*!
+     * @brief match_iterator
+     *        Forward iterator over the successive non overlapping
+     *        matches of a text (std::regex_iterator).
+     */
+    class match_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::string_view;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const std::string_view*;
+        using reference         = const std::string_view&;
+
+        match_iterator() = default;
+        explicit match_iterator( std::string_view p_text ) : m_text( not_null( p_text ) ) { find( 0 ); }
+
+        reference operator* () const { return m_match; }
+        pointer   operator->() const { return &m_match; }
+
+        match_iterator& operator++() {
+            const std::size_t l_end = static_cast<std::size_t>( m_match.data() - m_text.data() ) + m_match.size();
+            if ( !m_match.empty() ) { find( l_end ); return *this; }
+
+            // After an empty match, std::regex_iterator looks for a non empty one at the same position
+            const char* l_pos  = m_text.data() + l_end;
+            const char* l_last = m_text.data() + m_text.size();
+            const char* l_res  = l_pos == l_last ? nullptr : detail::matcher<ast>::match( l_pos, l_last, [l_pos]( const char* p_pos ) {
+                return p_pos != l_pos ? p_pos : nullptr;
+            });
+            if ( l_res ) { m_match = std::string_view( l_pos, static_cast<std::size_t>( l_res - l_pos ) ); }
+            else         { find( l_end + 1 ); }
+            return *this;
+        }
+        match_iterator operator++(int) { match_iterator tmp{*this}; ++(*this); return tmp; }
+
+        bool operator==( const match_iterator& o ) const { return m_match.data() == o.m_match.data(); }
+        bool operator!=( const match_iterator& o ) const { return !this->operator==(o); }
+
+    private:
+        void find( std::size_t p_from ) {
+            const auto l_res = regex::search( m_text, p_from );
+            if ( l_res ) { m_match = *l_res; }
+            else         { *this = match_iterator(); }
+        }
+
+        std::string_view m_text;
+        std::string_view m_match;
+    };
+
+    struct match_range {
+        match_iterator first, last;
+        match_iterator begin() const { return first; }
+        match_iterator end  () const { return last;  }
+    };
+
+    /*!
+     * @brief Every match of p_text, for range-based for loops and algorithms.
+     */
+    static match_range matches( std::string_view p_text ) { return { match_iterator( p_text ), match_iterator() }; }
+
+private:
+    // The matchers return nullptr when there is no match : a match can not end at p_text.data()
+    static std::string_view not_null( std::string_view p_text ) { return p_text.data() ? p_text : std::string_view( "", 0 ); }
+};
+
+} // namespace ct_regex
+
+#endif // CT_REGEX_HPP
@@ -0,0 +1,860 @@
+#ifndef LAZY_DFA_HPP
+#define LAZY_DFA_HPP
+
+/*!
+ * @brief lazy_dfa::regex
+ *        std::regex is a backtracking engine : each position of the input
+ *        may be visited many times, through many function calls.
+ *        Here the pattern is compiled into a NFA (Thompson construction),
+ *        whose sets of active states are the states of a DFA : one table
+ *        lookup per input byte. The DFA states are only built when the
+ *        input reaches them (lazily), so the (potentially exponential)
+ *        powerset construction is never done upfront.
+ *
+ *        The transition table is compressed with byte classes : bytes
+ *        that no part of the pattern tells apart (e.g. every letter for
+ *        \w+) share a column.
+ *
+ *        Supported subset (ECMAScript syntax) :
+ *          - literals, '.', escapes (\w \W \d \D \s \S \n \t \xHH ...)
+ *          - classes [a-z_], negated classes [^...]
+ *          - quantifiers * + ? {n} {n,} {n,m} (a trailing '?' is accepted)
+ *          - alternation |, groups (...) and (?:...)
+ *          - std::regex_constants::icase
+ *        Anchors, backreferences and lookarounds are not (std::regex_error).
+ *
+ *        Differences with std::regex :
+ *          - matches are leftmost-longest (POSIX), not leftmost-first :
+ *            "a|ab" matches "ab" in "ab". For the usual patterns (\w+,
+ *            literals, greedy repetitions of a class) both are the same.
+ *          - groups only group : the match is reported as a whole.
+ *          - the DFA cache is built by the const member functions : a
+ *            regex must not be shared between threads (copy it instead).
+ *
+ * More infos here :
+ *   - "Regular Expression Matching Can Be Simple And Fast", R. Cox (2007)
+ *   - "Regular Expression Matching in the Wild", R. Cox (2010)
+ */
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <regex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace lazy_dfa {
+
+namespace detail {
+
+    using byte_set = std::bitset<256>;
+
+    constexpr int INFINITE { -1 };
+
+    /*!
+     * @brief Abstract syntax tree of the pattern.
+     */
+    struct node
+    {
+        enum class type { empty, set, concat, alternate, repeat };
+
+        type              kind { type::empty };
+        byte_set          set;               /*!< type::set             */
+        std::vector<node> children;          /*!< concat, alternate     */
+        int               min  { 0 };        /*!< repeat : children[0]  */
+        int               max  { 0 };        /*!< INFINITE if unbounded */
+    };
+
+    inline byte_set range( unsigned char p_first, unsigned char p_last ) {
+        byte_set l_res;
+        for ( unsigned c = p_first; c <= p_last; ++c ) { l_res.set( c ); }
+        return l_res;
+    }
+    inline byte_set word_set () { return range( 'a', 'z' ) | range( 'A', 'Z' ) | range( '0', '9' ) | range( '_', '_' ); }
+    inline byte_set digit_set() { return range( '0', '9' ); }
+    inline byte_set space_set() { return range( '\t', '\r' ) | range( ' ', ' ' ); }
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    /*!
+     * @brief parser
+     *        Recursive descent parser :
+     *            alternate := concat ( '|' concat )*
+     *            concat    := repeat*
+     *            repeat    := atom [ quantifier ]
+     *            atom      := '(' [ '?:' ] alternate ')' | '[' class ']' | '.' | escape | literal
+     */
+    class parser
+    {
+    public:
+        parser( std::string_view p_pattern, bool p_icase ) : m_pattern( p_pattern ), m_icase( p_icase ) {}
+
+        node parse()
+        {
+            node l_res = alternate();
+            if ( m_pos != m_pattern.size() ) { throw std::regex_error( std::regex_constants::error_paren ); }
+            return l_res;
+        }
+
+    private:
+        bool at_end() const { return m_pos >= m_pattern.size(); }
+        char peek  () const { return m_pattern[m_pos]; }
+
+        node alternate()
+        {
+            node l_first = concat();
+            if ( at_end() || peek() != '|' ) return l_first;
+
+            node l_res;
+            l_res.kind = node::type::alternate;
+            l_res.children.push_back( std::move( l_first ) );
+            while ( !at_end() && peek() == '|' ) {
+                ++m_pos;
+                l_res.children.push_back( concat() );
+            }
+            return l_res;
+        }
+
+        node concat()
+        {
+            node l_res;
+            l_res.kind = node::type::concat;
+            while ( !at_end() && peek() != '|' && peek() != ')' ) { l_res.children.push_back( repeat() ); }
+            return l_res;
+        }
+
+        node repeat()
+        {
+            node l_atom = atom();
+            if ( at_end() ) return l_atom;
+
+            int l_min = 0, l_max = 0;
+            switch ( peek() ) {
+                case '*': l_min = 0; l_max = INFINITE; ++m_pos; break;
+                case '+': l_min = 1; l_max = INFINITE; ++m_pos; break;
+                case '?': l_min = 0; l_max = 1;        ++m_pos; break;
+                case '{': braces( l_min, l_max );               break;
+                default : return l_atom;
+            }
+            if ( !at_end() && peek() == '?' ) { ++m_pos; } // Lazy quantifier : same language
+            if ( !at_end() && ( peek() == '*' || peek() == '+' || peek() == '?' || peek() == '{' ) ) {
+                throw std::regex_error( std::regex_constants::error_badrepeat );
+            }
+
+            node l_res;
+            l_res.kind = node::type::repeat;
+            l_res.min  = l_min;
+            l_res.max  = l_max;
+            l_res.children.push_back( std::move( l_atom ) );
+            return l_res;
+        }
+
+        // {n}, {n,} or {n,m}
+        void braces( int& p_min, int& p_max )
+        {
+            ++m_pos;
+            p_min = number();
+            p_max = p_min;
+            if ( !at_end() && peek() == ',' ) {
+                ++m_pos;
+                p_max = ( !at_end() && peek() == '}' ) ? INFINITE : number();
+            }
+            if ( at_end() || peek() != '}' )              { throw std::regex_error( std::regex_constants::error_brace ); }
+            if ( p_max != INFINITE && p_max < p_min )     { throw std::regex_error( std::regex_constants::error_badbrace ); }
+            ++m_pos;
+        }
+
+        int number()
+        {
+            if ( at_end() || peek() < '0' || peek() > '9' ) { throw std::regex_error( std::regex_constants::error_badbrace ); }
+            int l_res = 0;
+            while ( !at_end() && peek() >= '0' && peek() <= '9' ) {
+                l_res = l_res * 10 + ( m_pattern[m_pos++] - '0' );
+                if ( l_res > MAX_COUNT ) { throw std::regex_error( std::regex_constants::error_complexity ); }
+            }
+            return l_res;
+        }
+
+        node atom()
+        {
+            if ( at_end() ) { throw std::regex_error( std::regex_constants::error_badrepeat ); }
+
+            const char c = m_pattern[m_pos++];
+            switch ( c ) {
+                case '(': {
+                    if ( m_pattern.substr( m_pos, 2 ) == "?:" ) { m_pos += 2; }
+                    else if ( !at_end() && peek() == '?' )      { throw std::regex_error( std::regex_constants::error_complexity ); }
+                    node l_res = alternate();
+                    if ( at_end() || peek() != ')' ) { throw std::regex_error( std::regex_constants::error_paren ); }
+                    ++m_pos;
+                    return l_res;
+                }
+                case ')': throw std::regex_error( std::regex_constants::error_paren );
+                case '*': case '+': case '?': case '{':
+                          throw std::regex_error( std::regex_constants::error_badrepeat );
+                case '^': case '$':
+                          throw std::regex_error( std::regex_constants::error_complexity ); // Anchors : not supported
+                case '[': return leaf( bracket() );
+                case '.': return leaf( ~( range( '\n', '\n' ) | range( '\r', '\r' ) ) );
+                case '\\': return leaf( escape( false ) );
+                default : return leaf( literal( static_cast<unsigned char>( c ) ) );
+            }
+        }
+
+        node leaf( const byte_set& p_set ) const
+        {
+            node l_res;
+            l_res.kind = node::type::set;
+            l_res.set  = p_set;
+            return l_res;
+        }
+
+        byte_set literal( unsigned char p_char ) const
+        {
+            byte_set l_res;
+            l_res.set( p_char );
+            if ( m_icase && p_char >= 'a' && p_char <= 'z' ) { l_res.set( p_char - 'a' + 'A' ); }
+            if ( m_icase && p_char >= 'A' && p_char <= 'Z' ) { l_res.set( p_char - 'A' + 'a' ); }
+            return l_res;
+        }
+
+        // After a '\' : the escaped character, std::nullopt (not consumed) for a class (\w, \d...)
+        std::optional<unsigned char> escaped_char( bool p_in_class )
+        {
+            if ( at_end() ) { throw std::regex_error( std::regex_constants::error_escape ); }
+
+            const char c = m_pattern[m_pos];
+            switch ( c ) {
+                case 'w': case 'W': case 'd': case 'D': case 's': case 'S':
+                          return std::nullopt;
+                default : break;
+            }
+
+            ++m_pos;
+            switch ( c ) {
+                case 'n': return '\n';
+                case 'r': return '\r';
+                case 't': return '\t';
+                case 'f': return '\f';
+                case 'v': return '\v';
+                case '0': return '\0';
+                case 'x': {
+                    int l_value = 0;
+                    for ( int i = 0; i < 2; ++i ) {
+                        if ( at_end() || !std::isxdigit( static_cast<unsigned char>( peek() ) ) ) {
+                            throw std::regex_error( std::regex_constants::error_escape );
+                        }
+                        const char h = m_pattern[m_pos++];
+                        l_value = l_value * 16 + ( h <= '9' ? h - '0' : ( h | 0x20 ) - 'a' + 10 );
+                    }
+                    return static_cast<unsigned char>( l_value );
+                }
+                case 'b':
+                    if ( p_in_class ) { return '\b'; }
+                    throw std::regex_error( std::regex_constants::error_complexity ); // Word boundaries : not supported
+                default:
+                    if ( std::isalnum( static_cast<unsigned char>( c ) ) ) { // Backreferences, unknown classes...
+                        throw std::regex_error( std::regex_constants::error_escape );
+                    }
+                    return static_cast<unsigned char>( c );
+            }
+        }
+
+        // After a '\' : the escaped character (or class)
+        byte_set escape( bool p_in_class )
+        {
+            if ( const auto l_char = escaped_char( p_in_class ) ) { return literal( *l_char ); }
+
+            switch ( m_pattern[m_pos++] ) {
+                case 'w': return  word_set();
+                case 'W': return ~word_set();
+                case 'd': return  digit_set();
+                case 'D': return ~digit_set();
+                case 's': return  space_set();
+                default : return ~space_set();
+            }
+        }
+
+        // A member of a class : its set, and its character unless it is a class (\w, \d...)
+        std::optional<unsigned char> class_member( byte_set& p_set )
+        {
+            const char c = m_pattern[m_pos++];
+            if ( c != '\\' ) {
+                p_set = literal( static_cast<unsigned char>( c ) );
+                return static_cast<unsigned char>( c );
+            }
+            const auto l_char = escaped_char( true );
+            p_set = l_char ? literal( *l_char ) : escape( true );
+            return l_char;
+        }
+
+        // After a '[' : the class up to the closing ']'
+        byte_set bracket()
+        {
+            byte_set l_res;
+            const bool l_negate = !at_end() && peek() == '^';
+            if ( l_negate ) { ++m_pos; }
+
+            while ( !at_end() && peek() != ']' ) {
+                byte_set   l_first;
+                const auto l_low = class_member( l_first );
+
+                // Range a-z or \x00-\x1f (the '-' is literal at the end of the class)
+                if ( l_low && m_pos + 1 < m_pattern.size() && peek() == '-' && m_pattern[m_pos + 1] != ']' ) {
+                    ++m_pos;
+                    byte_set   l_unused;
+                    const auto l_high = class_member( l_unused );
+                    if ( !l_high || *l_high < *l_low ) {
+                        throw std::regex_error( std::regex_constants::error_range );
+                    }
+                    for ( unsigned b = *l_low; b <= *l_high; ++b ) {
+                        l_first |= literal( static_cast<unsigned char>( b ) );
+                    }
+                }
+                l_res |= l_first;
+            }
+            if ( at_end() ) { throw std::regex_error( std::regex_constants::error_brack ); }
+            ++m_pos;
+
+            return l_negate ? ~l_res : l_res;
+        }
+
+        static constexpr int MAX_COUNT { 1000 }; // Biggest {n,m} bound
+
+        std::string_view m_pattern;
+        std::size_t      m_pos { 0 };
+        bool             m_icase;
+    };
+
+    // The same pattern, read from right to left
+    inline node reversed( node p_node )
+    {
+        for ( auto& l_child : p_node.children ) { l_child = reversed( std::move( l_child ) ); }
+        if ( p_node.kind == node::type::concat ) { std::reverse( std::begin(p_node.children), std::end(p_node.children) ); }
+        return p_node;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    /*!
+     * @brief nfa
+     *        Thompson NFA : each state either consumes a byte of a set,
+     *        or splits into two epsilon transitions, or accepts.
+     */
+    struct nfa
+    {
+        enum class type : std::uint8_t { consume, split, accept };
+
+        struct state {
+            type kind;
+            int  set;     /*!< consume : index in m_sets                */
+            int  out;     /*!< consume, split : next state (-1 : none)  */
+            int  out1;    /*!< split : second next state (-1 : none)    */
+        };
+
+        std::vector<state>    states;
+        std::vector<byte_set> sets;   /*!< Distinct sets of the consume states */
+        int                   start { -1 };
+    };
+
+    /*!
+     * @brief Builds the NFA of a syntax tree.
+     *        A fragment is a start state and the list of its dangling exits.
+     */
+    class nfa_builder
+    {
+    public:
+        nfa build( const node& p_root )
+        {
+            fragment l_frag = compile( p_root );
+            const int l_accept = add( { nfa::type::accept, -1, -1, -1 } );
+            patch( l_frag, l_accept );
+            m_nfa.start = l_frag.start < 0 ? l_accept : l_frag.start;
+            return std::move( m_nfa );
+        }
+
+    private:
+        struct exit { int state; bool second; };
+        struct fragment {
+            int               start { -1 }; /*!< -1 : empty fragment (matches "") */
+            std::vector<exit> exits;
+        };
+
+        static constexpr std::size_t MAX_STATES { 1 << 16 };
+
+        int add( const nfa::state& p_state )
+        {
+            if ( m_nfa.states.size() >= MAX_STATES ) { throw std::regex_error( std::regex_constants::error_complexity ); }
+            m_nfa.states.push_back( p_state );
+            return static_cast<int>( m_nfa.states.size() ) - 1;
+        }
+
+        int set_index( const byte_set& p_set )
+        {
+            const auto l_it = m_set_ids.try_emplace( p_set, static_cast<int>( m_nfa.sets.size() ) );
+            if ( l_it.second ) { m_nfa.sets.push_back( p_set ); }
+            return l_it.first->second;
+        }
+
+        void patch( const fragment& p_frag, int p_target )
+        {
+            for ( const auto& l_exit : p_frag.exits ) {
+                ( l_exit.second ? m_nfa.states[l_exit.state].out1 : m_nfa.states[l_exit.state].out ) = p_target;
+            }
+        }
+
+        // p_first then p_second
+        fragment sequence( fragment p_first, fragment p_second )
+        {
+            if ( p_first .start < 0 ) return p_second;
+            if ( p_second.start < 0 ) return p_first;
+            patch( p_first, p_second.start );
+            p_first.exits = std::move( p_second.exits );
+            return p_first;
+        }
+
+        // p_frag or nothing (p_loop : loops back to p_frag)
+        fragment optional( fragment p_frag, bool p_loop )
+        {
+            if ( p_frag.start < 0 ) return p_frag;
+            const int l_split = add( { nfa::type::split, -1, p_frag.start, -1 } );
+            if ( p_loop ) { patch( p_frag, l_split ); p_frag.exits.clear(); }
+            p_frag.start = l_split;
+            p_frag.exits.push_back( { l_split, true } );
+            return p_frag;
+        }
+
+        fragment compile( const node& p_node )
+        {
+            switch ( p_node.kind ) {
+                case node::type::empty: return {};
+                case node::type::set: {
+                    const int l_state = add( { nfa::type::consume, set_index( p_node.set ), -1, -1 } );
+                    return { l_state, { { l_state, false } } };
+                }
+                case node::type::concat: {
+                    fragment l_res;
+                    for ( const auto& l_child : p_node.children ) { l_res = sequence( std::move( l_res ), compile( l_child ) ); }
+                    return l_res;
+                }
+                case node::type::alternate: {
+                    fragment l_res = compile( p_node.children.front() );
+                    for ( std::size_t i = 1; i < p_node.children.size(); ++i ) {
+                        fragment l_alt = compile( p_node.children[i] );
+                        if ( l_res.start < 0 ) { std::swap( l_res, l_alt ); }
+                        if ( l_alt.start < 0 ) { l_res = optional( std::move( l_res ), false ); continue; }
+
+                        const int l_split = add( { nfa::type::split, -1, l_res.start, l_alt.start } );
+                        l_res.start = l_split;
+                        l_res.exits.insert( std::end(l_res.exits), std::begin(l_alt.exits), std::end(l_alt.exits) );
+                    }
+                    return l_res;
+                }
+                case node::type::repeat: {
+                    // x{n,m} : n copies of x, then (m - n) nested optional copies
+                    //          x(x(x)?)? or x* when unbounded
+                    const node& l_child = p_node.children.front();
+                    fragment    l_res;
+                    for ( int i = 0; i < p_node.min; ++i ) { l_res = sequence( std::move( l_res ), compile( l_child ) ); }
+
+                    if ( p_node.max == INFINITE ) {
+                        return sequence( std::move( l_res ), optional( compile( l_child ), true ) );
+                    }
+                    fragment l_tail;
+                    for ( int i = p_node.min; i < p_node.max; ++i ) {
+                        l_tail = optional( sequence( compile( l_child ), std::move( l_tail ) ), false );
+                    }
+                    return sequence( std::move( l_res ), std::move( l_tail ) );
+                }
+            }
+            return {};
+        }
+
+        nfa                                   m_nfa;
+        std::unordered_map<byte_set, int>     m_set_ids;
+    };
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    /*!
+     * @brief dfa
+     *        Lazily built DFA over the byte classes of a nfa.
+     *        The state 0 is the dead state (no NFA state left).
+     *        In unanchored mode, the NFA start state is added after each
+     *        step as a new group : a match may start anywhere. A DFA state
+     *        is the list of the groups, earliest start first, an NFA state
+     *        only being kept in the earliest group that reaches it. Once a
+     *        group accepts, the later ones are dropped and no group is
+     *        started anymore : the last accepting position is the end of
+     *        the leftmost-longest match.
+     */
+    class dfa
+    {
+    public:
+        static constexpr int DEAD      {  0 };
+        static constexpr int UNKNOWN   { -1 };
+        static constexpr int SEPARATOR { -1 }; /*!< Ends each group of a DFA state   */
+        static constexpr int MATCHED   { -2 }; /*!< Last of a DFA state : no restart */
+
+        dfa( const nfa& p_nfa, const std::array<std::uint8_t, 256>& p_classes, int p_nb_classes,
+             const std::vector<unsigned char>& p_representatives, bool p_unanchored ) :
+            m_nfa( &p_nfa ), m_classes( p_classes ), m_representatives( &p_representatives ),
+            m_nb_classes( p_nb_classes ), m_unanchored( p_unanchored ),
+            m_marks( p_nfa.states.size(), 0 )
+        {
+            reset();
+        }
+
+        int  start    ()                 const { return m_start; }
+        bool accepting( int p_state )    const { return m_accepting[p_state] != 0; }
+        std::size_t size()               const { return m_accepting.size(); }
+
+        /*!
+         * @brief Runs the DFA over [p_first, p_last) from its start state.
+         *        Returns the end of the longest match, nullptr if there is none.
+         *        The hot loop : one class lookup and one transition per byte.
+         *        The transitions hold the offset of the next state row (no
+         *        multiplication), shifted left, with its accepting flag.
+         */
+        const char* run( const char* p_first, const char* p_last )
+        {
+            int         l_state = encode( m_start );
+            const char* l_end   = ( l_state & 1 ) ? p_first : nullptr;
+
+            const int* l_table = m_next.data();
+            for ( ; p_first != p_last; ++p_first ) {
+                l_state = next( l_table, l_state, *p_first );
+                if ( l_state & 1 )          l_end = p_first + 1;
+                else if ( l_state == DEAD ) break;
+            }
+            return l_end;
+        }
+
+        /*!
+         * @brief Runs the DFA over [p_first, p_last) backwards, from p_last.
+         *        Returns the start of the longest match, nullptr if there is none.
+         */
+        const char* run_backward( const char* p_first, const char* p_last )
+        {
+            int         l_state = encode( m_start );
+            const char* l_start = ( l_state & 1 ) ? p_last : nullptr;
+
+            const int* l_table = m_next.data();
+            while ( p_last != p_first ) {
+                l_state = next( l_table, l_state, *--p_last );
+                if ( l_state & 1 )          l_start = p_last;
+                else if ( l_state == DEAD ) break;
+            }
+            return l_start;
+        }
+
+    private:
+        static constexpr std::size_t MAX_DFA_STATES { 1 << 12 }; // The cache is flushed past that
+
+        int encode( int p_state ) const { return ( p_state * m_nb_classes ) << 1 | m_accepting[p_state]; }
+
+        // Encoded transition of p_state on p_byte, built if unknown (p_table is reloaded)
+        int next( const int*& p_table, int p_state, char p_byte )
+        {
+            const int l_cls  = m_classes[static_cast<unsigned char>( p_byte )];
+            const int l_next = p_table[( p_state >> 1 ) + l_cls];
+            if ( l_next != UNKNOWN ) return l_next;
+
+            const int l_built = encode( build( ( p_state >> 1 ) / m_nb_classes, l_cls ) );
+            p_table = m_next.data(); // Reallocated
+            return l_built;
+        }
+
+        struct vector_hash {
+            std::size_t operator()( const std::vector<int>& p_vec ) const {
+                std::size_t l_res = p_vec.size();
+                for ( const int v : p_vec ) { l_res = ( l_res ^ static_cast<std::size_t>( v ) ) * 0x100000001B3ull; }
+                return l_res;
+            }
+        };
+
+        void reset()
+        {
+            m_sets.clear();
+            m_ids.clear();
+            m_next.clear();
+            m_accepting.clear();
+
+            intern( {} ); // DEAD
+            std::vector<int> l_start;
+            if ( ++m_generation == 0 ) { std::fill( std::begin(m_marks), std::end(m_marks), 0 ); m_generation = 1; }
+            closure_more( m_nfa->start, l_start );
+            if ( end_group( l_start, 0 ) && m_unanchored ) { l_start.push_back( MATCHED ); }
+            m_start = intern( l_start );
+        }
+
+        // Sorts the group p_set[p_begin..] and ends it if it is not empty. True if it accepts.
+        bool end_group( std::vector<int>& p_set, std::size_t p_begin ) const
+        {
+            if ( p_begin == p_set.size() ) return false;
+            std::sort( std::begin(p_set) + p_begin, std::end(p_set) );
+            const bool l_accepts = std::any_of( std::begin(p_set) + p_begin, std::end(p_set), [this]( int s ) {
+                return m_nfa->states[s].kind == nfa::type::accept;
+            });
+            p_set.push_back( SEPARATOR );
+            return l_accepts;
+        }
+
+        // Adds to p_set the consuming / accepting states reachable from p_state (epsilon closure),
+        // that are not already in it since the last new generation
+        void closure_more( int p_state, std::vector<int>& p_set )
+        {
+            m_stack.push_back( p_state );
+            while ( !m_stack.empty() ) {
+                const int l_state = m_stack.back();
+                m_stack.pop_back();
+                if ( l_state < 0 || m_marks[l_state] == m_generation ) continue;
+                m_marks[l_state] = m_generation;
+
+                const auto& l_nfa_state = m_nfa->states[l_state];
+                if ( l_nfa_state.kind == nfa::type::split ) {
+                    m_stack.push_back( l_nfa_state.out1 );
+                    m_stack.push_back( l_nfa_state.out );
+                }
+                else {
+                    p_set.push_back( l_state );
+                }
+            }
+        }
+
+        int intern( const std::vector<int>& p_set )
+        {
+            const auto l_it = m_ids.try_emplace( p_set, static_cast<int>( m_sets.size() ) );
+            if ( l_it.second ) {
+                m_sets.push_back( p_set );
+                m_next.resize( m_next.size() + m_nb_classes, UNKNOWN );
+                m_accepting.push_back( std::any_of( std::begin(p_set), std::end(p_set), [this]( int s ) {
+                    return s >= 0 && m_nfa->states[s].kind == nfa::type::accept;
+                }) ? 1 : 0 );
+            }
+            return l_it.first->second;
+        }
+
+        int build( int p_state, int p_cls )
+        {
+            const unsigned char l_byte = (*m_representatives)[p_cls];
+
+            const auto& l_set     = m_sets[p_state];
+            const bool  l_matched = !l_set.empty() && l_set.back() == MATCHED;
+            bool        l_accepts = false;
+
+            std::vector<int> l_next;
+            std::size_t      l_group = 0;
+            if ( ++m_generation == 0 ) { std::fill( std::begin(m_marks), std::end(m_marks), 0 ); m_generation = 1; }
+            for ( const int l_state : l_set ) {
+                if ( l_state == MATCHED ) break;
+                if ( l_state == SEPARATOR ) {
+                    l_accepts = end_group( l_next, l_group );
+                    if ( l_accepts ) break; // The later groups start after this match
+                    l_group = l_next.size();
+                    continue;
+                }
+                const auto& l_nfa_state = m_nfa->states[l_state];
+                if ( l_nfa_state.kind == nfa::type::consume && m_nfa->sets[l_nfa_state.set].test( l_byte ) ) {
+                    closure_more( l_nfa_state.out, l_next );
+                }
+            }
+            if ( m_unanchored && !l_matched && !l_accepts ) {
+                closure_more( m_nfa->start, l_next );
+                l_accepts = end_group( l_next, l_group );
+            }
+            if ( m_unanchored && ( l_matched || l_accepts ) && !l_next.empty() ) { l_next.push_back( MATCHED ); }
+
+            if ( m_sets.size() >= MAX_DFA_STATES ) { // Flush : p_state is not used by the caller anymore
+                reset();
+                return intern( l_next );
+            }
+
+            const int l_id = intern( l_next );
+            m_next[static_cast<std::size_t>( p_state ) * m_nb_classes + p_cls] = encode( l_id );
+            return l_id;
+        }
+
+        const nfa*                                m_nfa;
+        const std::array<std::uint8_t, 256>       m_classes;   /*!< Copied : used by the hot loop */
+        const std::vector<unsigned char>*         m_representatives;
+        int                                       m_nb_classes;
+        bool                                      m_unanchored;
+
+        std::vector<std::vector<int>>                              m_sets;      /*!< NFA states (groups) of each DFA state */
+        std::unordered_map<std::vector<int>, int, vector_hash>     m_ids;
+        std::vector<int>                                           m_next;      /*!< states x classes transitions (encoded) */
+        std::vector<std::uint8_t>                                  m_accepting;
+        int                                                        m_start { DEAD };
+
+        std::vector<unsigned>                                      m_marks;     /*!< Visited NFA states (closures) */
+        unsigned                                                   m_generation { 0 };
+        std::vector<int>                                           m_stack;
+    };
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+class regex
+{
+public:
+    using flag_type = std::regex_constants::syntax_option_type;
+
+    /*!
+     * @brief Compiles p_pattern, throws std::regex_error if it is invalid
+     *        or not supported. Only std::regex_constants::icase is used in p_flags.
+     */
+    explicit regex( std::string_view p_pattern, flag_type p_flags = std::regex_constants::ECMAScript ) :
+        regex( detail::parser( p_pattern, ( p_flags & std::regex_constants::icase ) != flag_type{} ).parse() ) {}
+
+    regex( const regex& p_other ) :
+        m_nfa( p_other.m_nfa ), m_reversed_nfa( p_other.m_reversed_nfa ), m_classes( p_other.m_classes ),
+        m_nb_classes( p_other.m_nb_classes ), m_representatives( p_other.m_representatives )
+    {
+        create_dfas();
+    }
+    regex& operator=( const regex& ) = delete;
+
+    /*!
+     * @brief Number of byte classes (columns of the transition tables).
+     */
+    int         nb_classes() const { return m_nb_classes; }
+    std::size_t nfa_size  () const { return m_nfa.states.size(); }
+    std::size_t dfa_size  () const { return m_anchored->size() + m_unanchored->size() + m_reversed->size(); }
+
+    /*!
+     * @brief True if the whole p_text matches (std::regex_match).
+     */
+    bool match( std::string_view p_text ) const
+    {
+        p_text = not_null( p_text );
+        const char* l_last = p_text.data() + p_text.size();
+        return m_anchored->run( p_text.data(), l_last ) == l_last;
+    }
+
+    /*!
+     * @brief Leftmost-longest match in p_text, starting from p_from (std::regex_search).
+     *        Two passes, each byte being read at most once by each :
+     *        1 - the unanchored DFA finds the end of the leftmost-longest match
+     *        2 - the DFA of the reversed pattern runs backwards from that end,
+     *            down to p_from : its longest match gives the leftmost start.
+     */
+    std::optional<std::string_view> search( std::string_view p_text, std::size_t p_from = 0 ) const
+    {
+        if ( p_from > p_text.size() ) return std::nullopt;
+
+        p_text = not_null( p_text );
+        const char* l_first = p_text.data() + p_from;
+        const char* l_end   = m_unanchored->run( l_first, p_text.data() + p_text.size() );
+        if ( !l_end ) return std::nullopt;
+
+        const char* l_start = m_reversed->run_backward( l_first, l_end );
+        return std::string_view( l_start, static_cast<std::size_t>( l_end - l_start ) );
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////
+    /*!
+     * @brief match_iterator
+     *        Forward iterator over the successive non overlapping
+     *        matches of a text (std::regex_iterator).
+     */
+    class match_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::string_view;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const std::string_view*;
+        using reference         = const std::string_view&;
+
+        match_iterator() = default;
+        match_iterator( const regex& p_regex, std::string_view p_text ) : m_regex( &p_regex ), m_text( not_null( p_text ) ) { find( 0 ); }
+
+        reference operator* () const { return m_match; }
+        pointer   operator->() const { return &m_match; }
+
+        match_iterator& operator++() {
+            const std::size_t l_end = static_cast<std::size_t>( m_match.data() - m_text.data() ) + m_match.size();
+            find( m_match.empty() ? l_end + 1 : l_end ); // An empty match does not stop the iteration
+            return *this;
+        }
+        match_iterator operator++(int) { match_iterator tmp{*this}; ++(*this); return tmp; }
+
+        bool operator==( const match_iterator& o ) const { return m_regex == o.m_regex && m_match.data() == o.m_match.data(); }
+        bool operator!=( const match_iterator& o ) const { return !this->operator==(o); }
+
+    private:
+        void find( std::size_t p_from ) {
+            const auto l_res = m_regex->search( m_text, p_from );
+            if ( l_res ) { m_match = *l_res; }
+            else         { *this = match_iterator(); }
+        }
+
+        const regex*     m_regex { nullptr };
+        std::string_view m_text;
+        std::string_view m_match;
+    };
+
+    struct match_range {
+        match_iterator first, last;
+        match_iterator begin() const { return first; }
+        match_iterator end  () const { return last;  }
+    };
+
+    /*!
+     * @brief Every match of p_text, for range-based for loops and algorithms.
+     */
+    match_range matches( std::string_view p_text ) const { return { match_iterator( *this, p_text ), match_iterator() }; }
+
+private:
+    // run() returns nullptr when there is no match : a match can not end at p_text.data()
+    static std::string_view not_null( std::string_view p_text ) { return p_text.data() ? p_text : std::string_view( "", 0 ); }
+
+    explicit regex( const detail::node& p_tree ) :
+        m_nfa( detail::nfa_builder().build( p_tree ) ),
+        m_reversed_nfa( detail::nfa_builder().build( detail::reversed( p_tree ) ) )
+    {
+        compute_classes();
+        create_dfas();
+    }
+
+    // The reversed NFA has the same sets : the byte classes are shared
+    void create_dfas()
+    {
+        m_anchored  .emplace( m_nfa,          m_classes, m_nb_classes, m_representatives, false );
+        m_unanchored.emplace( m_nfa,          m_classes, m_nb_classes, m_representatives, true  );
+        m_reversed  .emplace( m_reversed_nfa, m_classes, m_nb_classes, m_representatives, false );
+    }
+
+    // Two bytes are in the same class if every set of the pattern contains both or none
+    void compute_classes()
+    {
+        std::unordered_map<std::vector<bool>, std::uint8_t> l_ids;
+        for ( unsigned b = 0; b < 256; ++b ) {
+            std::vector<bool> l_signature( m_nfa.sets.size() );
+            for ( std::size_t s = 0; s < m_nfa.sets.size(); ++s ) { l_signature[s] = m_nfa.sets[s].test( b ); }
+
+            const auto l_it = l_ids.try_emplace( std::move( l_signature ), static_cast<std::uint8_t>( l_ids.size() ) );
+            if ( l_it.second ) { m_representatives.push_back( static_cast<unsigned char>( b ) ); }
+            m_classes[b] = l_it.first->second;
+        }
+        m_nb_classes = static_cast<int>( l_ids.size() );
+    }
+
+    detail::nfa                       m_nfa;
+    detail::nfa                       m_reversed_nfa;    /*!< Finds the start of the matches */
+    std::array<std::uint8_t, 256>     m_classes {};
+    int                               m_nb_classes { 0 };
+    std::vector<unsigned char>        m_representatives; /*!< A byte of each class */
+
+    mutable std::optional<detail::dfa> m_anchored;
+    mutable std::optional<detail::dfa> m_unanchored;
+    mutable std::optional<detail::dfa> m_reversed;
+};
+
+} // namespace lazy_dfa
+
+#endif // LAZY_DFA_HPP
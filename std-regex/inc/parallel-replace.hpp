@@ -0,0 +1,201 @@
+#ifndef PARALLEL_REPLACE_HPP
+#define PARALLEL_REPLACE_HPP
+
+/*!
+ * @brief parallel_replace::regex_replace
+ *        std::regex_replace (std-regex-basics.cpp) runs on one thread, and
+ *        appends the output to a std::string which grows as it goes. To
+ *        redact a big file, the input is cut into chunks at line boundaries
+ *        and, on a work_stealing_pool :
+ *          1. every chunk is searched, its matches are recorded and the
+ *             size of its output is computed (nothing is written yet)
+ *          2. an exclusive prefix sum of these sizes gives the position of
+ *             every chunk in the output, allocated once
+ *          3. every chunk writes its output in place
+ *
+ *            const std::regex myRegex( "[0-9]{4}( [0-9]{4}){3}" );
+ *            work_stealing_pool myPool;
+ *            const std::string myRes = parallel_replace::regex_replace( myPool, text, myRegex, "XXXX XXXX XXXX XXXX" );
+ *
+ * @note The result is the one of std::regex_replace as long as no match
+ *       contains a newline : "^" only matches at the beginning of the text
+ *       (no std::regex::multiline), but "\s+" or "[^x]*" may cross lines
+ *       and would be cut at the chunk boundaries.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <parallel-algorithms.hpp>
+
+namespace parallel_replace {
+
+inline constexpr std::size_t DEFAULT_CHUNK = std::size_t{1} << 20;  /*!< Bytes per chunk */
+
+namespace detail {
+
+    /*!
+     * @brief Output iterator counting the characters written through it.
+     */
+    struct counting_iterator {
+        using iterator_category = std::output_iterator_tag;
+        using value_type        = void;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = void;
+
+        std::size_t* m_count;
+
+        counting_iterator& operator= ( char )  { ++*m_count; return *this; }
+        counting_iterator& operator* ()        { return *this; }
+        counting_iterator& operator++()        { return *this; }
+        counting_iterator& operator++( int )   { return *this; }
+    };
+
+    struct match_span {
+        std::size_t offset;  /*!< From the beginning of the chunk */
+        std::size_t length;
+    };
+
+    struct chunk {
+        std::size_t             first, last;  /*!< Bytes [first, last[ of the input */
+        std::vector<match_span> matches;
+        std::size_t             out_size   { 0 };
+        std::size_t             out_offset { 0 };
+    };
+
+    /*!
+     * @brief Cuts p_text in chunks of about p_size bytes, ending after a '\n'
+     *        (one empty chunk if p_text is empty : "a*" matches it).
+     */
+    inline std::vector<chunk> split_lines( std::string_view p_text, std::size_t p_size )
+    {
+        std::vector<chunk> l_res;
+        std::size_t        l_first = 0;
+        do {
+            std::size_t l_last = l_first + std::max<std::size_t>( p_size, 1 );
+            if ( l_last >= p_text.size() ) {
+                l_last = p_text.size();
+            } else {
+                const std::size_t l_eol = p_text.find( '\n', l_last - 1 );
+                l_last = l_eol == std::string_view::npos ? p_text.size() : l_eol + 1;
+            }
+            l_res.push_back( { l_first, l_last, {} } );
+            l_first = l_last;
+        } while ( l_first < p_text.size() );
+        return l_res;
+    }
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief std::regex_replace( p_text, p_regex, p_format ) computed on p_pool.
+ *
+ * @param p_chunk Approximate number of input bytes processed by a task.
+ *
+ * @note The regex is shared (read-only) by every task. A format without
+ *       '$' is copied as is, otherwise each match is searched again at its
+ *       position (std::regex_constants::match_continuous) to be formatted.
+ *       The prefix ($`) and the suffix ($') of a match are the ones of its
+ *       chunk there : a format using them is replaced serially.
+ */
+inline std::string regex_replace( work_stealing_pool& p_pool,
+                                  std::string_view    p_text,
+                                  const std::regex&   p_regex,
+                                  const std::string&  p_format,
+                                  std::size_t         p_chunk = DEFAULT_CHUNK )
+{
+    using namespace std::regex_constants;
+
+    if ( p_format.find( "$`" ) != std::string::npos || p_format.find( "$'" ) != std::string::npos ) {
+        return std::regex_replace( std::string( p_text ), p_regex, p_format );
+    }
+
+    const bool l_literal = p_format.find( '$' ) == std::string::npos;
+    auto       l_chunks  = detail::split_lines( p_text, p_chunk );
+    const auto l_count   = static_cast<std::ptrdiff_t>( l_chunks.size() );
+
+    // A chunk only ends the text if it is the last one : "$" must not match
+    // at its end, and an empty match there is the one of the next chunk.
+    auto flags = [&p_text]( const char* p_pos, const char* p_last ) {
+        match_flag_type l_flags = p_pos == p_text.data() ? match_default : match_prev_avail;
+        if ( p_last != p_text.data() + p_text.size() ) { l_flags |= match_not_eol; }
+        return l_flags;
+    };
+
+    // 1. Matches and output size of every chunk
+    pstl_lite::parallel_for( p_pool, std::ptrdiff_t{0}, l_count, [&]( std::ptrdiff_t p_begin, std::ptrdiff_t p_end ) {
+        for ( std::ptrdiff_t c = p_begin; c < p_end; ++c ) {
+            detail::chunk& l_chunk = l_chunks[c];
+            const char*    l_first = p_text.data() + l_chunk.first;
+            const char*    l_last  = p_text.data() + l_chunk.last;
+            std::size_t    l_size  = l_chunk.last - l_chunk.first;
+
+            for ( std::cregex_iterator it( l_first, l_last, p_regex, flags( l_first, l_last ) ), l_end; it != l_end; ++it ) {
+                const std::size_t l_length = static_cast<std::size_t>( it->length() );
+                if ( l_length == 0 && (*it)[0].first == l_last && l_chunk.last != p_text.size() ) { break; }
+                l_chunk.matches.push_back( { static_cast<std::size_t>( (*it)[0].first - l_first ), l_length } );
+
+                l_size -= l_length;
+                if ( l_literal ) {
+                    l_size += p_format.size();
+                } else {
+                    it->format( detail::counting_iterator{ &l_size }, p_format.data(), p_format.data() + p_format.size() );
+                }
+            }
+            l_chunk.out_size = l_size;
+        }
+    }, std::ptrdiff_t{1} );
+
+    // 2. Position of every chunk in the output
+    std::size_t l_total = 0;
+    for ( auto& l_chunk : l_chunks ) {
+        l_chunk.out_offset = l_total;
+        l_total           += l_chunk.out_size;
+    }
+    std::string l_res( l_total, '\0' );
+
+    // 3. Output of every chunk, in place
+    pstl_lite::parallel_for( p_pool, std::ptrdiff_t{0}, l_count, [&]( std::ptrdiff_t p_begin, std::ptrdiff_t p_end ) {
+        for ( std::ptrdiff_t c = p_begin; c < p_end; ++c ) {
+            const detail::chunk& l_chunk = l_chunks[c];
+            const char*          l_first = p_text.data() + l_chunk.first;
+            const char*          l_last  = p_text.data() + l_chunk.last;
+            const char*          l_in    = l_first;
+            char*                l_out   = l_res.data() + l_chunk.out_offset;
+
+            std::cmatch l_match;
+            const char* l_prev_empty = nullptr;  // End of the previous match, if it was empty
+            for ( const detail::match_span& l_span : l_chunk.matches ) {
+                const char* l_pos = l_first + l_span.offset;
+                l_out = std::copy( l_in, l_pos, l_out );
+
+                if ( l_literal ) {
+                    l_out = std::copy( std::begin(p_format), std::end(p_format), l_out );
+                } else {
+                    // Same search as std::regex_iterator : a non-empty match is
+                    // required right after an empty one at the same position.
+                    auto l_flags = flags( l_pos, l_last ) | match_continuous;
+                    if ( l_prev_empty == l_pos ) { l_flags |= match_not_null; }
+                    std::regex_search( l_pos, l_last, l_match, p_regex, l_flags );
+                    l_out = l_match.format( l_out, p_format.data(), p_format.data() + p_format.size() );
+                }
+                l_in         = l_pos + l_span.length;
+                l_prev_empty = l_span.length == 0 ? l_in : nullptr;
+            }
+            std::copy( l_in, l_last, l_out );
+        }
+    }, std::ptrdiff_t{1} );
+
+    return l_res;
+}
+
+} // namespace parallel_replace
+
+#endif // PARALLEL_REPLACE_HPP
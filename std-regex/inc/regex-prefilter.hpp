@@ -0,0 +1,347 @@
+#ifndef REGEX_PREFILTER_HPP
+#define REGEX_PREFILTER_HPP
+
+/*!
+ * @brief regex_prefilter::prefiltered_regex
+ *        std::regex_search tries the regex at every position of the text,
+ *        while most of them cannot start a match : e.g. every match of
+ *        "Mr\. \w+" starts with "Mr. ". A literal factor required by the
+ *        pattern is extracted from its syntax tree (see lazy-dfa.hpp), and
+ *        std::boyer_moore_horspool_searcher (see std-search) jumps from
+ *        one occurrence to the next, the regex only running around them :
+ *          - literal : the pattern is a plain string, the regex only runs
+ *                      to fill a std::cmatch
+ *          - prefix  : every match starts with the factor, the regex is
+ *                      run at its occurrences only (match_continuous)
+ *          - bounded : the factor is inside the matches, which are at
+ *                      most L bytes long, the regex runs on a window of
+ *                      L bytes around its occurrences
+ *          - required: unbounded matches, the whole text is searched, but
+ *                      only if the factor is still in it
+ *          - none    : no factor (or unsupported syntax), std::regex_search
+ *        The matches, groups included, are the std::regex ones.
+ *
+ *        With icase, the factor is searched case-insensitively.
+ *
+ * More infos here :
+ *   - https://en.cppreference.com/w/cpp/utility/functional/boyer_moore_horspool_searcher
+ *   - "Regular Expression Matching in the Wild", R. Cox (2010) (prefilters)
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+
+#include <lazy-dfa.hpp>
+
+namespace regex_prefilter {
+
+enum class mode { none, required, bounded, prefix, literal };
+
+namespace detail {
+
+    constexpr std::size_t MAX_FACTOR { 64 };                    // Longest extracted factor
+    constexpr std::size_t UNBOUNDED  { std::string::npos };
+
+    /*!
+     * @brief What a node of the syntax tree tells about the literals of its matches.
+     */
+    struct factors
+    {
+        bool        is_exact { true };    /*!< Every match is exact        */
+        std::string exact;
+        std::string prefix;               /*!< Every match starts with it  */
+        std::string suffix;               /*!< Every match ends with it    */
+        std::string must;                 /*!< Every match contains it     */
+        std::size_t max_length { 0 };     /*!< UNBOUNDED if no limit       */
+    };
+
+    inline void keep_longest( std::string& p_best, const std::string& p_candidate ) {
+        if ( p_candidate.size() > p_best.size() ) { p_best = p_candidate.substr( 0, MAX_FACTOR ); }
+    }
+
+    inline std::size_t add_lengths( std::size_t a, std::size_t b ) { return a == UNBOUNDED || b == UNBOUNDED ? UNBOUNDED : a + b; }
+
+    // The literal byte of a set ({c} or, with icase, {c, C}), lower case
+    inline std::optional<char> literal_of( const lazy_dfa::detail::byte_set& p_set, bool p_icase )
+    {
+        std::size_t l_first = 0;
+        while ( l_first < 256 && !p_set.test( l_first ) ) { ++l_first; }
+        const auto l_char = static_cast<char>( l_first );
+
+        if ( p_set.count() == 1 && ( !p_icase || !std::isalpha( static_cast<unsigned char>( l_char ) ) ) ) return l_char;
+        if ( p_set.count() == 2 && p_icase && l_first >= 'A' && l_first <= 'Z' && p_set.test( l_first - 'A' + 'a' ) ) {
+            return static_cast<char>( l_first - 'A' + 'a' );
+        }
+        return std::nullopt;
+    }
+
+    inline factors analyze( const lazy_dfa::detail::node& p_node, bool p_icase )
+    {
+        using type = lazy_dfa::detail::node::type;
+        factors l_res;
+
+        switch ( p_node.kind ) {
+            case type::empty: break;
+
+            case type::set:
+                l_res.max_length = 1;
+                if ( const auto l_char = literal_of( p_node.set, p_icase ) ) {
+                    l_res.exact = l_res.prefix = l_res.suffix = l_res.must = std::string( 1, *l_char );
+                }
+                else {
+                    l_res.is_exact = false;
+                }
+                break;
+
+            case type::concat: {
+                std::vector<factors> l_children;
+                for ( const auto& l_child : p_node.children ) { l_children.push_back( analyze( l_child, p_icase ) ); }
+
+                bool        l_in_prefix = true;
+                std::string l_run;          // Exact literals since the last inexact child
+                for ( const auto& l_child : l_children ) {
+                    l_res.max_length = add_lengths( l_res.max_length, l_child.max_length );
+                    keep_longest( l_res.must, l_child.must );
+                    if ( l_child.is_exact ) {
+                        l_run += l_child.exact;
+                        continue;
+                    }
+                    if ( l_in_prefix ) { l_res.prefix = l_run + l_child.prefix; l_in_prefix = false; }
+                    keep_longest( l_res.must, l_run + l_child.prefix );
+                    l_run = l_child.suffix;
+                    l_res.is_exact = false;
+                }
+                keep_longest( l_res.must, l_run );
+
+                if ( l_res.is_exact ) {
+                    l_res.exact = l_res.prefix = l_res.suffix = l_run;
+                }
+                else {
+                    l_res.suffix = l_run;
+                }
+                break;
+            }
+
+            case type::alternate: {
+                for ( std::size_t i = 0; i < p_node.children.size(); ++i ) {
+                    const factors l_child = analyze( p_node.children[i], p_icase );
+                    if ( i == 0 ) { l_res = l_child; continue; }
+                    l_res.max_length = std::max( l_res.max_length, l_child.max_length ); // UNBOUNDED is the biggest
+
+                    // Common prefix and suffix of the alternatives
+                    const auto l_prefix_end = std::mismatch( std::begin(l_res.prefix), std::end(l_res.prefix),
+                                                             std::begin(l_child.prefix), std::end(l_child.prefix) ).first;
+                    l_res.prefix.erase( l_prefix_end, std::end(l_res.prefix) );
+                    const auto l_suffix_begin = std::mismatch( std::rbegin(l_res.suffix), std::rend(l_res.suffix),
+                                                               std::rbegin(l_child.suffix), std::rend(l_child.suffix) ).first;
+                    l_res.suffix.erase( std::begin(l_res.suffix), l_suffix_begin.base() );
+                    l_res.is_exact = l_res.is_exact && l_child.is_exact && l_res.exact == l_child.exact;
+                }
+                if ( !l_res.is_exact ) {
+                    l_res.exact.clear();
+                    l_res.must = l_res.prefix.size() >= l_res.suffix.size() ? l_res.prefix : l_res.suffix;
+                }
+                break;
+            }
+
+            case type::repeat: {
+                const factors l_child = analyze( p_node.children.front(), p_icase );
+                l_res.max_length = p_node.max == lazy_dfa::detail::INFINITE || l_child.max_length == UNBOUNDED
+                                       ? UNBOUNDED : l_child.max_length * static_cast<std::size_t>( p_node.max );
+                l_res.is_exact   = p_node.min == p_node.max && ( l_child.is_exact || p_node.max == 0 );
+                if ( p_node.min == 0 ) break;
+
+                if ( l_child.is_exact ) { // x{n,m} starts and ends with n x
+                    std::string l_repeated;
+                    for ( int i = 0; i < p_node.min && l_repeated.size() <= MAX_FACTOR; ++i ) { l_repeated += l_child.exact; }
+                    l_res.prefix = l_res.suffix = l_res.must = l_repeated;
+                    if ( l_res.is_exact ) { l_res.exact = l_repeated; }
+                }
+                else {
+                    l_res.prefix = l_child.prefix;
+                    l_res.suffix = l_child.suffix;
+                    l_res.must   = l_child.must;
+                }
+                break;
+            }
+        }
+
+        if ( l_res.exact.size() > MAX_FACTOR ) { // Too long to be kept as a whole
+            l_res.is_exact = false;
+            l_res.exact.clear();
+        }
+        if ( l_res.prefix.size() > MAX_FACTOR ) { l_res.prefix.resize( MAX_FACTOR ); }
+        if ( l_res.suffix.size() > MAX_FACTOR ) { l_res.suffix.erase( 0, l_res.suffix.size() - MAX_FACTOR ); }
+        return l_res;
+    }
+
+    struct icase_hash {
+        std::size_t operator()( char c ) const { return static_cast<std::size_t>( std::tolower( static_cast<unsigned char>( c ) ) ); }
+    };
+    struct icase_equal {
+        bool operator()( char a, char b ) const {
+            return std::tolower( static_cast<unsigned char>( a ) ) == std::tolower( static_cast<unsigned char>( b ) );
+        }
+    };
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+class prefiltered_regex
+{
+public:
+    using flag_type = std::regex_constants::syntax_option_type;
+
+    /*!
+     * @brief Compiles p_pattern (std::regex_error if it is invalid) and
+     *        extracts its factor. A syntax the extraction does not support
+     *        only disables the prefilter, as do the grammars other than
+     *        ECMAScript (the factor is extracted with the ECMAScript parser :
+     *        in basic, "(ab)" matches the literal "(ab)").
+     */
+    explicit prefiltered_regex( const std::string& p_pattern, flag_type p_flags = std::regex_constants::ECMAScript ) :
+        m_regex( p_pattern, p_flags ),
+        m_icase( ( p_flags & std::regex_constants::icase ) != flag_type{} )
+    {
+        constexpr flag_type OTHER_GRAMMARS { std::regex_constants::basic | std::regex_constants::extended
+                                           | std::regex_constants::awk   | std::regex_constants::grep
+                                           | std::regex_constants::egrep };
+        if ( ( p_flags & OTHER_GRAMMARS ) != flag_type{} ) return;
+
+        detail::factors l_factors;
+        try {
+            l_factors = detail::analyze( lazy_dfa::detail::parser( p_pattern, m_icase ).parse(), m_icase );
+        }
+        catch ( const std::regex_error& ) {
+            return;
+        }
+
+        if      ( l_factors.is_exact && !l_factors.exact.empty() ) { m_mode = mode::literal; m_factor = l_factors.exact;  }
+        else if ( !l_factors.prefix.empty() )                      { m_mode = mode::prefix;  m_factor = l_factors.prefix; }
+        else if ( !l_factors.must.empty() ) {
+            m_mode       = l_factors.max_length == detail::UNBOUNDED ? mode::required : mode::bounded;
+            m_factor     = l_factors.must;
+            m_max_length = l_factors.max_length;
+        }
+
+        if ( m_mode == mode::none ) return;
+        if ( m_icase ) { m_icase_searcher.emplace( std::begin(m_factor), std::end(m_factor) ); }
+        else           { m_searcher      .emplace( std::begin(m_factor), std::end(m_factor) ); }
+    }
+
+    prefiltered_regex( const prefiltered_regex& ) = delete;
+    prefiltered_regex& operator=( const prefiltered_regex& ) = delete;
+
+    mode               get_mode() const { return m_mode;   }
+    const std::string& factor  () const { return m_factor; }
+
+    /*!
+     * @brief First match in p_text from p_from (std::regex_search).
+     *        The regex may run on a part of p_text only : the positions of
+     *        p_match (position(), prefix()) are relative to that part, its
+     *        sub-matches (first, second) point in p_text.
+     */
+    bool search( std::string_view p_text, std::cmatch& p_match, std::size_t p_from = 0 ) const
+    {
+        const char* l_begin = p_text.data() + std::min( p_from, p_text.size() );
+        const char* l_end   = p_text.data() + p_text.size();
+        const auto  l_flags = [l_begin]( const char* p_first, std::regex_constants::match_flag_type p_flags ) {
+            return p_first == l_begin ? p_flags : p_flags | std::regex_constants::match_prev_avail;
+        };
+
+        switch ( m_mode ) {
+            case mode::none:
+                return std::regex_search( l_begin, l_end, p_match, m_regex );
+
+            case mode::required:
+                if ( find( l_begin, l_end ) == l_end ) return false;
+                return std::regex_search( l_begin, l_end, p_match, m_regex );
+
+            case mode::literal: // The regex still runs on the occurrence : it fills p_match
+            case mode::prefix:
+                for ( const char* l_it = find( l_begin, l_end ); l_it != l_end; l_it = find( l_it + 1, l_end ) ) {
+                    if ( std::regex_search( l_it, l_end, p_match, m_regex, l_flags( l_it, std::regex_constants::match_continuous ) ) ) {
+                        return true;
+                    }
+                }
+                return false;
+
+            case mode::bounded: {
+                // The matches containing the occurrence at l_it lie in [l_it + |factor| - L, l_it + L)
+                const std::size_t l_back  = m_max_length - m_factor.size();
+                const char*       l_first = l_begin; // No match starts before it
+                for ( const char* l_it = find( l_begin, l_end ); l_it != l_end; l_it = find( l_it + 1, l_end ) ) {
+                    if ( static_cast<std::size_t>( l_it - l_first ) > l_back ) { l_first = l_it - l_back; }
+                    const char* l_last = static_cast<std::size_t>( l_end - l_it ) > m_max_length ? l_it + m_max_length : l_end;
+
+                    // A match starting after l_it may be cut by the window : it is found from the next occurrences
+                    if ( std::regex_search( l_first, l_last, p_match, m_regex, l_flags( l_first, std::regex_constants::match_default ) )
+                         && p_match[0].first <= l_it ) {
+                        return true;
+                    }
+                    l_first = l_it + 1;
+                }
+                return false;
+            }
+        }
+        return false;
+    }
+
+    /*!
+     * @brief First match in p_text from p_from.
+     */
+    std::optional<std::string_view> search( std::string_view p_text, std::size_t p_from = 0 ) const
+    {
+        if ( m_mode == mode::literal ) {
+            const char* l_end = p_text.data() + p_text.size();
+            const char* l_it  = find( p_text.data() + std::min( p_from, p_text.size() ), l_end );
+            if ( l_it == l_end ) return std::nullopt;
+            return std::string_view( l_it, m_factor.size() );
+        }
+
+        std::cmatch l_match;
+        if ( !search( p_text, l_match, p_from ) ) return std::nullopt;
+        return std::string_view( l_match[0].first, static_cast<std::size_t>( l_match.length( 0 ) ) );
+    }
+
+    /*!
+     * @brief Number of non overlapping matches in p_text.
+     */
+    std::size_t count( std::string_view p_text ) const
+    {
+        std::size_t l_res  = 0;
+        std::size_t l_from = 0;
+        while ( l_from <= p_text.size() ) {
+            const auto l_match = search( p_text, l_from );
+            if ( !l_match ) break;
+            ++l_res;
+            l_from = static_cast<std::size_t>( l_match->data() - p_text.data() ) + std::max<std::size_t>( 1, l_match->size() );
+        }
+        return l_res;
+    }
+
+private:
+    const char* find( const char* p_first, const char* p_last ) const
+    {
+        return m_icase ? std::search( p_first, p_last, *m_icase_searcher ) : std::search( p_first, p_last, *m_searcher );
+    }
+
+    std::regex                                                                               m_regex;
+    bool                                                                                     m_icase;
+    mode                                                                                     m_mode { mode::none };
+    std::string                                                                              m_factor;
+    std::size_t                                                                              m_max_length { 0 };
+    std::optional<std::boyer_moore_horspool_searcher<std::string::const_iterator>>          m_searcher;
+    std::optional<std::boyer_moore_horspool_searcher<std::string::const_iterator,
+                                                     detail::icase_hash, detail::icase_equal>> m_icase_searcher;
+};
+
+} // namespace regex_prefilter
+
+#endif // REGEX_PREFILTER_HPP
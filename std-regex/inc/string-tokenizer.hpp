@@ -0,0 +1,125 @@
+#ifndef STRING_TOKENIZER_HPP
+#define STRING_TOKENIZER_HPP
+
+/*!
+ * @brief tokenizer::tokens
+ *        std::sregex_iterator (std-regex-basics.cpp) allocates its
+ *        std::match_results, and it->str() a std::string per token.
+ *        To count or filter the words of a text, a token only has to be
+ *        a std::string_view into it : the iterator below holds two of
+ *        them, and never allocates.
+ *
+ *        A token is a maximal run of bytes of a char_class (\w+ by
+ *        default), found with a 256 entries table :
+ *
+ *            const auto myWords = tokenizer::tokens( text );
+ *            std::count_if( std::begin(myWords), std::end(myWords), []( std::string_view w ) { return w.size() > 7; } );
+ */
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+namespace tokenizer {
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Set of bytes, usable in constant expressions.
+ */
+class char_class
+{
+public:
+    constexpr char_class() = default;
+
+    /*!
+     * @brief The bytes of p_ranges : pairs of bounds, e.g. "azAZ09__".
+     */
+    constexpr explicit char_class( std::string_view p_ranges )
+    {
+        for ( std::size_t i = 0; i + 1 < p_ranges.size(); i += 2 ) {
+            for ( unsigned c = static_cast<unsigned char>( p_ranges[i] ); c <= static_cast<unsigned char>( p_ranges[i + 1] ); ++c ) {
+                m_table[c] = true;
+            }
+        }
+    }
+
+    constexpr bool contains( char c ) const { return m_table[static_cast<unsigned char>( c )]; }
+
+    constexpr char_class operator~() const {
+        char_class l_res;
+        for ( std::size_t c = 0; c < 256; ++c ) { l_res.m_table[c] = !m_table[c]; }
+        return l_res;
+    }
+
+private:
+    std::array<bool, 256> m_table {};
+};
+
+inline constexpr char_class word  { "azAZ09__" };   /*!< \w */
+inline constexpr char_class digit { "09" };         /*!< \d */
+inline constexpr char_class space { "\t\r  " };     /*!< \s */
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief token_iterator
+ *        Forward iterator over the maximal runs of bytes of a char_class.
+ */
+class token_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::string_view;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const std::string_view*;
+    using reference         = const std::string_view&;
+
+    token_iterator() = default;
+    token_iterator( std::string_view p_text, const char_class& p_class ) :
+        m_class( &p_class ), m_rest( p_text ) { next(); }
+
+    reference operator* () const { return m_token; }
+    pointer   operator->() const { return &m_token; }
+
+    token_iterator& operator++() { next(); return *this; }
+    token_iterator  operator++(int) { token_iterator tmp{*this}; next(); return tmp; }
+
+    bool operator==( const token_iterator& o ) const { return m_token.data() == o.m_token.data(); }
+    bool operator!=( const token_iterator& o ) const { return !this->operator==(o); }
+
+private:
+    void next()
+    {
+        const char* l_it  = m_rest.data();
+        const char* l_end = l_it + m_rest.size();
+        while ( l_it != l_end && !m_class->contains( *l_it ) ) { ++l_it; }
+
+        const char* l_last = l_it;
+        while ( l_last != l_end && m_class->contains( *l_last ) ) { ++l_last; }
+
+        m_token = l_it == l_end ? std::string_view() : std::string_view( l_it, static_cast<std::size_t>( l_last - l_it ) );
+        m_rest  = std::string_view( l_last, static_cast<std::size_t>( l_end - l_last ) );
+    }
+
+    const char_class* m_class { nullptr };
+    std::string_view  m_rest;
+    std::string_view  m_token;     /*!< Empty (null data) at the end */
+};
+
+struct token_range {
+    token_iterator first, last;
+    token_iterator begin() const { return first; }
+    token_iterator end  () const { return last;  }
+};
+
+/*!
+ * @brief The tokens of p_text : p_text and p_class must outlive the range.
+ */
+inline token_range tokens( std::string_view p_text, const char_class& p_class = word )
+{
+    return { token_iterator( p_text, p_class ), token_iterator() };
+}
+
+} // namespace tokenizer
+
+#endif // STRING_TOKENIZER_HPP
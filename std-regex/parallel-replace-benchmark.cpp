@@ -0,0 +1,130 @@
+/************************************************************
+ *        Parallel regex_replace vs std::regex_replace      *
+ ************************************************************/
+
+/*!
+ * @brief std::regex_replace (see std-regex-basics.cpp) is serial, and its
+ *        output grows as it is written. We redact a synthetic text (lines
+ *        of words, with card numbers and email addresses) with :
+ *          - std::regex_replace
+ *          - parallel_replace::regex_replace : chunks of lines searched on
+ *            a work_stealing_pool, output sized first then written in
+ *            place (see inc/parallel-replace.hpp)
+ *
+ *        Both must give the same text, also with formats using the
+ *        prefix ($`) or the suffix ($') of the matches.
+ *
+ * Usage : parallel-replace-benchmark [size (MB)] [threads] [chunk (KB)]
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <regex>
+#include <string>
+#include <thread>
+
+#include <time-measure.hpp>
+#include <work-stealing-pool.hpp>
+#include <parallel-replace.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define TEXT_SIZE  64   // Default size of the text (MB)
+#define CHUNK_SIZE 1024 // Default size of a chunk (KB)
+#define LINE_SIZE  80   // Approximate length of a line
+
+/*!
+ * @brief Creates p_size bytes of lines of random words, one word
+ *        in 32 being a card number and one in 32 an email address.
+ */
+std::string createText( std::size_t p_size )
+{
+    static const char* const WORDS[] = { "the", "account", "of", "customer", "was", "updated", "by",
+                                         "payment", "and", "invoice", "sent", "to", "support", "on", "request" };
+
+    std::default_random_engine                 random_engine;
+    std::uniform_int_distribution<std::size_t> word( 0, std::size( WORDS ) - 1 );
+    std::uniform_int_distribution<int>         kind( 0, 31 );
+    std::uniform_int_distribution<int>         digit( 0, 9 );
+
+    std::string l_res;
+    l_res.reserve( p_size + 2 * LINE_SIZE );
+    std::size_t l_line = 0;
+    while ( l_res.size() < p_size ) {
+        switch ( kind(random_engine) ) {
+            case 0:
+                for ( int i = 0; i < 19; ++i ) { l_res += i % 5 == 4 ? ' ' : static_cast<char>( '0' + digit(random_engine) ); }
+                break;
+            case 1:
+                l_res += WORDS[word(random_engine)];
+                l_res += '.';
+                l_res += WORDS[word(random_engine)];
+                l_res += "@example.com";
+                break;
+            default:
+                l_res += WORDS[word(random_engine)];
+        }
+        if ( l_res.size() - l_line > LINE_SIZE ) {
+            l_res += '\n';
+            l_line = l_res.size();
+        } else {
+            l_res += ' ';
+        }
+    }
+    return l_res;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_size    = ( argc > 1 ? std::stoul( argv[1] ) : TEXT_SIZE ) << 20;
+    const unsigned    l_threads = argc > 2 ? static_cast<unsigned>( std::stoul( argv[2] ) ) : std::max( 1u, std::thread::hardware_concurrency() );
+    const std::size_t l_chunk   = ( argc > 3 ? std::stoul( argv[3] ) : CHUNK_SIZE ) << 10;
+
+    const std::string myText = createText( l_size );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nText size  - " << myText.size() << " bytes"
+              << "\nThreads    - " << l_threads << "\nChunk size - " << l_chunk << " bytes";
+    std::cout << "\n--------------------------------------------------\n";
+
+    const std::pair<const char*, const char*> myReplacements[] = {
+        { "[0-9]{4}( [0-9]{4}){3}",   "XXXX XXXX XXXX XXXX" },
+        { "([\\w.]+)@(\\w+)\\.com",   "[redacted]@$2.com"   },
+    };
+
+    work_stealing_pool myPool( l_threads );
+
+    for ( const auto& [l_pattern, l_format] : myReplacements ) {
+        const std::regex myRegex( l_pattern );
+        std::cout << "\nReplace " << l_pattern << " with " << l_format << "\n";
+
+        std::string myStdRes, myParRes;
+        {
+            stopwatch myWatch("\tstd::regex_replace              ");
+            myStdRes = std::regex_replace( myText, myRegex, l_format );
+        }
+        {
+            stopwatch myWatch("\tparallel_replace::regex_replace ");
+            myParRes = parallel_replace::regex_replace( myPool, myText, myRegex, l_format, l_chunk );
+        }
+        std::cout << "\t" << myText.size() << " -> " << myParRes.size() << " bytes\n";
+
+        if ( myStdRes != myParRes ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+
+    // Prefix and suffix of the matches, in every chunk of a few lines
+    {
+        const std::string myLines = createText( 1 << 12 );
+        const std::regex  myRegex( "[0-9]{4}( [0-9]{4}){3}" );
+        for ( const char* l_format : { "[$`]", "[$']", "<$&>" } ) {
+            if ( std::regex_replace( myLines, myRegex, l_format ) !=
+                 parallel_replace::regex_replace( myPool, myLines, myRegex, l_format, 256 ) ) {
+                std::cout << "SOMETHING WENT WRONG!\n";
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
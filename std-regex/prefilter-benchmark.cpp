@@ -0,0 +1,133 @@
+/************************************************************
+ *     Boyer-Moore prefilter in front of std::regex_search  *
+ ************************************************************/
+
+/*!
+ * @brief std::regex_search (see std-regex-basics.cpp) tries the regex at
+ *        every position of the text. We count the matches of patterns
+ *        with a required literal in a book (see inc/regex-prefilter.hpp) :
+ *          - std::regex_search from the end of the previous match
+ *          - regex_prefilter::prefiltered_regex : the literal is searched
+ *            with std::boyer_moore_horspool_searcher (see std-search),
+ *            the regex only runs around its occurrences
+ *
+ *        Both must find the same matches (count and total length), also
+ *        with another grammar than ECMAScript.
+ *
+ * Usage : prefilter-benchmark [input file] [iterations]
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <string_view>
+
+#include <fileLoader.hpp>
+#include <time-measure.hpp>
+#include <regex-prefilter.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define INPUT_FILE "../std-search/input/HP.txt"
+#define ITERATIONS 5 // Default number of passes over the text
+
+struct result {
+    std::size_t count  { 0 };
+    std::size_t length { 0 };
+
+    bool operator!=( const result& o ) const { return count != o.count || length != o.length; }
+};
+
+const char* modeName( regex_prefilter::mode p_mode )
+{
+    switch ( p_mode ) {
+        case regex_prefilter::mode::none:     return "none";
+        case regex_prefilter::mode::required: return "required";
+        case regex_prefilter::mode::bounded:  return "bounded";
+        case regex_prefilter::mode::prefix:   return "prefix";
+        case regex_prefilter::mode::literal:  return "literal";
+    }
+    return "";
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::string l_file       = argc > 1 ? argv[1] : INPUT_FILE;
+    const int         l_iterations = argc > 2 ? std::stoi( argv[2] ) : ITERATIONS;
+
+    const auto myText = loadFile( l_file );
+    if ( !myText ) {
+        std::cout << "Unable to open " << l_file << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nInput      - " << l_file << " (" << myText->size() << " bytes)"
+              << "\nIterations - " << l_iterations;
+    std::cout << "\n--------------------------------------------------\n";
+
+    const std::pair<const char*, std::regex_constants::syntax_option_type> myPatterns[] = {
+        { "REGULAR EXPRESSIONS",      std::regex_constants::ECMAScript | std::regex_constants::icase },
+        { "Dumbledore",               std::regex_constants::ECMAScript },
+        { "Mr\\. \\w+",               std::regex_constants::ECMAScript },
+        { "(Vernon|Petunia) Dursley", std::regex_constants::ECMAScript },
+        { "\\w+ Dursley",             std::regex_constants::ECMAScript },
+        { "(\\w{8,})",                std::regex_constants::ECMAScript },
+    };
+
+    for ( const auto& [l_pattern, l_flags] : myPatterns ) {
+        const std::regex                         myStdRegex( l_pattern, l_flags );
+        const regex_prefilter::prefiltered_regex myPrefRegex( l_pattern, l_flags );
+        std::cout << "\nPattern " << l_pattern << " (" << modeName( myPrefRegex.get_mode() ) << " factor '"
+                  << myPrefRegex.factor() << "')\n";
+
+        result myStdRes, myPrefRes;
+        {
+            stopwatch myWatch("\tstd::regex_search           ");
+            for ( int i = 0; i < l_iterations; ++i ) {
+                myStdRes = {};
+                std::cmatch l_match;
+                for ( const char* l_it = myText->data(), *l_end = l_it + myText->size();
+                      std::regex_search( l_it, l_end, l_match, myStdRegex,
+                                         l_it == myText->data() ? std::regex_constants::match_default
+                                                                : std::regex_constants::match_prev_avail );
+                      l_it = l_match[0].second ) {
+                    ++myStdRes.count;
+                    myStdRes.length += l_match.length( 0 );
+                }
+            }
+        }
+        {
+            stopwatch myWatch("\tprefiltered_regex::search   ");
+            for ( int i = 0; i < l_iterations; ++i ) {
+                myPrefRes = {};
+                for ( auto l_match = myPrefRegex.search( *myText ); l_match;
+                      l_match = myPrefRegex.search( *myText, static_cast<std::size_t>( l_match->data() - myText->data() ) + l_match->size() ) ) {
+                    ++myPrefRes.count;
+                    myPrefRes.length += l_match->size();
+                }
+            }
+        }
+        std::cout << "\t" << myPrefRes.count << " matches\n";
+
+        if ( myStdRes != myPrefRes ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+
+    // Other grammars are not prefiltered : in basic, "(ab)" is a literal
+    {
+        const std::string                        myText( "ab (ab)" );
+        const std::regex                         myStdRegex( "(ab)", std::regex_constants::basic );
+        const regex_prefilter::prefiltered_regex myPrefRegex( "(ab)", std::regex_constants::basic );
+        std::cmatch myStdMatch, myPrefMatch;
+        const bool  myStdFound  = std::regex_search( myText.c_str(), myStdMatch, myStdRegex );
+        const bool  myPrefFound = myPrefRegex.search( myText, myPrefMatch );
+        if ( !myStdFound || !myPrefFound || myPrefRegex.get_mode() != regex_prefilter::mode::none
+             || myPrefMatch.position( 0 ) != 3 || myPrefMatch.length( 0 ) != 4
+             || myPrefMatch.position( 0 ) != myStdMatch.position( 0 ) || myPrefMatch.length( 0 ) != myStdMatch.length( 0 ) ) {
+            std::cout << "SOMETHING WENT WRONG!\n";
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,184 @@
+/************************************************************
+ *     Allocation-free tokenizing vs std::sregex_iterator   *
+ ************************************************************/
+
+/*!
+ * @brief std-regex-basics.cpp counts the words of a text, and the long
+ *        ones (size > 7) with std::sregex_iterator and it.str().size() :
+ *        one std::string per word. Most words fit in the small string
+ *        buffer of std::string (15 chars here) : that copy does not
+ *        allocate, the allocations are the ones of std::sregex_iterator.
+ *        We count them in a book with :
+ *          - std::sregex_iterator and it->str().size()
+ *          - std::sregex_iterator and it->length()
+ *          - lazy_dfa::regex::matches (string_views, see inc/lazy-dfa.hpp)
+ *          - ct_regex::regex::matches (string_views, see inc/ct-regex.hpp)
+ *          - tokenizer::tokens (string_views, see inc/string-tokenizer.hpp)
+ *
+ *        Then we count the lines ([^\n]+), most of them longer than the
+ *        small string buffer : str() allocates for each of those.
+ *
+ *        The global operators new (scalar, array and aligned) count the
+ *        heap allocations.
+ *
+ * Usage : tokenizer-benchmark [input file] [iterations]
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <regex>
+#include <string>
+#include <string_view>
+
+#include <fileLoader.hpp>
+#include <time-measure.hpp>
+#include <lazy-dfa.hpp>
+#include <ct-regex.hpp>
+#include <string-tokenizer.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define INPUT_FILE "../std-search/input/HP.txt"
+#define ITERATIONS 5 // Default number of passes over the text
+#define WD_SIZE    7 // Longer words are counted apart
+
+static std::size_t g_allocations { 0 };
+
+// Every replaceable form (scalar, array, aligned) goes through here, and is freed with std::free
+static void* countedAlloc( std::size_t p_size, std::size_t p_align = 0 )
+{
+    ++g_allocations;
+    void* l_ptr = p_align ? std::aligned_alloc( p_align, ( std::max<std::size_t>( 1, p_size ) + p_align - 1 ) / p_align * p_align )
+                          : std::malloc( p_size );
+    if ( l_ptr ) return l_ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new  ( std::size_t p_size )                        { return countedAlloc( p_size ); }
+void* operator new[]( std::size_t p_size )                        { return countedAlloc( p_size ); }
+void* operator new  ( std::size_t p_size, std::align_val_t p_al ) { return countedAlloc( p_size, static_cast<std::size_t>( p_al ) ); }
+void* operator new[]( std::size_t p_size, std::align_val_t p_al ) { return countedAlloc( p_size, static_cast<std::size_t>( p_al ) ); }
+
+void operator delete  ( void* p_ptr ) noexcept                                        { std::free( p_ptr ); }
+void operator delete[]( void* p_ptr ) noexcept                                        { std::free( p_ptr ); }
+void operator delete  ( void* p_ptr, std::size_t ) noexcept                           { std::free( p_ptr ); }
+void operator delete[]( void* p_ptr, std::size_t ) noexcept                           { std::free( p_ptr ); }
+void operator delete  ( void* p_ptr, std::align_val_t ) noexcept                      { std::free( p_ptr ); }
+void operator delete[]( void* p_ptr, std::align_val_t ) noexcept                      { std::free( p_ptr ); }
+void operator delete  ( void* p_ptr, std::size_t, std::align_val_t ) noexcept         { std::free( p_ptr ); }
+void operator delete[]( void* p_ptr, std::size_t, std::align_val_t ) noexcept         { std::free( p_ptr ); }
+
+static constexpr char WORDS[] = "(\\w+)";
+static constexpr char LINES[] = "[^\\n]+";
+
+struct result {
+    std::size_t words      { 0 };
+    std::size_t long_words { 0 };
+
+    bool operator!=( const result& o ) const { return words != o.words || long_words != o.long_words; }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::string l_file       = argc > 1 ? argv[1] : INPUT_FILE;
+    const int         l_iterations = argc > 2 ? std::stoi( argv[2] ) : ITERATIONS;
+
+    const auto myText = loadFile( l_file );
+    if ( !myText ) {
+        std::cout << "Unable to open " << l_file << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nInput      - " << l_file << " (" << myText->size() << " bytes)"
+              << "\nIterations - " << l_iterations;
+    std::cout << "\n--------------------------------------------------\n";
+
+    const std::regex       myStdRegex( WORDS );
+    const lazy_dfa::regex  myDfaRegex( WORDS );
+    const std::string_view myView( *myText );
+
+    std::cout << "\n" << std::setw(34) << "method" << std::setw(12) << "time (ms)" << std::setw(10) << "words"
+              << std::setw(12) << "long words" << std::setw(14) << "allocations" << "\n";
+
+    result myExpected;
+    auto bench = [&]( const char* p_name, auto&& p_count ) {
+        result            myRes;
+        const std::size_t l_allocations = g_allocations;
+        const auto        l_time = measure<std::chrono::milliseconds>( [&] {
+            for ( int i = 0; i < l_iterations; ++i ) { myRes = p_count(); }
+        });
+        const std::size_t l_per_pass = ( g_allocations - l_allocations ) / l_iterations;
+
+        std::cout << std::setw(34) << p_name << std::setw(12) << l_time << std::setw(10) << myRes.words
+                  << std::setw(12) << myRes.long_words << std::setw(14) << l_per_pass << "\n";
+
+        if ( myExpected.words == 0 ) { myExpected = myRes; }
+        if ( myRes != myExpected )   { std::cout << "SOMETHING WENT WRONG!\n"; }
+    };
+
+    // The std-regex-basics.cpp way
+    bench( "std::sregex_iterator + str()", [&] {
+        result l_res;
+        for ( auto it = std::sregex_iterator( std::begin(*myText), std::end(*myText), myStdRegex ); it != std::sregex_iterator(); ++it ) {
+            ++l_res.words;
+            l_res.long_words += it->str().size() > WD_SIZE;
+        }
+        return l_res;
+    });
+
+    bench( "std::sregex_iterator + length()", [&] {
+        result l_res;
+        for ( auto it = std::sregex_iterator( std::begin(*myText), std::end(*myText), myStdRegex ); it != std::sregex_iterator(); ++it ) {
+            ++l_res.words;
+            l_res.long_words += static_cast<std::size_t>( it->length() ) > WD_SIZE;
+        }
+        return l_res;
+    });
+
+    // string_views
+    auto countWords = []( const auto& p_range ) {
+        result l_res;
+        for ( const std::string_view l_word : p_range ) {
+            ++l_res.words;
+            l_res.long_words += l_word.size() > WD_SIZE;
+        }
+        return l_res;
+    };
+
+    bench( "lazy_dfa::regex::matches", [&] { return countWords( myDfaRegex.matches( myView ) ); } );
+    bench( "ct_regex::regex::matches", [&] { return countWords( ct_regex::regex<WORDS>::matches( myView ) ); } );
+    bench( "tokenizer::tokens",        [&] { return countWords( tokenizer::tokens( myView ) ); } );
+
+    // Lines : the copies of str() do not fit in the small string buffer
+    const std::regex      myStdLines( LINES );
+    const lazy_dfa::regex myDfaLines( LINES );
+    std::cout << "\n" << std::setw(34) << "" << std::setw(12) << "" << std::setw(10) << "lines" << std::setw(12) << "long lines\n";
+    myExpected = {};
+
+    bench( "std::sregex_iterator + str()", [&] {
+        result l_res;
+        for ( auto it = std::sregex_iterator( std::begin(*myText), std::end(*myText), myStdLines ); it != std::sregex_iterator(); ++it ) {
+            ++l_res.words;
+            l_res.long_words += it->str().size() > WD_SIZE;
+        }
+        return l_res;
+    });
+
+    bench( "std::sregex_iterator + length()", [&] {
+        result l_res;
+        for ( auto it = std::sregex_iterator( std::begin(*myText), std::end(*myText), myStdLines ); it != std::sregex_iterator(); ++it ) {
+            ++l_res.words;
+            l_res.long_words += static_cast<std::size_t>( it->length() ) > WD_SIZE;
+        }
+        return l_res;
+    });
+
+    bench( "lazy_dfa::regex::matches", [&] { return countWords( myDfaLines.matches( myView ) ); } );
+    bench( "ct_regex::regex::matches", [&] { return countWords( ct_regex::regex<LINES>::matches( myView ) ); } );
+
+    return EXIT_SUCCESS;
+}
@@ -23,6 +23,27 @@
  *     - GCC libstdc++
  *     - MSVC 
  *     - Intel C++
+ *
+ * With GCC libstdc++, the parallel policies are implemented using
+ * Intel TBB : without it, they silently run sequentially.
+ * See parallel-algorithms/ for a TBB-free work-stealing alternative.
+ *
+ * Build with something like :
+ *     g++ -std=c++17 -O3 stl-algorithms-policies.cpp -ltbb
+ *
+ * Usage : ./a.out [max elements]
+ */
+
+/*!
+ * @BENCHMARK
+ *
+ * For each algorithm below and each execution policy (seq, par, par_unseq),
+ * we measure the time needed over 1e2 to 1e8 (by default) elements.
+ *
+ * Parallelism has a fixed cost (waking threads, splitting the work,
+ * merging results) : on small inputs, par is slower than seq. The last
+ * table reports, for each algorithm, the first input size at which par
+ * beats seq on this machine.
  */
 
 #include <algorithm>
@@ -32,6 +53,11 @@
 #include <random>
 #include <chrono>
 #include <atomic>
+#include <numeric>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <iomanip>
 
 // ------------------------ Utility ------------------------ //
 
@@ -67,42 +93,177 @@ using precise_stopwatch   = stopwatch<>;
 using system_stopwatch    = stopwatch<std::chrono::system_clock>;
 using monotonic_stopwatch = stopwatch<std::chrono::steady_clock>;
 
+/*
+ * @brief Returns the time (in us) spent running p_func.
+ */
+template < typename Func >
+double measure( Func&& p_func )
+{
+    const auto l_start = std::chrono::steady_clock::now();
+    std::atomic_thread_fence(std::memory_order_relaxed);
+    p_func();
+    std::atomic_thread_fence(std::memory_order_relaxed);
+
+    return std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - l_start ).count();
+}
+
+// Results are accumulated here so that the compiler cannot drop the computations
+static volatile double g_sink{0};
+
+// ------------------------ Algorithms ------------------------ //
+
+/*
+ * @brief An algorithm to benchmark : p_run( policy, input, output )
+ *        runs it once with the given policy.
+ *        Algorithms flagged as mutating get a fresh copy of the input
+ *        before every run.
+ */
+struct algorithm
+{
+    std::string name;
+    bool        mutating;
+    std::function<void(const std::execution::sequenced_policy&,
+                       std::vector<double>&, std::vector<double>&)>            seq;
+    std::function<void(const std::execution::parallel_policy&,
+                       std::vector<double>&, std::vector<double>&)>            par;
+    std::function<void(const std::execution::parallel_unsequenced_policy&,
+                       std::vector<double>&, std::vector<double>&)>            par_unseq;
+};
+
+template < typename Body >
+algorithm make_algorithm( const std::string& p_name, bool p_mutating, Body p_body )
+{
+    return { p_name, p_mutating, p_body, p_body, p_body };
+}
+
+std::vector<algorithm> createAlgorithms()
+{
+    return {
+        make_algorithm( "transform", false, []( const auto& pol, auto& in, auto& out ) {
+            std::transform( pol, std::begin(in), std::end(in), std::begin(out),
+                            []( double v ) { return 2.0 * v + 1.0; } );
+        }),
+        make_algorithm( "reduce", false, []( const auto& pol, auto& in, auto& ) {
+            g_sink = g_sink + std::reduce( pol, std::begin(in), std::end(in), 0.0 );
+        }),
+        make_algorithm( "transform_reduce", false, []( const auto& pol, auto& in, auto& ) {
+            g_sink = g_sink + std::transform_reduce( pol, std::begin(in), std::end(in), 0.0,
+                                                     std::plus<>{},
+                                                     []( double v ) { return v * v; } );
+        }),
+        make_algorithm( "inclusive_scan", false, []( const auto& pol, auto& in, auto& out ) {
+            std::inclusive_scan( pol, std::begin(in), std::end(in), std::begin(out) );
+        }),
+        make_algorithm( "for_each", true, []( const auto& pol, auto& in, auto& ) {
+            std::for_each( pol, std::begin(in), std::end(in), []( double& v ) { v = std::sqrt(v); } );
+        }),
+        make_algorithm( "find", false, []( const auto& pol, auto& in, auto& ) {
+            // Values are in [0, 100[ : worst case, every element is visited
+            g_sink = g_sink + ( std::find( pol, std::begin(in), std::end(in), -1.0 ) == std::end(in) );
+        }),
+        make_algorithm( "count_if", false, []( const auto& pol, auto& in, auto& ) {
+            g_sink = g_sink + std::count_if( pol, std::begin(in), std::end(in),
+                                             []( double v ) { return v > 50.0; } );
+        }),
+        make_algorithm( "sort", true, []( const auto& pol, auto& in, auto& ) {
+            std::sort( pol, std::begin(in), std::end(in) );
+        }),
+    };
+}
+
+/*
+ * @brief Average time (in us) of one run of p_run over p_ref.
+ *        Small inputs are run several times to get stable results.
+ */
+template < typename Run >
+double benchmark( const Run& p_run, bool p_mutating, const std::vector<double>& p_ref )
+{
+    constexpr double MIN_WORK { 1e7 }; // Process at least that many elements per measure
+
+    const std::size_t   l_reps = std::max<std::size_t>( 1, MIN_WORK / p_ref.size() );
+    std::vector<double> l_in ( p_ref );
+    std::vector<double> l_out( p_ref.size() );
+    double              l_total{0};
+
+    if ( p_mutating ) {
+        for ( std::size_t r = 0; r < l_reps; ++r ) {
+            l_in = p_ref;
+            l_total += measure( [&] { p_run( l_in, l_out ); } );
+        }
+    }
+    else {
+        l_total = measure( [&] { for ( std::size_t r = 0; r < l_reps; ++r ) { p_run( l_in, l_out ); } } );
+    }
+
+    return l_total / l_reps;
+}
+
 // ------------------------ Main ------------------------ //
 
-#define ELEMENTS 1e6 // The number of elements in the vector
-int main()
+#define MIN_ELEMENTS 1e2 // The smallest number of elements in the vector
+#define MAX_ELEMENTS 1e8 // The default biggest number of elements in the vector
+int main( int argc, const char* argv[] )
 {
-    // Generate random numbers for the vector
+    const std::size_t l_max = argc > 1 ? static_cast<std::size_t>( std::stod( argv[1] ) )
+                                       : static_cast<std::size_t>( MAX_ELEMENTS );
+
+    // Generate random numbers for the vectors
     std::uniform_real_distribution<double> distrib(0, 100);
     std::default_random_engine             random_engine;
 
-    // Create a vector of random double elements to be sorted
-    std::vector<double> myVec(ELEMENTS);
-    for ( auto& v : myVec ) { v = distrib(random_engine); }
+    std::vector<std::size_t> l_sizes;
+    for ( std::size_t l_size = MIN_ELEMENTS; l_size <= l_max; l_size *= 10 ) { l_sizes.push_back( l_size ); }
 
-    {
-        // ----- Test 1 ----- //
-        // - sequential sort
-        std::cout << "Test 1 - Sequential sort over " << ELEMENTS << " elements\n";
-        stopwatch watch;
-        std::sort( std::execution::seq, std::begin(myVec), std::end(myVec));
-    }
+    const auto myAlgos = createAlgorithms();
+
+    // Crossover size of each algorithm : the smallest size from which
+    // par stays faster than seq for every bigger size (0 if never).
+    // Requiring it to stay faster filters out the noise on tiny inputs.
+    std::vector<std::size_t> l_crossovers( myAlgos.size(), 0 );
 
+    stopwatch watch;
+    for ( std::size_t a = 0; a < myAlgos.size(); ++a )
     {
-        // ----- Test 2 ----- //
-        // - parallel sort
-        std::cout << "Test 1 - Parallel sort over " << ELEMENTS << " elements\n";
-        stopwatch watch;
-        std::sort(std::execution::par, std::begin(myVec), std::end(myVec));
+        const auto& l_algo = myAlgos[a];
+
+        std::cout << "\n" << l_algo.name << " (average time in us)\n";
+        std::cout << std::setw(12) << "elements"
+                  << std::setw(14) << "seq"
+                  << std::setw(14) << "par"
+                  << std::setw(14) << "par_unseq" << "\n";
+
+        for ( auto l_size : l_sizes )
+        {
+            // Create a vector of random double elements
+            std::vector<double> myVec( l_size );
+            for ( auto& v : myVec ) { v = distrib(random_engine); }
+
+            using namespace std::placeholders;
+            const double l_seq       = benchmark( std::bind( l_algo.seq,       std::execution::seq,       _1, _2 ),
+                                                  l_algo.mutating, myVec );
+            const double l_par       = benchmark( std::bind( l_algo.par,       std::execution::par,       _1, _2 ),
+                                                  l_algo.mutating, myVec );
+            const double l_par_unseq = benchmark( std::bind( l_algo.par_unseq, std::execution::par_unseq, _1, _2 ),
+                                                  l_algo.mutating, myVec );
+
+            std::cout << std::setw(12) << l_size << std::fixed << std::setprecision(2)
+                      << std::setw(14) << l_seq
+                      << std::setw(14) << l_par
+                      << std::setw(14) << l_par_unseq << "\n";
+
+            if      ( l_par >= l_seq )       { l_crossovers[a] = 0;      }
+            else if ( l_crossovers[a] == 0 ) { l_crossovers[a] = l_size; }
+        }
     }
 
+    std::cout << "\nSize at which par first beats seq\n";
+    for ( std::size_t a = 0; a < myAlgos.size(); ++a )
     {
-        // ----- Test 3 ----- //
-        // - parallel and vectorized sort
-        std::cout << "Test 1 - Parallel and vectorized sort over " << ELEMENTS << " elements\n";
-        stopwatch watch;
-        std::sort(std::execution::par_unseq, std::begin(myVec), std::end(myVec));
+        std::cout << std::setw(20) << myAlgos[a].name << " : ";
+        if ( l_crossovers[a] ) { std::cout << l_crossovers[a] << " elements\n"; }
+        else                   { std::cout << "never (up to " << l_max << " elements)\n"; }
     }
+    std::cout << "\n";
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -0,0 +1,147 @@
+/************************************************************
+ *      SIMD collapse of duplicate runs vs std::unique      *
+ ************************************************************/
+
+/*!
+ * @brief remove_multiple_char() of playing-with-std-unique.cpp uses
+ *        std::unique with a two-elements lambda : one byte at a time,
+ *        with a branch per byte.
+ *
+ *        Here we compare it with the collapse routines of inc/collapse.hpp
+ *        (scalar branchless, SSSE3 and AVX2 compress-store) on HP.txt,
+ *        as is (few runs of spaces) and with every space expanded into
+ *        1 to 4 spaces (lots of runs, e.g. badly formatted text).
+ *
+ * Usage : collapse-benchmark [input file]
+ *
+ * NB : the SIMD versions are only built for the instruction sets enabled
+ *      at compile time (see UNIQUE_NATIVE in CMakeLists.txt).
+ */
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <random>
+
+#include <time-measure.hpp>
+#include <fileLoader.hpp>
+#include <collapse.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define INPUT_FILE "../std-search/input/HP.txt" // File path to import text from
+#define ITERATIONS 200                          // Number of times each collapse is performed
+
+//  Same as in playing-with-std-unique.cpp
+std::string::iterator remove_multiple_char(
+    std::string::iterator it_begin,
+    std::string::iterator it_end,
+    char                  p_remove = ' ')
+{
+    return std::unique( it_begin, it_end, [p_remove](const auto& c1, const auto& c2) {
+        return ( c1 == p_remove && c2 == p_remove );
+    });
+}
+
+template < typename It >
+It remove_multiple_elms( It it_begin, It it_end )
+{
+    return std::unique(it_begin, it_end);
+}
+
+/*!
+ * @brief Runs p_collapse ITERATIONS times on copies of p_input
+ *        and checks the result against p_expected (if not empty).
+ */
+template < typename Collapse >
+void bench( const std::string& p_title, const std::string& p_input,
+            const std::string& p_expected, Collapse&& p_collapse )
+{
+    std::string l_str;
+    {
+        stopwatch myWatch( "\t" + p_title );
+        for ( size_t cycle = 0; cycle < ITERATIONS; ++cycle )
+        {
+            l_str = p_input; // Same cost for everyone
+            p_collapse( l_str );
+        }
+    }
+    if ( !p_expected.empty() && l_str != p_expected ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+}
+
+void benchInput( const std::string& p_name, const std::string& p_input )
+{
+    std::cout << "\n" << p_name << " (" << p_input.size() << " chars, "
+              << std::count( std::begin(p_input), std::end(p_input), ' ' ) << " spaces)\n";
+
+    std::string l_expected = p_input;
+    l_expected.erase( remove_multiple_char( std::begin(l_expected), std::end(l_expected), ' ' ),
+                      std::end(l_expected) );
+
+    bench( "remove_multiple_char (std::unique)", p_input, l_expected, []( std::string& s ) {
+        s.erase( remove_multiple_char( std::begin(s), std::end(s), ' ' ), std::end(s) );
+    });
+    bench( "remove_multiple_elms (std::unique, every char)", p_input, "", []( std::string& s ) {
+        s.erase( remove_multiple_elms( std::begin(s), std::end(s) ), std::end(s) );
+    });
+    bench( "collapse scalar", p_input, l_expected, []( std::string& s ) {
+        s.resize( collapse::collapse_scalar( s.data(), s.data() + s.size(), collapse::single_char{' '} ) - s.data() );
+    });
+#if defined(__SSSE3__) || defined(__AVX2__)
+    bench( "collapse SSSE3", p_input, l_expected, []( std::string& s ) {
+        s.resize( collapse::collapse_sse( s.data(), s.data() + s.size(), collapse::single_char{' '} ) - s.data() );
+    });
+#endif
+#if defined(__AVX2__)
+    bench( "collapse AVX2", p_input, l_expected, []( std::string& s ) {
+        s.resize( collapse::collapse_avx2( s.data(), s.data() + s.size(), collapse::single_char{' '} ) - s.data() );
+    });
+#endif
+
+    // Whitespace normalization : runs of ' ', '\t', '\n', '\r'
+    std::string l_ws_expected = p_input;
+    l_ws_expected.erase( std::unique( std::begin(l_ws_expected), std::end(l_ws_expected),
+                                      []( char c1, char c2 ) {
+                                          return collapse::whitespace{}(c1) && collapse::whitespace{}(c2);
+                                      }), std::end(l_ws_expected) );
+
+    bench( "whitespace std::unique", p_input, l_ws_expected, []( std::string& s ) {
+        s.erase( std::unique( std::begin(s), std::end(s), []( char c1, char c2 ) {
+                     return collapse::whitespace{}(c1) && collapse::whitespace{}(c2);
+                 }), std::end(s) );
+    });
+    bench( "whitespace collapse", p_input, l_ws_expected, []( std::string& s ) {
+        collapse::collapse_whitespace( s );
+    });
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::string          l_file = argc > 1 ? argv[1] : INPUT_FILE;
+    std::optional<std::string> fileIn = loadFile( l_file );
+
+    if ( !fileIn.has_value() )
+    {
+        std::cout << "Could not open file '" << l_file << "\n";
+        return EXIT_SUCCESS;
+    }
+
+    // Every space becomes 1 to 4 spaces
+    std::string                     l_spacey;
+    std::default_random_engine      random_engine;
+    std::uniform_int_distribution<> distrib( 1, 4 );
+    for ( char c : fileIn.value() ) {
+        if ( c == ' ' ) { l_spacey.append( distrib(random_engine), ' ' ); }
+        else            { l_spacey.push_back( c ); }
+    }
+
+    std::cout << "\n---------------------------------\n";
+    std::cout << "Input file   : " << l_file     << "\n";
+    std::cout << "Iterations   : " << ITERATIONS << "\n";
+    std::cout << "---------------------------------\n";
+
+    benchInput( "Original text",         fileIn.value() );
+    benchInput( "Text with extra spaces", l_spacey       );
+
+    return EXIT_SUCCESS;
+}
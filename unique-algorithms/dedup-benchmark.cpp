@@ -0,0 +1,120 @@
+/************************************************************
+ *    Removing every duplicate : sort + unique vs hashing   *
+ ************************************************************/
+
+/*!
+ * @brief std::unique (see playing-with-std-unique.cpp) only removes
+ *        consecutive duplicates. To remove all of them, we compare on
+ *        ints and strings, with few to only distinct values :
+ *          - std::sort + std::unique : the original order is lost
+ *          - std::unordered_set of the values seen (order preserved)
+ *          - dedup::stable_dedup (order preserved, see inc/stable-dedup.hpp) :
+ *            flat open addressing set sized from the input
+ *
+ * Usage : dedup-benchmark [elements]
+ */
+
+#include <algorithm>
+#include <vector>
+#include <unordered_set>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <time-measure.hpp>
+#include <stable-dedup.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define ELEMENTS 1e7 // The default number of elements in the vector
+
+/*!
+ * @brief p_size values among p_distinct possible ones.
+ */
+template <typename T>
+std::vector<T> createVector( std::size_t p_size, std::size_t p_distinct )
+{
+    std::default_random_engine                 random_engine;
+    std::uniform_int_distribution<std::size_t> distrib( 0, p_distinct - 1 );
+    std::vector<T>                             myVec( p_size );
+
+    for ( auto& v : myVec ) {
+        if constexpr ( std::is_same_v<T, std::string> ) { v = "item_" + std::to_string( distrib(random_engine) ); }
+        else                                            { v = static_cast<T>( distrib(random_engine) ); }
+    }
+    return myVec;
+}
+
+template <typename T>
+void unordered_set_dedup( std::vector<T>& p_vec, bool p_reserve )
+{
+    std::unordered_set<T> l_seen;
+    if ( p_reserve ) { l_seen.reserve( p_vec.size() ); }
+
+    auto l_out = std::begin(p_vec);
+    for ( auto& v : p_vec ) {
+        if ( l_seen.insert( v ).second ) {
+            if ( &*l_out != &v ) { *l_out = std::move( v ); } // No self move-assignment
+            ++l_out;
+        }
+    }
+    p_vec.erase( l_out, std::end(p_vec) );
+}
+
+template <typename T>
+void benchDedup( const std::string& p_name, std::size_t p_size, std::size_t p_distinct )
+{
+    std::cout << "\n" << p_name << " : " << p_size << " elements among " << p_distinct << " values\n";
+
+    const auto     myRefVec = createVector<T>( p_size, p_distinct );
+    std::vector<T> myVec, myExpected;
+
+    {
+        myVec = myRefVec;
+        stopwatch myWatch("\tstd::sort + std::unique (order lost)");
+        std::sort( std::begin(myVec), std::end(myVec) );
+        myVec.erase( std::unique( std::begin(myVec), std::end(myVec) ), std::end(myVec) );
+    }
+    const std::size_t l_distinct = myVec.size();
+    {
+        myExpected = myRefVec;
+        stopwatch myWatch("\tstd::unordered_set");
+        unordered_set_dedup( myExpected, false );
+    }
+    {
+        myVec = myRefVec;
+        stopwatch myWatch("\tstd::unordered_set (reserved)");
+        unordered_set_dedup( myVec, true );
+    }
+    {
+        myVec = myRefVec;
+        {
+            stopwatch myWatch("\tdedup::stable_dedup");
+            dedup::stable_dedup( myVec );
+        }
+        if ( myVec != myExpected || myVec.size() != l_distinct ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_elements = argc > 1 ? static_cast<std::size_t>( std::stod( argv[1] ) )
+                                            : static_cast<std::size_t>( ELEMENTS );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nElements - " << l_elements;
+    std::cout << "\n--------------------------------------------------\n";
+
+    // At least one value : uniform_int_distribution( 0, -1 ) is undefined
+    const std::size_t l_tenth = std::max<std::size_t>( 1, l_elements / 10 );
+    const std::size_t l_all   = std::max<std::size_t>( 1, l_elements );
+
+    for ( std::size_t l_distinct : { std::size_t{1000}, l_tenth, l_all } ) {
+        benchDedup<int>( "int", l_elements, l_distinct );
+    }
+    for ( std::size_t l_distinct : { std::size_t{1000}, l_tenth, l_all } ) {
+        benchDedup<std::string>( "std::string", l_elements, l_distinct );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,249 @@
+#ifndef COLLAPSE_HPP
+#define COLLAPSE_HPP
+
+/*!
+ * @brief Collapsing runs of "target" characters into their first character,
+ *        i.e. what remove_multiple_char() does in playing-with-std-unique.cpp :
+ *
+ *            std::unique( first, last, []( char c1, char c2 ) {
+ *                return is_target( c1 ) && is_target( c2 );
+ *            });
+ *
+ *        std::unique looks at one byte at a time, with a hard to predict
+ *        branch per byte. The SIMD versions below handle 16 (SSSE3) or
+ *        32 (AVX2) bytes at a time :
+ *          1 - compare the bytes to the target(s) : one bit per byte.
+ *          2 - a byte is removed if it and the previous one are targets :
+ *              remove = target & ( target << 1 | carry from previous block ).
+ *          3 - no removal : the block is copied as is (the common case).
+ *              otherwise, the kept bytes of each 8 bytes half are packed
+ *              together with a shuffle (pshufb) whose control comes from
+ *              a 256 entries table indexed by the 8 bits "keep" mask.
+ *        The compaction is done in place : writes never go past the bytes
+ *        already loaded.
+ *
+ * More infos here :
+ *   - https://lemire.me/blog/2017/01/20/how-quickly-can-you-remove-spaces-from-a-string/
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace collapse {
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief What is a target character : a single character, or any whitespace.
+ */
+struct single_char {
+    char value;
+    bool operator()( char c ) const { return c == value; }
+};
+
+struct whitespace {
+    bool operator()( char c ) const { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Scalar version (branchless) : also used for the tails of the SIMD versions.
+ *        p_prev tells whether the byte before p_first was a target.
+ */
+template <typename Target>
+char* collapse_scalar( const char* p_first, const char* p_last, char* p_out,
+                       Target p_target, bool p_prev = false )
+{
+    for ( ; p_first != p_last; ++p_first ) {
+        const bool l_cur = p_target( *p_first );
+        *p_out = *p_first;
+        p_out += !( l_cur && p_prev );
+        p_prev = l_cur;
+    }
+    return p_out;
+}
+
+template <typename Target>
+char* collapse_scalar( char* p_first, char* p_last, Target p_target )
+{
+    return collapse_scalar( p_first, p_last, p_first, p_target );
+}
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+
+namespace detail {
+
+    /*!
+     * @brief For each 8 bits "keep" mask, the shuffle control packing
+     *        the kept bytes of a 8 bytes group at its beginning.
+     */
+    constexpr auto make_pack_table()
+    {
+        std::array<std::array<std::uint8_t, 16>, 256> l_table{};
+        for ( int l_mask = 0; l_mask < 256; ++l_mask ) {
+            int l_pos = 0;
+            for ( int b = 0; b < 8; ++b ) {
+                if ( l_mask & ( 1 << b ) ) { l_table[l_mask][l_pos++] = static_cast<std::uint8_t>( b ); }
+            }
+            for ( ; l_pos < 16; ++l_pos ) { l_table[l_mask][l_pos] = 0x80; } // pshufb : zero
+        }
+        return l_table;
+    }
+
+    alignas(16) inline constexpr auto PACK_TABLE = make_pack_table();
+
+    inline __m128i target_mask( __m128i p_bytes, single_char p_target ) {
+        return _mm_cmpeq_epi8( p_bytes, _mm_set1_epi8( p_target.value ) );
+    }
+    inline __m128i target_mask( __m128i p_bytes, whitespace ) {
+        __m128i l_res = _mm_cmpeq_epi8( p_bytes, _mm_set1_epi8( ' ' ) );
+        l_res = _mm_or_si128( l_res, _mm_cmpeq_epi8( p_bytes, _mm_set1_epi8( '\t' ) ) );
+        l_res = _mm_or_si128( l_res, _mm_cmpeq_epi8( p_bytes, _mm_set1_epi8( '\n' ) ) );
+        return  _mm_or_si128( l_res, _mm_cmpeq_epi8( p_bytes, _mm_set1_epi8( '\r' ) ) );
+    }
+
+    /*!
+     * @brief Packs the bytes of p_bytes (16 bytes) flagged in p_keep into p_out.
+     *        Only 8 bytes are written at a time : p_out + 16 never goes past
+     *        the end of the 16 loaded bytes.
+     */
+    inline char* pack16( __m128i p_bytes, unsigned p_keep, char* p_out )
+    {
+        const unsigned l_lo = p_keep & 0xFF;
+        const unsigned l_hi = ( p_keep >> 8 ) & 0xFF;
+
+        const __m128i l_lo_ctrl = _mm_load_si128( reinterpret_cast<const __m128i*>( PACK_TABLE[l_lo].data() ) );
+        const __m128i l_hi_ctrl = _mm_load_si128( reinterpret_cast<const __m128i*>( PACK_TABLE[l_hi].data() ) );
+
+        _mm_storel_epi64( reinterpret_cast<__m128i*>( p_out ), _mm_shuffle_epi8( p_bytes, l_lo_ctrl ) );
+        p_out += __builtin_popcount( l_lo );
+
+        const __m128i l_hi_bytes = _mm_srli_si128( p_bytes, 8 );
+        _mm_storel_epi64( reinterpret_cast<__m128i*>( p_out ), _mm_shuffle_epi8( l_hi_bytes, l_hi_ctrl ) );
+        return p_out + __builtin_popcount( l_hi );
+    }
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief SSSE3 version : 16 bytes per iteration. Returns the new end.
+ */
+template <typename Target>
+char* collapse_sse( char* p_first, char* p_last, Target p_target )
+{
+    char*    l_out  = p_first;
+    char*    l_in   = p_first;
+    unsigned l_prev = 0; // Was the last byte of the previous block a target ?
+
+    for ( ; p_last - l_in >= 16; l_in += 16 ) {
+        const __m128i  l_bytes  = _mm_loadu_si128( reinterpret_cast<const __m128i*>( l_in ) );
+        const unsigned l_target = _mm_movemask_epi8( detail::target_mask( l_bytes, p_target ) );
+        const unsigned l_remove = l_target & ( ( l_target << 1 ) | l_prev );
+        l_prev = l_target >> 15;
+
+        if ( l_remove == 0 ) {
+            // Nothing removed in this block : copy it as is (a no-op until
+            // something has been removed)
+            if ( l_out != l_in ) { _mm_storeu_si128( reinterpret_cast<__m128i*>( l_out ), l_bytes ); }
+            l_out += 16;
+        }
+        else {
+            l_out = detail::pack16( l_bytes, ~l_remove & 0xFFFF, l_out );
+        }
+    }
+
+    return collapse_scalar( l_in, p_last, l_out, p_target, l_prev != 0 );
+}
+
+#endif // __SSSE3__ || __AVX2__
+
+#if defined(__AVX2__)
+
+namespace detail {
+
+    inline __m256i target_mask( __m256i p_bytes, single_char p_target ) {
+        return _mm256_cmpeq_epi8( p_bytes, _mm256_set1_epi8( p_target.value ) );
+    }
+    inline __m256i target_mask( __m256i p_bytes, whitespace ) {
+        __m256i l_res = _mm256_cmpeq_epi8( p_bytes, _mm256_set1_epi8( ' ' ) );
+        l_res = _mm256_or_si256( l_res, _mm256_cmpeq_epi8( p_bytes, _mm256_set1_epi8( '\t' ) ) );
+        l_res = _mm256_or_si256( l_res, _mm256_cmpeq_epi8( p_bytes, _mm256_set1_epi8( '\n' ) ) );
+        return  _mm256_or_si256( l_res, _mm256_cmpeq_epi8( p_bytes, _mm256_set1_epi8( '\r' ) ) );
+    }
+
+} // namespace detail
+
+/*!
+ * @brief AVX2 version : 32 bytes per iteration. Returns the new end.
+ */
+template <typename Target>
+char* collapse_avx2( char* p_first, char* p_last, Target p_target )
+{
+    char*         l_out  = p_first;
+    char*         l_in   = p_first;
+    std::uint32_t l_prev = 0;
+
+    for ( ; p_last - l_in >= 32; l_in += 32 ) {
+        const __m256i       l_bytes  = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( l_in ) );
+        const std::uint32_t l_target = static_cast<std::uint32_t>(
+                                           _mm256_movemask_epi8( detail::target_mask( l_bytes, p_target ) ) );
+        const std::uint32_t l_remove = l_target & ( ( l_target << 1 ) | l_prev );
+        l_prev = l_target >> 31;
+
+        if ( l_remove == 0 ) {
+            if ( l_out != l_in ) { _mm256_storeu_si256( reinterpret_cast<__m256i*>( l_out ), l_bytes ); }
+            l_out += 32;
+        }
+        else {
+            const std::uint32_t l_keep = ~l_remove;
+            l_out = detail::pack16( _mm256_castsi256_si128     ( l_bytes ),    l_keep        & 0xFFFF, l_out );
+            l_out = detail::pack16( _mm256_extracti128_si256   ( l_bytes, 1 ), ( l_keep >> 16 ) & 0xFFFF, l_out );
+        }
+    }
+
+    return collapse_scalar( l_in, p_last, l_out, p_target, l_prev != 0 );
+}
+
+#endif // __AVX2__
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Best available version for the target instruction set.
+ */
+template <typename Target>
+char* collapse( char* p_first, char* p_last, Target p_target )
+{
+#if defined(__AVX2__)
+    return collapse_avx2( p_first, p_last, p_target );
+#elif defined(__SSSE3__)
+    return collapse_sse( p_first, p_last, p_target );
+#else
+    return collapse_scalar( p_first, p_last, p_target );
+#endif
+}
+
+/*!
+ * @brief std::string helpers : collapse the runs of p_char (resp. of
+ *        whitespaces) and shrink the string accordingly.
+ */
+inline void collapse_char( std::string& p_str, char p_char = ' ' )
+{
+    char* l_first = p_str.data();
+    p_str.resize( collapse( l_first, l_first + p_str.size(), single_char{ p_char } ) - l_first );
+}
+
+inline void collapse_whitespace( std::string& p_str )
+{
+    char* l_first = p_str.data();
+    p_str.resize( collapse( l_first, l_first + p_str.size(), whitespace{} ) - l_first );
+}
+
+} // namespace collapse
+
+#endif // COLLAPSE_HPP
@@ -0,0 +1,133 @@
+#ifndef FLAT_HASH_SET_HPP
+#define FLAT_HASH_SET_HPP
+
+/*!
+ * @brief flat_hash_set
+ *        Open addressing hash set : the keys live in a single array
+ *        (no node allocation per key, unlike std::unordered_set) and
+ *        collisions are resolved by linear probing.
+ *
+ *          - the capacity is a power of two, kept at least twice the number
+ *            of keys : probe sequences stay short.
+ *          - the hash is mixed with a multiplication by 2^64 / phi (Fibonacci
+ *            hashing) before taking its high bits, since std::hash of an
+ *            integer is the identity on libstdc++.
+ *          - a control byte per slot holds 7 bits of the hash : most of the
+ *            slots of a probe sequence are rejected without comparing keys.
+ *
+ *        Only insertion and lookup are supported (no erase, so no tombstones).
+ *
+ * More infos here :
+ *   - https://probablydance.com/2018/06/16/fibonacci-hashing-the-optimization-that-the-world-forgot-or-a-better-alternative-to-integer-modulo/
+ *   - https://abseil.io/about/design/swisstables
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace dedup {
+
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class flat_hash_set
+{
+public:
+    /*!
+     * @brief Sized for p_expected keys : no rehash until that many are inserted.
+     */
+    explicit flat_hash_set( std::size_t p_expected = 0, Hash p_hash = {}, KeyEqual p_equal = {} ) :
+        m_hash ( p_hash  ),
+        m_equal( p_equal )
+    {
+        rehash( capacity_for( p_expected ) );
+    }
+
+    std::size_t size    () const { return m_size;        }
+    std::size_t capacity() const { return m_ctrl.size(); }
+    bool        empty   () const { return m_size == 0;   }
+
+    /*!
+     * @brief Inserts p_key if not already there. Returns true if inserted.
+     */
+    template <typename K>
+    bool insert( K&& p_key )
+    {
+        if ( 2 * ( m_size + 1 ) > capacity() ) { rehash( 2 * capacity() ); }
+
+        const std::size_t  l_hash = m_hash( p_key );
+        const std::uint8_t l_tag  = tag( l_hash );
+        for ( std::size_t i = home( l_hash ); ; i = ( i + 1 ) & m_mask ) {
+            if ( m_ctrl[i] == EMPTY ) {
+                m_ctrl [i] = l_tag;
+                m_slots[i] = std::forward<K>( p_key );
+                ++m_size;
+                return true;
+            }
+            if ( m_ctrl[i] == l_tag && m_equal( m_slots[i], p_key ) ) return false;
+        }
+    }
+
+    bool contains( const Key& p_key ) const
+    {
+        const std::size_t  l_hash = m_hash( p_key );
+        const std::uint8_t l_tag  = tag( l_hash );
+        for ( std::size_t i = home( l_hash ); ; i = ( i + 1 ) & m_mask ) {
+            if ( m_ctrl[i] == EMPTY ) return false;
+            if ( m_ctrl[i] == l_tag && m_equal( m_slots[i], p_key ) ) return true;
+        }
+    }
+
+private:
+    static constexpr std::uint8_t EMPTY { 0 };
+
+    // Smallest power of two holding p_expected keys at a load factor <= 0.5
+    static std::size_t capacity_for( std::size_t p_expected ) {
+        std::size_t l_capacity = 16;
+        while ( l_capacity < 2 * p_expected ) { l_capacity *= 2; }
+        return l_capacity;
+    }
+
+    std::size_t home( std::size_t p_hash ) const {
+        return static_cast<std::size_t>( ( static_cast<std::uint64_t>( p_hash ) * 0x9E3779B97F4A7C15ull ) >> m_shift );
+    }
+
+    // 7 bits of the hash, with the high bit set to differ from EMPTY
+    static std::uint8_t tag( std::size_t p_hash ) {
+        return static_cast<std::uint8_t>( 0x80 | ( p_hash & 0x7F ) );
+    }
+
+    void rehash( std::size_t p_capacity )
+    {
+        std::vector<std::uint8_t> l_ctrl ( p_capacity, EMPTY );
+        std::vector<Key>          l_slots( p_capacity );
+        std::swap( l_ctrl,  m_ctrl  );
+        std::swap( l_slots, m_slots );
+
+        m_mask  = p_capacity - 1;
+        m_shift = 64;
+        for ( std::size_t c = p_capacity; c > 1; c /= 2 ) { --m_shift; }
+
+        // Keys are known to be unique : no comparison needed
+        for ( std::size_t s = 0; s < l_ctrl.size(); ++s ) {
+            if ( l_ctrl[s] == EMPTY ) continue;
+            std::size_t i = home( m_hash( l_slots[s] ) );
+            while ( m_ctrl[i] != EMPTY ) { i = ( i + 1 ) & m_mask; }
+            m_ctrl [i] = l_ctrl[s];
+            m_slots[i] = std::move( l_slots[s] );
+        }
+    }
+
+    Hash                      m_hash;
+    KeyEqual                  m_equal;
+    std::vector<std::uint8_t> m_ctrl;  /*!< EMPTY, or the tag of the key of the slot */
+    std::vector<Key>          m_slots;
+    std::size_t               m_size  { 0 };
+    std::size_t               m_mask  { 0 };
+    unsigned                  m_shift { 64 };
+};
+
+} // namespace dedup
+
+#endif // FLAT_HASH_SET_HPP
@@ -0,0 +1,185 @@
+#ifndef PARALLEL_UNIQUE_HPP
+#define PARALLEL_UNIQUE_HPP
+
+/*!
+ * @brief Parallel std::unique / std::unique_copy on top of work_stealing_pool.
+ *
+ *        The range is cut into fixed chunks, processed independently :
+ *          1 - every chunk removes its own adjacent duplicates. The first
+ *              element of a chunk is also dropped when it is a duplicate of
+ *              the last element of the previous chunk (boundary fix-up).
+ *          2 - an exclusive prefix sum over the number of elements kept by
+ *              each chunk gives the output offset of each chunk.
+ *          3 - every chunk writes its kept elements at its offset.
+ *        Steps 1 and 3 run in parallel, step 2 only sums one value per chunk.
+ *
+ *        As for std::unique, p_pred must be an equivalence relation : an
+ *        element is compared with the previous one of the input, not with
+ *        the last kept one.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include <work-stealing-pool.hpp>
+#include <parallel-algorithms.hpp>
+#include <first-touch.hpp>
+
+namespace pstl_lite {
+
+namespace detail {
+
+    /*!
+     * @brief Chunking shared by parallel_unique and parallel_unique_copy.
+     */
+    template <typename Diff>
+    struct unique_chunks {
+        unique_chunks( const work_stealing_pool& p_pool, Diff p_count ) :
+            count ( p_count ),
+            grain ( std::max( MIN_CHUNK, default_grain( p_pool, p_count ) ) ),
+            chunks( ( p_count + grain - 1 ) / grain ),
+            offsets( chunks + 1, 0 )
+        {}
+
+        Diff begin( Diff p_chunk ) const { return p_chunk * grain; }
+        Diff end  ( Diff p_chunk ) const { return std::min( count, ( p_chunk + 1 ) * grain ); }
+
+        // Turns the kept counts (stored at offsets[c + 1]) into the offsets
+        Diff scan() {
+            std::partial_sum( std::begin(offsets), std::end(offsets), std::begin(offsets) );
+            return offsets.back();
+        }
+
+        // Below that, the tasks cost more than they save
+        static constexpr Diff MIN_CHUNK { 1 << 14 };
+
+        Diff              count;
+        Diff              grain;
+        Diff              chunks;
+        std::vector<Diff> offsets;
+    };
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Copies [p_first, p_last[ to p_out without the adjacent duplicates.
+ *        Returns the end of the output range, which must not overlap the input.
+ */
+template <typename RandomIt, typename OutIt, typename BinaryPred = std::equal_to<>>
+OutIt parallel_unique_copy( work_stealing_pool& p_pool,
+                            RandomIt            p_first,
+                            RandomIt            p_last,
+                            OutIt               p_out,
+                            BinaryPred          p_pred = {} )
+{
+    using diff_t = typename std::iterator_traits<RandomIt>::difference_type;
+
+    const diff_t l_count = std::distance( p_first, p_last );
+    if ( l_count <= 0 ) return p_out;
+
+    detail::unique_chunks<diff_t> l_chunks( p_pool, l_count );
+    if ( l_chunks.chunks == 1 ) return std::unique_copy( p_first, p_last, p_out, p_pred );
+
+    // The input is left untouched : the boundary check can read the previous chunk
+    auto l_kept = [&]( diff_t i ) { return i == 0 || !p_pred( p_first[i - 1], p_first[i] ); };
+
+    // 1 - Number of elements kept by each chunk
+    parallel_for( p_pool, diff_t{0}, l_chunks.chunks, [&]( diff_t p_begin, diff_t p_end ) {
+        for ( diff_t c = p_begin; c < p_end; ++c ) {
+            diff_t l_nb = 0;
+            for ( diff_t i = l_chunks.begin( c ); i < l_chunks.end( c ); ++i ) { l_nb += l_kept( i ); }
+            l_chunks.offsets[c + 1] = l_nb;
+        }
+    }, diff_t{1} );
+
+    // 2 - Output offset of each chunk
+    const diff_t l_total = l_chunks.scan();
+
+    // 3 - Copy of the kept elements
+    parallel_for( p_pool, diff_t{0}, l_chunks.chunks, [&]( diff_t p_begin, diff_t p_end ) {
+        for ( diff_t c = p_begin; c < p_end; ++c ) {
+            OutIt l_out = p_out + l_chunks.offsets[c];
+            for ( diff_t i = l_chunks.begin( c ); i < l_chunks.end( c ); ++i ) {
+                if ( l_kept( i ) ) { *l_out++ = p_first[i]; }
+            }
+        }
+    }, diff_t{1} );
+
+    return p_out + l_total;
+}
+
+/*!
+ * @brief Removes the adjacent duplicates of [p_first, p_last[ (like std::unique).
+ *        Returns the new end of the range.
+ *
+ * @note Once compacted in place, the chunks cannot be moved to their final
+ *       position concurrently (the destination of a chunk may overlap the
+ *       elements of the previous one) : they go through a buffer holding
+ *       the kept elements of the chunks to move only. The buffer is not
+ *       value-initialized, its pages are first written by the workers.
+ */
+template <typename RandomIt, typename BinaryPred = std::equal_to<>>
+RandomIt parallel_unique( work_stealing_pool& p_pool,
+                          RandomIt            p_first,
+                          RandomIt            p_last,
+                          BinaryPred          p_pred = {} )
+{
+    using diff_t  = typename std::iterator_traits<RandomIt>::difference_type;
+    using value_t = typename std::iterator_traits<RandomIt>::value_type;
+
+    const diff_t l_count = std::distance( p_first, p_last );
+    if ( l_count <= 0 ) return p_first;
+
+    detail::unique_chunks<diff_t> l_chunks( p_pool, l_count );
+    if ( l_chunks.chunks == 1 ) return std::unique( p_first, p_last, p_pred );
+
+    // Boundary fix-up : must be decided before the chunks are modified
+    std::vector<char> l_skip_first( l_chunks.chunks, 0 );
+    for ( diff_t c = 1; c < l_chunks.chunks; ++c ) {
+        const diff_t l_begin = l_chunks.begin( c );
+        l_skip_first[c] = p_pred( p_first[l_begin - 1], p_first[l_begin] );
+    }
+
+    // 1 - In place std::unique of each chunk
+    parallel_for( p_pool, diff_t{0}, l_chunks.chunks, [&]( diff_t p_begin, diff_t p_end ) {
+        for ( diff_t c = p_begin; c < p_end; ++c ) {
+            RandomIt l_first = p_first + l_chunks.begin( c );
+            RandomIt l_end   = std::unique( l_first, p_first + l_chunks.end( c ), p_pred );
+            l_chunks.offsets[c + 1] = ( l_end - l_first ) - l_skip_first[c];
+        }
+    }, diff_t{1} );
+
+    // 2 - Final offset of each chunk
+    const diff_t l_total = l_chunks.scan();
+
+    // 3 - The chunks before the first removal are already in place : gather
+    //     the kept elements of the following ones, then move them back
+    diff_t l_moved = 0;
+    while ( l_moved < l_chunks.chunks
+            && l_chunks.offsets[l_moved] == l_chunks.begin( l_moved ) + l_skip_first[l_moved] ) { ++l_moved; }
+    if ( l_moved == l_chunks.chunks ) return p_first + l_total;
+
+    const diff_t                l_base = l_chunks.offsets[l_moved];
+    first_touch_vector<value_t> l_buffer( l_total - l_base );
+    parallel_for( p_pool, l_moved, l_chunks.chunks, [&]( diff_t p_begin, diff_t p_end ) {
+        for ( diff_t c = p_begin; c < p_end; ++c ) {
+            RandomIt     l_first = p_first + l_chunks.begin( c ) + l_skip_first[c];
+            const diff_t l_nb    = l_chunks.offsets[c + 1] - l_chunks.offsets[c];
+            std::move( l_first, l_first + l_nb, std::begin(l_buffer) + ( l_chunks.offsets[c] - l_base ) );
+        }
+    }, diff_t{1} );
+
+    parallel_for( p_pool, diff_t{0}, l_total - l_base, [&]( diff_t p_begin, diff_t p_end ) {
+        std::move( std::begin(l_buffer) + p_begin, std::begin(l_buffer) + p_end, p_first + l_base + p_begin );
+    });
+
+    return p_first + l_total;
+}
+
+} // namespace pstl_lite
+
+#endif // PARALLEL_UNIQUE_HPP
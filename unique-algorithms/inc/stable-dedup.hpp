@@ -0,0 +1,125 @@
+#ifndef STABLE_DEDUP_HPP
+#define STABLE_DEDUP_HPP
+
+/*!
+ * @brief std::unique only removes consecutive duplicates : removing every
+ *        duplicate usually means sorting first, which loses the original
+ *        order of the elements.
+ *
+ *        stable_dedup keeps the first occurrence of every value, in order,
+ *        with a flat_hash_set of the values already seen. The set is sized
+ *        from the input, up to detail::INITIAL_KEYS keys : a table sized for
+ *        every element while there are only a few distinct values would not
+ *        fit in the caches. Past that, it doubles when needed.
+ *
+ *        For strings, copying every value into the set would allocate :
+ *        the set holds std::string_view to the input instead. The views
+ *        must stay valid while the set is alive, so the kept elements are
+ *        first flagged, then compacted in a second pass.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <flat-hash-set.hpp>
+
+namespace dedup {
+
+namespace detail {
+
+    template <typename T>
+    struct is_string : std::false_type {};
+
+    template <typename CharT, typename Traits, typename Alloc>
+    struct is_string<std::basic_string<CharT, Traits, Alloc>> : std::true_type {};
+
+    /*!
+     * @brief A string_view along with its hash : growing the set
+     *        does not hash the strings again.
+     */
+    template <typename View>
+    struct hashed_view {
+        std::size_t hash;
+        View        view;
+
+        bool operator==( const hashed_view& p_other ) const {
+            return hash == p_other.hash && view == p_other.view;
+        }
+        struct hasher {
+            std::size_t operator()( const hashed_view& p_key ) const { return p_key.hash; }
+        };
+    };
+
+    // Maximum number of keys the set is initially sized for
+    constexpr std::size_t INITIAL_KEYS { 1 << 16 };
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Removes every duplicate of [p_first, p_last[, keeping the first
+ *        occurrence of each value in place. Returns the new end of the range.
+ */
+template <typename RandomIt>
+RandomIt stable_dedup( RandomIt p_first, RandomIt p_last )
+{
+    using value_t = typename std::iterator_traits<RandomIt>::value_type;
+
+    const std::size_t l_count = static_cast<std::size_t>( std::distance( p_first, p_last ) );
+
+    if constexpr ( detail::is_string<value_t>::value )
+    {
+        using view_t = std::basic_string_view<typename value_t::value_type, typename value_t::traits_type>;
+
+        std::vector<char> l_kept( l_count );
+        {
+            using key_t = detail::hashed_view<view_t>;
+
+            std::hash<view_t>                            l_hash;
+            flat_hash_set<key_t, typename key_t::hasher> l_seen( std::min( l_count, detail::INITIAL_KEYS ) );
+            for ( std::size_t i = 0; i < l_count; ++i ) {
+                const view_t l_view( p_first[i] );
+                l_kept[i] = l_seen.insert( key_t{ l_hash( l_view ), l_view } );
+            }
+        }
+
+        RandomIt l_out = p_first;
+        for ( std::size_t i = 0; i < l_count; ++i ) {
+            if ( l_kept[i] ) {
+                if ( l_out != p_first + i ) { *l_out = std::move( p_first[i] ); }
+                ++l_out;
+            }
+        }
+        return l_out;
+    }
+    else
+    {
+        // The set holds its own copies : compact while scanning
+        flat_hash_set<value_t> l_seen( std::min( l_count, detail::INITIAL_KEYS ) );
+        RandomIt               l_out = p_first;
+        for ( ; p_first != p_last; ++p_first ) {
+            if ( l_seen.insert( *p_first ) ) {
+                if ( l_out != p_first ) { *l_out = std::move( *p_first ); }
+                ++l_out;
+            }
+        }
+        return l_out;
+    }
+}
+
+/*!
+ * @brief std::vector helper.
+ */
+template <typename T>
+void stable_dedup( std::vector<T>& p_vec )
+{
+    p_vec.erase( stable_dedup( std::begin(p_vec), std::end(p_vec) ), std::end(p_vec) );
+}
+
+} // namespace dedup
+
+#endif // STABLE_DEDUP_HPP
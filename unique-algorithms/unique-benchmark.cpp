@@ -0,0 +1,131 @@
+/************************************************************
+ *      Parallel adjacent duplicates removal (unique)       *
+ ************************************************************/
+
+/*!
+ * @brief remove_multiple_elms() of playing-with-std-unique.cpp is a
+ *        serial std::unique. Here we compare it, on large int vectors
+ *        with different ratios of duplicates, with :
+ *          - std::unique with std::execution::par
+ *          - pstl_lite::parallel_unique      (in place)
+ *          - pstl_lite::parallel_unique_copy (to another vector)
+ *        (see inc/parallel-unique.hpp) for an increasing number of threads.
+ *
+ * Usage : unique-benchmark [elements] [max threads]
+ *
+ * NB : 1e8 ints need 400 MB per vector, and up to 5 of them are alive.
+ */
+
+#include <algorithm>
+#include <execution>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+
+#include <time-measure.hpp>
+#include <work-stealing-pool.hpp>
+#include <parallel-unique.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+#define ELEMENTS 1e8 // The default number of elements in the vector
+
+template < typename It >
+It remove_multiple_elms( It it_begin, It it_end )
+{
+    return std::unique(it_begin, it_end);
+}
+
+/*!
+ * @brief Creates a vector of p_size random ints where every element
+ *        repeats the previous one with the probability p_dup_ratio.
+ */
+std::vector<int> createVector( std::size_t p_size, double p_dup_ratio )
+{
+    std::default_random_engine             random_engine;
+    std::uniform_int_distribution<int>     distrib;
+    std::bernoulli_distribution            repeat( p_dup_ratio );
+    std::vector<int>                       myVec( p_size );
+
+    for ( std::size_t i = 0; i < p_size; ++i ) {
+        myVec[i] = ( i > 0 && repeat(random_engine) ) ? myVec[i - 1] : distrib(random_engine);
+    }
+    return myVec;
+}
+
+/*!
+ * @brief Time (in ms) of p_unique on a copy of p_ref, checked against p_expected.
+ */
+template <typename Unique>
+long long benchUnique( const std::vector<int>& p_ref, const std::vector<int>& p_expected, Unique&& p_unique )
+{
+    std::vector<int> l_vec = p_ref;
+    const auto       l_ms  = measure<std::chrono::milliseconds>( [&] { p_unique( l_vec ); } );
+
+    if ( l_vec != p_expected ) { std::cout << "SOMETHING WENT WRONG!\n"; }
+    return l_ms;
+}
+
+void benchRatio( double p_dup_ratio, std::size_t p_size, const std::vector<unsigned>& p_threads )
+{
+    const auto myRefVec   = createVector( p_size, p_dup_ratio );
+    auto       myExpected = myRefVec;
+    myExpected.erase( remove_multiple_elms( std::begin(myExpected), std::end(myExpected) ),
+                      std::end(myExpected) );
+
+    std::cout << "\nDuplicates ratio " << p_dup_ratio << " (" << myExpected.size()
+              << " elements kept, time in ms)\n";
+    std::cout << std::setw(10) << "threads"
+              << std::setw(12) << "seq"
+              << std::setw(12) << "par"
+              << std::setw(12) << "pool"
+              << std::setw(12) << "pool copy" << "\n";
+
+    for ( unsigned l_nb : p_threads )
+    {
+        work_stealing_pool l_pool( l_nb );
+
+        std::cout << std::setw(10) << l_nb;
+        std::cout << std::setw(12) << benchUnique( myRefVec, myExpected, []( auto& v ) {
+            v.erase( remove_multiple_elms( std::begin(v), std::end(v) ), std::end(v) );
+        });
+        std::cout << std::setw(12) << benchUnique( myRefVec, myExpected, []( auto& v ) {
+            v.erase( std::unique( std::execution::par, std::begin(v), std::end(v) ), std::end(v) );
+        });
+        std::cout << std::setw(12) << benchUnique( myRefVec, myExpected, [&]( auto& v ) {
+            v.erase( pstl_lite::parallel_unique( l_pool, std::begin(v), std::end(v) ), std::end(v) );
+        });
+
+        std::vector<int> l_out( p_size ); // Allocated outside of the measure
+        std::cout << std::setw(12) << benchUnique( myRefVec, myExpected, [&]( auto& v ) {
+            l_out.erase( pstl_lite::parallel_unique_copy( l_pool, std::begin(v), std::end(v), std::begin(l_out) ),
+                         std::end(l_out) );
+            v.swap( l_out );
+        });
+        std::cout << "\n";
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char* argv[] )
+{
+    const std::size_t l_elements    = argc > 1 ? static_cast<std::size_t>( std::stod( argv[1] ) )
+                                               : static_cast<std::size_t>( ELEMENTS );
+    const unsigned    l_max_threads = argc > 2 ? std::stoul( argv[2] )
+                                               : std::max( 1u, std::thread::hardware_concurrency() );
+
+    // 1, 2, 4... up to the maximum number of threads
+    std::vector<unsigned> l_threads;
+    for ( unsigned l_nb = 1; l_nb < l_max_threads; l_nb *= 2 ) { l_threads.push_back( l_nb ); }
+    l_threads.push_back( l_max_threads );
+
+    std::cout << "\n--------------------------------------------------\n";
+    std::cout << "\t\tPARAMETERS\nElements - " << l_elements
+              << "\nMax threads - "            << l_max_threads;
+    std::cout << "\n--------------------------------------------------\n";
+
+    for ( double l_ratio : { 0.0, 0.5, 0.9, 0.99 } ) { benchRatio( l_ratio, l_elements, l_threads ); }
+
+    return EXIT_SUCCESS;
+}